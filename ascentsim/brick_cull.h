@@ -0,0 +1,135 @@
+#ifndef BRICK_CULL_H
+#define BRICK_CULL_H
+
+#include "field_registry.h"
+#include "span_index.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+//
+// The cell bricks an isosurface pass has to visit: after each update,
+// Select brings a SpanIndex over the brick ranges of a bricked scalar
+// field up to date and collects the bricks that may hold any of the
+// iso-values, m_active in ascending order; an extraction, or publishing,
+// can skip the rest.  Each iso-value costs a logarithmic query rather than
+// a pass over the bricks, so many iso-values stay cheap.  With m_compare
+// every query is also answered by the scan of BricksInRange, to time the
+// two and check they agree.  PrintStats reports the share of bricks each
+// iso-value kept over the run.
+//
+struct BrickCull {
+  const std::vector<double> m_iso;
+  const bool m_compare;
+  SpanIndex m_index;
+  std::vector<size_t> m_active;
+  std::vector<size_t> m_crossing; // bricks of one iso-value
+  std::vector<char> m_marked;     // bricks of any iso-value
+  std::vector<size_t> m_merged;
+  std::vector<size_t> m_scanned;
+  std::vector<double> m_kept;     // per iso-value, summed over steps
+  double m_active_kept;
+  size_t m_bricks;
+  int m_edge;
+  long m_steps;
+  long m_mismatches;
+  double m_index_seconds;
+  double m_seconds;
+  double m_scan_seconds;
+
+  BrickCull(const std::vector<double> &iso, bool compare)
+      : m_iso(iso), m_compare(compare), m_kept(iso.size(), 0.),
+        m_active_kept(0.), m_bricks(0), m_edge(0), m_steps(0),
+        m_mismatches(0), m_index_seconds(0.), m_seconds(0.),
+        m_scan_seconds(0.) {}
+
+  void Select(const FieldRegistry &fields, int field) {
+    const size_t bricks = fields.BrickCount();
+    double start = PoolSeconds();
+    if (m_index.Size() != bricks)
+      m_index.Resize(bricks);
+    for (size_t b = 0; b < bricks; ++b)
+      m_index.Set(b, fields.RangeMin(field, 0, b),
+                  fields.RangeMax(field, 0, b));
+    m_index.Commit();
+    m_index_seconds += PoolSeconds() - start;
+
+    // the queries mark their bricks, so the union costs no sorting
+    start = PoolSeconds();
+    m_marked.assign(bricks, 0);
+    for (size_t i = 0; i < m_iso.size(); ++i) {
+      m_crossing.clear();
+      m_index.Stab(m_iso[i], m_crossing);
+      m_kept[i] += double(m_crossing.size());
+      for (size_t c = 0; c < m_crossing.size(); ++c)
+        m_marked[m_crossing[c]] = 1;
+    }
+    m_active.clear();
+    for (size_t b = 0; b < bricks; ++b) {
+      if (m_marked[b])
+        m_active.push_back(b);
+    }
+    m_active_kept += double(m_active.size());
+    m_seconds += PoolSeconds() - start;
+    m_bricks = bricks;
+    m_edge = fields.m_cell_bricks.m_edge;
+    ++m_steps;
+    if (m_compare)
+      Compare(fields, field);
+  }
+
+  void PrintStats() const {
+    const double steps = double(std::max(m_steps, 1L));
+    const double bricks = double(std::max(m_bricks, size_t(1)));
+    std::cout << "========== Brick Cull ==========\n";
+    std::cout << "bricks     : " << m_bricks << " (" << m_edge
+              << "^3 cells)\n";
+    for (size_t i = 0; i < m_iso.size(); ++i) {
+      std::ostringstream label;
+      label << "iso " << m_iso[i];
+      std::cout << std::left << std::setw(11) << label.str() << std::right
+                << ": " << 100. * m_kept[i] / steps / bricks
+                << "% of bricks\n";
+    }
+    std::cout << "active     : " << 100. * m_active_kept / steps / bricks
+              << "% of bricks\n";
+    std::cout << "index      : " << 1e3 * m_index_seconds / steps
+              << " ms update per step, " << m_index.m_rebuilds
+              << " rebuilds, "
+              << double(m_index.m_total_moved) / steps / bricks
+              << " moved per brick per step\n";
+    std::cout << "queries    : " << 1e3 * m_seconds / steps
+              << " ms per step";
+    if (m_compare) {
+      std::cout << ", scan " << 1e3 * m_scan_seconds / steps << " ms, "
+                << (m_mismatches == 0 ? "same bricks" : "MISMATCH");
+    }
+    std::cout << "\n";
+    std::cout << "================================\n";
+  }
+
+private:
+  // the active bricks again by scanning every brick's range
+  void Compare(const FieldRegistry &fields, int field) {
+    const double start = PoolSeconds();
+    std::vector<size_t> active;
+    for (size_t i = 0; i < m_iso.size(); ++i) {
+      m_scanned.clear();
+      fields.BricksInRange(field, 0, m_iso[i], m_iso[i], m_scanned);
+      m_merged.clear();
+      std::set_union(active.begin(), active.end(), m_scanned.begin(),
+                     m_scanned.end(), std::back_inserter(m_merged));
+      active.swap(m_merged);
+    }
+    m_scan_seconds += PoolSeconds() - start;
+    if (active != m_active)
+      ++m_mismatches;
+  }
+};
+
+#endif
@@ -0,0 +1,410 @@
+#ifndef FIELD_ARENA_H
+#define FIELD_ARENA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <sys/resource.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define FIELD_ARENA_MMAP
+#endif
+
+//
+// Pages backing the field buffers.
+//   small       : base pages only (transparent huge pages refused)
+//   transparent : 2 MB aligned mapping advised for transparent huge pages
+//   huge        : explicit huge pages from the hugetlb pool, falling back
+//                 to transparent ones when the pool is empty
+//
+enum PagePolicy { PAGES_SMALL, PAGES_TRANSPARENT, PAGES_HUGE };
+
+inline const char *PagePolicyName(PagePolicy pages) {
+  return pages == PAGES_HUGE ? "huge"
+                             : pages == PAGES_TRANSPARENT ? "transparent"
+                                                          : "small";
+}
+
+//
+// Placement of the field pages on the NUMA nodes.
+//   none        : wherever the thread building the data set runs, so all
+//                 on one node
+//   first_touch : each page on the node of the thread that updates its
+//                 rows under the static slab partition (FieldEngine::Place)
+//   interleave  : round robin over all nodes, page by page
+//   bind        : all on one given node
+//
+enum NumaPolicy { NUMA_NONE, NUMA_FIRST_TOUCH, NUMA_INTERLEAVE, NUMA_BIND };
+
+inline const char *NumaPolicyName(NumaPolicy numa) {
+  return numa == NUMA_BIND
+             ? "bind"
+             : numa == NUMA_INTERLEAVE
+                   ? "interleave"
+                   : numa == NUMA_FIRST_TOUCH ? "first_touch" : "none";
+}
+
+// memory policies of mbind(2), without a libnuma dependency
+#define FIELD_MPOL_BIND 2
+#define FIELD_MPOL_INTERLEAVE 3
+
+// NUMA nodes of the system, from the highest online node; 1 if unknown
+inline int NumaNodes() {
+  int nodes = 1;
+#ifdef FIELD_ARENA_MMAP
+  FILE *online = fopen("/sys/devices/system/node/online", "r");
+  if (!online)
+    return 1;
+  // a list of ranges such as 0-1,4
+  int first, last;
+  char sep;
+  while (fscanf(online, "%d", &first) == 1) {
+    last = first;
+    if (fscanf(online, "%c", &sep) == 1 && sep == '-') {
+      if (fscanf(online, "%d", &last) != 1)
+        break;
+      if (fscanf(online, "%c", &sep) != 1)
+        sep = '\n';
+    }
+    nodes = std::max(nodes, last + 1);
+    if (sep != ',')
+      break;
+  }
+  fclose(online);
+#endif
+  return nodes;
+}
+
+// minor plus major page faults of the process so far
+inline long PageFaults() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt + usage.ru_majflt;
+}
+
+//
+// One mapping handed out by a FieldArena.  m_pages is the policy the
+// mapping actually got, which is weaker than the one asked for when the
+// system has no huge pages to give.
+//
+struct FieldBlock {
+  char *m_base;
+  size_t m_bytes;
+  PagePolicy m_pages;
+
+  FieldBlock() : m_base(NULL), m_bytes(0), m_pages(PAGES_SMALL) {}
+};
+
+//
+// Carves the buffers of one data set out of a single FieldBlock.  Add
+// reserves an array and returns its byte offset; every array starts on a
+// FIELD_ALIGN byte boundary, so full-width vector loads never split a cache
+// line at the start of a row of arrays.
+//
+#define FIELD_ALIGN 64
+
+struct FieldLayout {
+  size_t m_bytes;
+
+  FieldLayout() : m_bytes(0) {}
+
+  size_t Add(size_t count, size_t size) {
+    const size_t offset = m_bytes;
+    m_bytes += (count * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+    return offset;
+  }
+};
+
+//
+// Allocator of the field buffers.  Each data set takes one block, mapped
+// with the arena's page policy and, for interleave and bind, given the
+// arena's NUMA memory policy before anything touches it.  The block goes
+// back to the arena when the data set is destroyed; a later
+// data set that fits in a returned block reuses it, already faulted in,
+// instead of mapping and touching new memory.  Blocks are unmapped when
+// the arena is destroyed, so the arena must outlive its data sets.
+//
+struct FieldArena {
+  PagePolicy m_pages;
+  NumaPolicy m_numa;
+  int m_numa_node;
+  std::vector<FieldBlock> m_free;
+  std::vector<FieldBlock> m_used;
+  long m_mappings;
+  long m_reuses;
+  size_t m_mapped_bytes;
+
+  static const size_t huge_page = size_t(2) << 20;
+
+  FieldArena(PagePolicy pages, NumaPolicy numa, int numa_node)
+      : m_pages(pages), m_numa(numa), m_numa_node(numa_node), m_mappings(0),
+        m_reuses(0), m_mapped_bytes(0) {}
+
+  ~FieldArena() {
+    for (size_t b = 0; b < m_free.size(); ++b)
+      Unmap(m_free[b]);
+    for (size_t b = 0; b < m_used.size(); ++b)
+      Unmap(m_used[b]);
+  }
+
+  // the smallest free block holding bytes, or a new mapping
+  FieldBlock Acquire(size_t bytes) {
+    size_t best = m_free.size();
+    for (size_t b = 0; b < m_free.size(); ++b) {
+      if (m_free[b].m_bytes >= bytes &&
+          (best == m_free.size() || m_free[b].m_bytes < m_free[best].m_bytes))
+        best = b;
+    }
+    FieldBlock block;
+    if (best < m_free.size()) {
+      block = m_free[best];
+      m_free.erase(m_free.begin() + best);
+      ++m_reuses;
+    } else {
+      block = Map(bytes);
+    }
+    m_used.push_back(block);
+    return block;
+  }
+
+  void Release(const FieldBlock &block) {
+    for (size_t b = 0; b < m_used.size(); ++b) {
+      if (m_used[b].m_base == block.m_base) {
+        m_free.push_back(m_used[b]);
+        m_used.erase(m_used.begin() + b);
+        return;
+      }
+    }
+  }
+
+  //
+  // Bytes of block backed by huge pages, transparent or explicit, from
+  // /proc/self/smaps; 0 where it cannot be read.
+  //
+  static size_t HugeBytes(const FieldBlock &block) {
+    size_t bytes = 0;
+#ifdef FIELD_ARENA_MMAP
+    FILE *smaps = fopen("/proc/self/smaps", "r");
+    if (!smaps)
+      return 0;
+    const uintptr_t lo = uintptr_t(block.m_base);
+    const uintptr_t hi = lo + block.m_bytes;
+    bool inside = false;
+    char line[512];
+    while (fgets(line, sizeof(line), smaps)) {
+      unsigned long start, end, kb;
+      if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+        inside = start < hi && end > lo;
+      } else if (inside &&
+                 (sscanf(line, "AnonHugePages: %lu kB", &kb) == 1 ||
+                  sscanf(line, "Private_Hugetlb: %lu kB", &kb) == 1)) {
+        bytes += size_t(kb) * 1024;
+      }
+    }
+    fclose(smaps);
+#else
+    (void)block;
+#endif
+    return bytes;
+  }
+
+  //
+  // Arena statistics with the page faults taken while the data sets were
+  // allocated and first written, during the first field update and
+  // during each later one.
+  //
+  void PrintStats(long setup_faults, long first_faults, long later_faults,
+                  int later_steps) const {
+    size_t huge = 0, used = 0;
+    for (size_t b = 0; b < m_used.size(); ++b) {
+      huge += HugeBytes(m_used[b]);
+      used += m_used[b].m_bytes;
+    }
+    std::cout << "========= Field Arena ==========\n";
+    std::cout << "pages      : " << PagePolicyName(m_pages) << " ("
+              << (m_used.empty() ? "none"
+                                 : PagePolicyName(m_used[0].m_pages))
+              << " mapped)\n";
+    std::cout << "mappings   : " << m_mappings << " ("
+              << double(m_mapped_bytes) / (1024. * 1024.) << " MB), "
+              << m_reuses << " reused\n";
+    std::cout << "huge pages : " << double(huge) / (1024. * 1024.) << " of "
+              << double(used) / (1024. * 1024.) << " MB in use\n";
+    std::cout << "faults     : " << setup_faults << " setup, " << first_faults
+              << " first step, "
+              << (later_steps > 0 ? double(later_faults) / later_steps : 0.)
+              << " per later step\n";
+    std::cout << "================================\n";
+  }
+
+  //
+  // Bytes of block resident on each NUMA node, from move_pages(2) queries
+  // of at most about a million sampled pages; pages not yet touched are
+  // left out.  Empty where the query is not available.
+  //
+  static std::vector<size_t> NodeBytes(const FieldBlock &block) {
+    std::vector<size_t> bytes;
+#ifdef FIELD_ARENA_MMAP
+    const size_t page = 4096;
+    const size_t pages = block.m_bytes / page;
+    const size_t stride = std::max(pages >> 20, size_t(1));
+    const size_t batch = 4096;
+    std::vector<void *> addresses;
+    std::vector<int> status(batch);
+    for (size_t p = 0; p < pages; p += stride * batch) {
+      addresses.clear();
+      for (size_t q = p; q < pages && addresses.size() < batch; q += stride)
+        addresses.push_back(block.m_base + q * page);
+      if (syscall(SYS_move_pages, 0, addresses.size(), &addresses[0], NULL,
+                  &status[0], 0) != 0)
+        return std::vector<size_t>();
+      for (size_t a = 0; a < addresses.size(); ++a) {
+        if (status[a] < 0)
+          continue;
+        if (size_t(status[a]) >= bytes.size())
+          bytes.resize(status[a] + 1, 0);
+        bytes[status[a]] += stride * page;
+      }
+    }
+#else
+    (void)block;
+#endif
+    return bytes;
+  }
+
+  // resident bytes per node of the blocks in use
+  void PrintPlacement() const {
+    std::vector<size_t> nodes(NumaNodes(), 0);
+    size_t used = 0;
+    for (size_t b = 0; b < m_used.size(); ++b) {
+      const std::vector<size_t> bytes = NodeBytes(m_used[b]);
+      if (bytes.size() > nodes.size())
+        nodes.resize(bytes.size(), 0);
+      for (size_t n = 0; n < bytes.size(); ++n)
+        nodes[n] += bytes[n];
+      used += m_used[b].m_bytes;
+    }
+    size_t resident = 0;
+    for (size_t n = 0; n < nodes.size(); ++n)
+      resident += nodes[n];
+    std::cout << "========= NUMA Placement =======\n";
+    std::cout << "policy     : " << NumaPolicyName(m_numa);
+    if (m_numa == NUMA_BIND) {
+      std::cout << " (node " << m_numa_node << ")";
+    }
+    std::cout << "\n";
+    for (size_t n = 0; n < nodes.size(); ++n) {
+      std::cout << "node " << n << "     : "
+                << double(nodes[n]) / (1024. * 1024.) << " MB ("
+                << (resident > 0 ? 100. * double(nodes[n]) / double(resident)
+                                 : 0.)
+                << "%)\n";
+    }
+    std::cout << "resident   : " << double(resident) / (1024. * 1024.)
+              << " of " << double(used) / (1024. * 1024.) << " MB\n";
+    std::cout << "================================\n";
+  }
+
+private:
+  // memory policy of the arena for a new, untouched mapping
+  void Bind(const FieldBlock &block) const {
+#ifdef FIELD_ARENA_MMAP
+    if (m_numa != NUMA_INTERLEAVE && m_numa != NUMA_BIND)
+      return;
+    const int nodes = std::max(NumaNodes(), m_numa_node + 1);
+    const size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask((nodes + bits - 1) / bits, 0);
+    for (int n = 0; n < nodes; ++n) {
+      if (m_numa == NUMA_INTERLEAVE || n == m_numa_node)
+        mask[n / bits] |= 1UL << (n % bits);
+    }
+    const int mode =
+        m_numa == NUMA_BIND ? FIELD_MPOL_BIND : FIELD_MPOL_INTERLEAVE;
+    if (syscall(SYS_mbind, block.m_base, block.m_bytes, mode, &mask[0],
+                mask.size() * bits, 0) != 0) {
+      std::cerr << "FieldArena: cannot " << NumaPolicyName(m_numa)
+                << " pages, placing them on first touch\n";
+    }
+#else
+    (void)block;
+#endif
+  }
+
+  FieldBlock Map(size_t bytes) {
+    FieldBlock block;
+    block.m_pages = m_pages;
+#ifdef FIELD_ARENA_MMAP
+    const size_t page = m_pages == PAGES_SMALL ? size_t(4096) : huge_page;
+    block.m_bytes = (bytes + page - 1) / page * page;
+    void *base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (m_pages == PAGES_HUGE) {
+      base = mmap(NULL, block.m_bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (base == MAP_FAILED) {
+      if (m_pages == PAGES_HUGE)
+        block.m_pages = PAGES_TRANSPARENT;
+      // over-map by a huge page and trim, so transparent huge pages can
+      // back the block from its first byte
+      const size_t slack = m_pages == PAGES_SMALL ? 0 : huge_page;
+      char *raw = static_cast<char *>(
+          mmap(NULL, block.m_bytes + slack, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      if (raw == MAP_FAILED) {
+        std::cerr << "FieldArena: cannot map " << block.m_bytes
+                  << " bytes\n";
+        exit(1);
+      }
+      char *aligned = raw;
+      if (slack > 0) {
+        aligned = reinterpret_cast<char *>(
+            (uintptr_t(raw) + slack - 1) / slack * slack);
+        if (aligned > raw)
+          munmap(raw, aligned - raw);
+        if (raw + slack > aligned)
+          munmap(aligned + block.m_bytes, raw + slack - aligned);
+      }
+      base = aligned;
+#ifdef MADV_HUGEPAGE
+      madvise(base, block.m_bytes,
+              m_pages == PAGES_SMALL ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+#endif
+    }
+    block.m_base = static_cast<char *>(base);
+    Bind(block);
+#else
+    block.m_pages = PAGES_SMALL;
+    block.m_bytes = (bytes + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+    void *base = NULL;
+    if (posix_memalign(&base, FIELD_ALIGN, block.m_bytes) != 0) {
+      std::cerr << "FieldArena: cannot allocate " << block.m_bytes
+                << " bytes\n";
+      exit(1);
+    }
+    block.m_base = static_cast<char *>(base);
+#endif
+    ++m_mappings;
+    m_mapped_bytes += block.m_bytes;
+    return block;
+  }
+
+  static void Unmap(const FieldBlock &block) {
+#ifdef FIELD_ARENA_MMAP
+    munmap(block.m_base, block.m_bytes);
+#else
+    free(block.m_base);
+#endif
+  }
+};
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef FIELD_BRICKS_H
+#define FIELD_BRICKS_H
+
+#include "morton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//
+// A lattice of m_dims values stored as cubic bricks of 2^m_shift values
+// per edge, the bricks in x-fastest order.  Inside a brick the values are
+// x-fastest too, or Morton ordered (m_morton) so that values close in all
+// three axes are close in memory.  Bricks keep the padding of a non power
+// of two lattice below one brick per axis, where a single Morton curve
+// over the whole lattice would pad every axis to the largest power of two.
+//
+// The field kernels produce x rows, so values go in and out a row at a
+// time (Scatter, Gather); in either order the in-brick code of (x, y, z)
+// is the union of per-axis tables, so a row costs one table lookup per
+// value.  Neighbourhood reads go through Extract a brick at a time rather
+// than by stepping codes per point.
+//
+struct FieldBricks {
+  int m_dims[3];
+  int m_shift;
+  int m_edge;
+  bool m_morton;
+  int m_bricks[3];
+  size_t m_brick_size;
+  std::vector<uint32_t> m_spread[3]; // in-brick code of local x, y, z
+
+  FieldBricks(const int dims[3], int shift, bool morton)
+      : m_dims{dims[0], dims[1], dims[2]}, m_shift(shift), m_edge(1 << shift),
+        m_morton(morton),
+        m_bricks{(dims[0] + m_edge - 1) >> shift,
+                 (dims[1] + m_edge - 1) >> shift,
+                 (dims[2] + m_edge - 1) >> shift},
+        m_brick_size(size_t(1) << (3 * shift)) {
+    for (int a = 0; a < 3; ++a) {
+      m_spread[a].resize(m_edge);
+      for (int i = 0; i < m_edge; ++i)
+        m_spread[a][i] = morton ? uint32_t(MortonSpread(uint64_t(i)) << a)
+                                : uint32_t(i) << (a * shift);
+    }
+  }
+
+  size_t Count() const {
+    return size_t(m_bricks[0]) * size_t(m_bricks[1]) * size_t(m_bricks[2]);
+  }
+
+  // values of the padded bricks
+  size_t Size() const { return Count() * m_brick_size; }
+
+  // offset of the first value of brick (bx, by, bz)
+  size_t Brick(int bx, int by, int bz) const {
+    return ((size_t(bz) * size_t(m_bricks[1]) + size_t(by)) *
+                size_t(m_bricks[0]) +
+            size_t(bx)) *
+           m_brick_size;
+  }
+
+  size_t Index(int x, int y, int z) const {
+    const int mask = m_edge - 1;
+    return Brick(x >> m_shift, y >> m_shift, z >> m_shift) +
+           (m_spread[0][x & mask] | m_spread[1][y & mask] |
+            m_spread[2][z & mask]);
+  }
+
+  // row (y, z) of values into the bricks
+  void Scatter(double *bricks, int y, int z, const double *row) const {
+    const int mask = m_edge - 1;
+    const uint32_t *spread = &m_spread[0][0];
+    double *brick = bricks + Brick(0, y >> m_shift, z >> m_shift) +
+                    (m_spread[1][y & mask] | m_spread[2][z & mask]);
+    for (int x0 = 0; x0 < m_dims[0]; x0 += m_edge, brick += m_brick_size) {
+      const int n = std::min(m_edge, m_dims[0] - x0);
+      for (int i = 0; i < n; ++i)
+        brick[spread[i]] = row[x0 + i];
+    }
+  }
+
+  // row (y, z) of values out of the bricks
+  void Gather(const double *bricks, int y, int z, double *row) const {
+    const int mask = m_edge - 1;
+    const uint32_t *spread = &m_spread[0][0];
+    const double *brick = bricks + Brick(0, y >> m_shift, z >> m_shift) +
+                          (m_spread[1][y & mask] | m_spread[2][z & mask]);
+    for (int x0 = 0; x0 < m_dims[0]; x0 += m_edge, brick += m_brick_size) {
+      const int n = std::min(m_edge, m_dims[0] - x0);
+      for (int i = 0; i < n; ++i)
+        row[x0 + i] = brick[spread[i]];
+    }
+  }
+
+  //
+  // The box [lo, hi) of values, x fastest, into out: each row of the box
+  // finds its brick and in-brick y, z code once per brick it crosses, so a
+  // value costs one table lookup, as in Gather.  A kernel that reads
+  // neighbours copies a brick and its halo out this way and then runs with
+  // the fixed offsets of the linear order.
+  //
+  void Extract(const double *bricks, const int lo[3], const int hi[3],
+               double *out) const {
+    const int mask = m_edge - 1;
+    const uint32_t *spread = &m_spread[0][0];
+    for (int z = lo[2]; z < hi[2]; ++z)
+      for (int y = lo[1]; y < hi[1]; ++y) {
+        const double *row = bricks + Brick(0, y >> m_shift, z >> m_shift) +
+                            (m_spread[1][y & mask] | m_spread[2][z & mask]);
+        for (int x = lo[0]; x < hi[0];) {
+          const int bx = x >> m_shift;
+          const int end = std::min(hi[0], (bx + 1) << m_shift);
+          const double *brick = row + size_t(bx) * m_brick_size;
+          for (; x < end; ++x)
+            *out++ = brick[spread[x & mask]];
+        }
+      }
+  }
+
+  //
+  // Copies the bricks of row (by, bz) of bricks into the x-fastest array
+  // linear, one brick at a time: each brick is read while it is in cache
+  // and written as runs of m_edge values within its footprint of the
+  // linear array.
+  //
+  void Linearize(const double *bricks, int by, int bz, double *linear) const {
+    const int y0 = by << m_shift, z0 = bz << m_shift;
+    const int ny = std::min(m_edge, m_dims[1] - y0);
+    const int nz = std::min(m_edge, m_dims[2] - z0);
+    for (int bx = 0; bx < m_bricks[0]; ++bx) {
+      const double *brick = bricks + Brick(bx, by, bz);
+      const int x0 = bx << m_shift;
+      const int nx = std::min(m_edge, m_dims[0] - x0);
+      for (int lz = 0; lz < nz; ++lz)
+        for (int ly = 0; ly < ny; ++ly) {
+          const uint32_t yz = m_spread[1][ly] | m_spread[2][lz];
+          double *row = linear + (size_t(z0 + lz) * size_t(m_dims[1]) +
+                                  size_t(y0 + ly)) *
+                                     size_t(m_dims[0]) +
+                        size_t(x0);
+          for (int lx = 0; lx < nx; ++lx)
+            row[lx] = brick[m_spread[0][lx] | yz];
+        }
+    }
+  }
+};
+
+//
+// Value range of a brick, merged from the threads that write its rows.
+//
+inline void BrickMin(std::atomic<double> &range, double value) {
+  double current = range.load(std::memory_order_relaxed);
+  while (value < current &&
+         !range.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed))
+    ;
+}
+
+inline void BrickMax(std::atomic<double> &range, double value) {
+  double current = range.load(std::memory_order_relaxed);
+  while (value > current &&
+         !range.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed))
+    ;
+}
+
+#endif
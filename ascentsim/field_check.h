@@ -0,0 +1,239 @@
+#ifndef FIELD_CHECK_H
+#define FIELD_CHECK_H
+
+#include "field_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+//
+// Checksum and summary of one field.  m_hash is the wrapping sum of a hash
+// of every value's bits and array offset, so it does not depend on the
+// order the values are visited in, and any changed bit (or moved value)
+// changes it.
+//
+struct FieldDigest {
+  uint64_t m_hash;
+  double m_sum;
+  double m_min;
+  double m_max;
+
+  FieldDigest() : m_hash(0), m_sum(0.), m_min(HUGE_VAL), m_max(-HUGE_VAL) {}
+
+  void Add(const FieldDigest &other) {
+    m_hash += other.m_hash;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  // the n values starting at array offset
+  void AddRow(const double *values, size_t offset, int n) {
+    for (int i = 0; i < n; ++i) {
+      uint64_t bits;
+      std::memcpy(&bits, &values[i], sizeof(bits));
+      m_hash += Hash(bits ^ (uint64_t(offset + i) * 0x9E3779B97F4A7C15ULL));
+      m_sum += values[i];
+      m_min = std::min(m_min, values[i]);
+      m_max = std::max(m_max, values[i]);
+    }
+  }
+
+  // 64-bit finalizer
+  static uint64_t Hash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+};
+
+//
+// Deviation of a field from its reference.
+//
+struct FieldError {
+  double m_max;    // largest absolute difference
+  double m_sum_sq; // sum of squared differences
+  long m_count;    // values that differ in any bit
+  long m_values;   // values compared
+
+  FieldError() : m_max(0.), m_sum_sq(0.), m_count(0), m_values(0) {}
+
+  void Add(const FieldError &other) {
+    m_max = std::max(m_max, other.m_max);
+    m_sum_sq += other.m_sum_sq;
+    m_count += other.m_count;
+    m_values += other.m_values;
+  }
+
+  // root mean square deviation
+  double Rms() const {
+    return m_values > 0 ? std::sqrt(m_sum_sq / double(m_values)) : 0.;
+  }
+
+  void AddRow(const double *values, const double *reference, int n) {
+    m_values += n;
+    for (int i = 0; i < n; ++i) {
+      if (std::memcmp(&values[i], &reference[i], sizeof(double)) == 0)
+        continue;
+      const double diff = std::fabs(values[i] - reference[i]);
+      // a NaN on either side fails any tolerance
+      m_max = diff == diff ? std::max(m_max, diff) : HUGE_VAL;
+      m_sum_sq += diff * diff;
+      ++m_count;
+    }
+  }
+};
+
+//
+// Per-step validation of the nodal and zonal scalars.  Digest computes the
+// checksums of the fields a step produced; Compare also measures them
+// against the same step from a reference run.  The fields are read a row
+// at a time from any Fields type with m_point_dims, m_cell_dims and
+// ReadNodalRow(y, z, scratch) / ReadZonalRow(y, z, scratch), so the
+// checksum of a row does not depend on how the rows are stored, and the
+// offsets hashed are those of the linear order for any layout.  Rows that
+// must be gathered go into ScratchRow(0) and ScratchRow(1) of fields, the
+// calling thread's.  Both pass over the rows in the engine's threads with
+// Place, so the check stays out of the update statistics, each row into
+// its own slot, and the slots are summed in row order afterwards, so the
+// results are the same bits for any thread count, partition or schedule.
+//
+// A step passes when the largest deviation of either field is within
+// m_tolerance; a tolerance of 0 asks for the same bits, checksum included.
+//
+struct FieldCheck {
+  double m_tolerance;
+  std::vector<FieldDigest> m_nodal_rows;
+  std::vector<FieldDigest> m_zonal_rows;
+  std::vector<FieldError> m_nodal_error_rows;
+  std::vector<FieldError> m_zonal_error_rows;
+  FieldDigest m_nodal;
+  FieldDigest m_zonal;
+  FieldError m_nodal_error;
+  FieldError m_zonal_error;
+  long m_steps;
+  long m_failures;
+  double m_worst_nodal;
+  double m_worst_zonal;
+  double m_seconds;
+
+  explicit FieldCheck(double tolerance)
+      : m_tolerance(tolerance), m_steps(0), m_failures(0), m_worst_nodal(0.),
+        m_worst_zonal(0.), m_seconds(0.) {}
+
+  template <typename Fields>
+  void Digest(FieldEngine &engine, const Fields &fields) {
+    Run(engine, fields, static_cast<const Fields *>(NULL));
+  }
+
+  //
+  // Checksums fields and measures them against reference, which has the
+  // same dimensions.  Returns whether the step is within tolerance.
+  //
+  template <typename Fields>
+  bool Compare(FieldEngine &engine, const Fields &fields,
+               const Fields &reference) {
+    Run(engine, fields, &reference);
+    m_worst_nodal = std::max(m_worst_nodal, m_nodal_error.m_max);
+    m_worst_zonal = std::max(m_worst_zonal, m_zonal_error.m_max);
+    const bool pass = m_nodal_error.m_max <= m_tolerance &&
+                      m_zonal_error.m_max <= m_tolerance;
+    if (!pass)
+      ++m_failures;
+    return pass;
+  }
+
+  // one line for the last step; errors only after Compare
+  void PrintStep(int step, double time, bool compared) const {
+    const std::ios::fmtflags flags = std::cout.flags();
+    std::cout << "check " << step << " (t " << time << "): nodal "
+              << std::hex << std::setfill('0') << std::setw(16)
+              << m_nodal.m_hash << ", zonal " << std::setw(16)
+              << m_zonal.m_hash << std::setfill(' ');
+    std::cout.flags(flags);
+    if (compared) {
+      std::cout << ", max err " << m_nodal_error.m_max << " / "
+                << m_zonal_error.m_max << ", rms "
+                << m_nodal_error.Rms() << " / " << m_zonal_error.Rms()
+                << (m_nodal_error.m_max <= m_tolerance &&
+                            m_zonal_error.m_max <= m_tolerance
+                        ? ""
+                        : "  FAIL");
+    }
+    std::cout << "\n";
+  }
+
+  void PrintStats(bool compared) const {
+    std::cout << "========= Field Check ==========\n";
+    std::cout << "steps      : " << m_steps << " ("
+              << (m_steps > 0 ? 1e3 * m_seconds / double(m_steps) : 0.)
+              << " ms each)\n";
+    if (compared) {
+      std::cout << "tolerance  : " << m_tolerance << "\n";
+      std::cout << "worst err  : nodal " << m_worst_nodal << ", zonal "
+                << m_worst_zonal << "\n";
+      std::cout << "failures   : " << m_failures << " of " << m_steps
+                << " steps\n";
+    }
+    std::cout << "================================\n";
+  }
+
+private:
+  template <typename Fields>
+  void Run(FieldEngine &engine, const Fields &fields,
+           const Fields *reference) {
+    const double start = PoolSeconds();
+    const int *point_dims = fields.m_point_dims;
+    const int *cell_dims = fields.m_cell_dims;
+    const size_t rows = size_t(point_dims[1]) * size_t(point_dims[2]);
+    const size_t cell_rows = size_t(cell_dims[1]) * size_t(cell_dims[2]);
+    m_nodal_rows.assign(rows, FieldDigest());
+    m_zonal_rows.assign(cell_rows, FieldDigest());
+    m_nodal_error_rows.assign(rows, FieldError());
+    m_zonal_error_rows.assign(cell_rows, FieldError());
+    engine.Place(point_dims, [&](int y, int z) {
+      double *own = fields.ScratchRow(0);
+      double *other = fields.ScratchRow(1);
+      const size_t row = size_t(z) * size_t(point_dims[1]) + size_t(y);
+      const size_t point_row = row * size_t(point_dims[0]);
+      const double *nodal = fields.ReadNodalRow(y, z, own);
+      m_nodal_rows[row].AddRow(nodal, point_row, point_dims[0]);
+      if (reference)
+        m_nodal_error_rows[row].AddRow(
+            nodal, reference->ReadNodalRow(y, z, other), point_dims[0]);
+      if (y < cell_dims[1] && z < cell_dims[2]) {
+        const size_t cell = size_t(z) * size_t(cell_dims[1]) + size_t(y);
+        const size_t cell_row = cell * size_t(cell_dims[0]);
+        const double *zonal = fields.ReadZonalRow(y, z, own);
+        m_zonal_rows[cell].AddRow(zonal, cell_row, cell_dims[0]);
+        if (reference)
+          m_zonal_error_rows[cell].AddRow(
+              zonal, reference->ReadZonalRow(y, z, other), cell_dims[0]);
+      }
+    });
+    m_nodal = FieldDigest();
+    m_zonal = FieldDigest();
+    m_nodal_error = FieldError();
+    m_zonal_error = FieldError();
+    for (size_t r = 0; r < rows; ++r) {
+      m_nodal.Add(m_nodal_rows[r]);
+      m_nodal_error.Add(m_nodal_error_rows[r]);
+    }
+    for (size_t r = 0; r < cell_rows; ++r) {
+      m_zonal.Add(m_zonal_rows[r]);
+      m_zonal_error.Add(m_zonal_error_rows[r]);
+    }
+    ++m_steps;
+    m_seconds += PoolSeconds() - start;
+  }
+};
+
+#endif
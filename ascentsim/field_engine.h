@@ -0,0 +1,160 @@
+#ifndef FIELD_ENGINE_H
+#define FIELD_ENGINE_H
+
+#include "thread_pool.h"
+#include "work_stealing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+//
+// How the (y, z) rows of the point lattice are grouped into work items.
+//   slabs : ranges of whole z planes
+//   tiles : blocks of m_tile[0] x m_tile[1] rows in y and z
+//
+enum Partition { PARTITION_SLABS, PARTITION_TILES };
+
+//
+// How work items are handed to threads.
+//   static  : each thread takes one contiguous range of items
+//   dynamic : threads pull the next item from a shared counter
+//   steal   : each thread starts on its own range and steals from the
+//             others when it runs out (see WorkStealingScheduler)
+//
+enum Schedule { SCHEDULE_STATIC, SCHEDULE_DYNAMIC, SCHEDULE_STEAL };
+
+//
+// Runs a row kernel over every (y, z) row of a point lattice on the pool.
+// The kernel is called as kernel(y, z) and owns the whole x extent of that
+// row, so one call can write the nodal row and the zonal row that starts at
+// the same (y, z) in a single pass.
+//
+// Every update is accounted per thread in m_stats, so PrintStats() shows the
+// load balance of the whole run.
+//
+struct FieldEngine {
+  ThreadPool m_pool;
+  WorkStealingScheduler m_stealer;
+  Partition m_partition;
+  Schedule m_schedule;
+  int m_tile[2];
+  std::vector<ThreadStats> m_stats;
+  double m_wall;
+
+  FieldEngine(int num_threads, Partition partition, Schedule schedule)
+      : m_pool(std::max(num_threads, 1)), m_stealer(m_pool.Size()),
+        m_partition(partition), m_schedule(schedule), m_tile{8, 8},
+        m_stats(m_pool.Size()), m_wall(0.) {}
+
+  int NumThreads() const { return m_pool.Size(); }
+
+  template <typename RowKernel>
+  void Update(const int point_dims[3], const RowKernel &kernel) {
+    Run(point_dims, kernel, m_partition, m_schedule, m_stats, m_wall);
+  }
+
+  //
+  // Runs kernel over the rows with static slabs, whatever the engine's
+  // partition and schedule, and without accounting.  Pages are placed on
+  // the NUMA node of the thread that first writes them, so buffers first
+  // written here sit on the node of the thread that updates each slab
+  // under the static schedule.
+  //
+  template <typename RowKernel>
+  void Place(const int point_dims[3], const RowKernel &kernel) {
+    std::vector<ThreadStats> stats(m_pool.Size());
+    double wall = 0.;
+    Run(point_dims, kernel, PARTITION_SLABS, SCHEDULE_STATIC, stats, wall);
+  }
+
+  // per-thread busy/idle time over all updates so far, and the imbalance
+  // (slowest thread's busy time over the mean)
+  void PrintStats() const {
+    double total_busy = 0., max_busy = 0.;
+    for (size_t i = 0; i < m_stats.size(); ++i) {
+      total_busy += m_stats[i].m_busy;
+      max_busy = std::max(max_busy, m_stats[i].m_busy);
+    }
+    const double mean_busy = total_busy / double(m_stats.size());
+    std::cout << "======== Thread Balance ========\n";
+    std::cout << "update wall : " << m_wall << " s\n";
+    for (size_t i = 0; i < m_stats.size(); ++i) {
+      std::cout << "thread " << i << " : busy " << m_stats[i].m_busy
+                << " s, idle " << m_stats[i].m_idle << " s, "
+                << m_stats[i].m_tasks << " tasks, " << m_stats[i].m_steals
+                << " steals\n";
+    }
+    std::cout << "imbalance   : "
+              << (mean_busy > 0. ? max_busy / mean_busy : 1.) << "\n";
+    std::cout << "================================\n";
+  }
+
+private:
+  template <typename RowKernel>
+  void Run(const int point_dims[3], const RowKernel &kernel,
+           Partition partition, Schedule schedule,
+           std::vector<ThreadStats> &all_stats, double &total_wall) {
+    const int num_threads = m_pool.Size();
+    int tile_y = m_tile[0];
+    int tile_z = m_tile[1];
+    if (partition == PARTITION_SLABS) {
+      tile_y = point_dims[1];
+      // one slab per thread when static, single planes otherwise
+      tile_z = schedule == SCHEDULE_STATIC
+                   ? (point_dims[2] + num_threads - 1) / num_threads
+                   : 1;
+    }
+    tile_y = std::max(tile_y, 1);
+    tile_z = std::max(tile_z, 1);
+    const int tiles_y = (point_dims[1] + tile_y - 1) / tile_y;
+    const int tiles_z = (point_dims[2] + tile_z - 1) / tile_z;
+    const int num_tiles = tiles_y * tiles_z;
+
+    // tile t covers rows [y0, y1) x [z0, z1); consecutive tiles are
+    // neighbours in memory
+    auto run_tile = [&](int t) {
+      const int y0 = (t % tiles_y) * tile_y;
+      const int z0 = (t / tiles_y) * tile_z;
+      const int y1 = std::min(y0 + tile_y, point_dims[1]);
+      const int z1 = std::min(z0 + tile_z, point_dims[2]);
+      for (int z = z0; z < z1; ++z)
+        for (int y = y0; y < y1; ++y)
+          kernel(y, z);
+    };
+
+    const double start = PoolSeconds();
+    if (schedule == SCHEDULE_STEAL) {
+      m_stealer.Run(m_pool, num_tiles, run_tile, all_stats);
+    } else {
+      std::atomic<int> next(0);
+      std::function<void(int)> job = [&](int thread_id) {
+        ThreadStats &stats = all_stats[thread_id];
+        const double busy_start = PoolSeconds();
+        if (schedule == SCHEDULE_STATIC) {
+          const int begin = int((long)num_tiles * thread_id / num_threads);
+          const int end = int((long)num_tiles * (thread_id + 1) / num_threads);
+          for (int t = begin; t < end; ++t)
+            run_tile(t);
+          stats.m_tasks += end - begin;
+        } else {
+          for (int t = next++; t < num_tiles; t = next++) {
+            run_tile(t);
+            ++stats.m_tasks;
+          }
+        }
+        stats.m_busy += PoolSeconds() - busy_start;
+      };
+      m_pool.Run(job);
+    }
+    const double wall = PoolSeconds() - start;
+    total_wall += wall;
+    for (int i = 0; i < num_threads; ++i) {
+      all_stats[i].m_idle = total_wall - all_stats[i].m_busy;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,498 @@
+#ifndef FIELD_REGISTRY_H
+#define FIELD_REGISTRY_H
+
+#include "field_arena.h"
+#include "field_bricks.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//
+// Mesh entity a field is sampled at.
+//   vertex  : one value per point (nodal)
+//   element : one value per cell (zonal)
+//
+enum FieldAssociation { FIELD_VERTEX, FIELD_ELEMENT };
+
+#define FIELD_MAX_COMPONENTS 3
+
+//
+// Order of the values of the published fields.
+//   linear  : x fastest, then y, then z; rows are contiguous and a chunk
+//             is the array a consumer reads
+//   bricked : cubic bricks (see FieldBricks), x fastest inside each, with
+//             the value range of every brick kept up to date; rows are
+//             staged, and a linear copy is made only to publish the mesh
+//   morton  : bricked, Morton ordered inside each brick, so values close
+//             in all three axes are close in memory.  Opt-in only: the
+//             stencils and range scans of --report=layout run 1.3 to 2.4
+//             times slower on it than on linear, with no locality to
+//             show for it: bricks already keep a neighbourhood within a
+//             few pages, and the order only scatters the reads inside one
+// Unpublished fields are read by the field update a row at a time and stay
+// linear.
+//
+enum FieldOrder { ORDER_LINEAR, ORDER_BRICKED, ORDER_MORTON };
+
+inline const char *FieldOrderName(FieldOrder order) {
+  return order == ORDER_MORTON
+             ? "morton"
+             : order == ORDER_BRICKED ? "bricked" : "linear";
+}
+
+//
+// One named field.  A vector field keeps each component in an array of its
+// own (structure of arrays), so a component row is contiguous like a
+// scalar row.  Unpublished fields are working storage of the field update,
+// such as precomputed terms, and are left out of the mesh.
+//
+struct FieldEntry {
+  std::string m_name;
+  FieldAssociation m_association;
+  int m_components;
+  bool m_publish;
+  bool m_bricked;
+  std::vector<double *> m_values; // chunk * m_components + component
+  std::vector<double *> m_linear; // bricked fields: copy to publish, or empty
+  size_t m_ranges;                // bricked fields: first brick range
+};
+
+//
+// The fields of a data set.  Fields are added while the registry is open
+// and get their storage in Allocate, one FIELD_ALIGN aligned array per
+// component, so adding a field costs no allocation of its own.
+//
+// Storage is split along z into chunks of m_chunk_planes cell planes, each
+// an arena block of its own holding every field's slab of the chunk, so a
+// huge grid is never one huge block.  A vertex field's slab also holds the
+// point plane above its last cell plane, a copy of the first plane of the
+// next chunk made by ShareRow, so each chunk is a complete mesh domain.
+// With one chunk (the default) every array is the whole field.
+//
+// Indices are 64-bit: a row's offset is computed once in size_t, and the
+// loops over a row index it from the row's pointer with an int, which
+// keeps them vectorizable.
+//
+// In the bricked orders (one chunk only) the published fields are bricks,
+// and rows go through the calling thread's staging rows: WriteRow hands
+// out the row to fill, CommitRow scatters the rows of an association into
+// the bricks, and ReadRow gathers a row into scratch.  Each pool thread
+// (see PoolThreadIndex) has staging rows of its own in every registry,
+// acquired with the fields.  The linear copies PopulateNode publishes are
+// only acquired when Allocate is asked for them, for a whole mesh to be
+// published, and LinearizeBricks brings a row of bricks of them up to
+// date, so a data set that publishes bricks, or nothing, holds its fields
+// once.
+//
+// Bricked fields also keep the value range of each cell brick, the edge^3
+// cells of a brick of m_cell_bricks: CommitRow merges a row into the
+// ranges as it scatters it, while the row is still in cache, so the ranges
+// cost no pass of their own.  A vertex row counts in every brick with a
+// cell it is a corner of, so a brick whose range misses an iso-value has
+// no cell the isosurface crosses.  ResetRanges starts them over for an
+// update, and BricksInRange finds the bricks that may hold a value range.
+//
+struct FieldRegistry {
+  const int m_cell_dims[3];
+  const int m_point_dims[3];
+  const int m_chunk_planes;
+  const int m_chunks;
+  const FieldOrder m_order;
+  const FieldBricks m_point_bricks;
+  const FieldBricks m_cell_bricks;
+  std::vector<FieldEntry> m_fields;
+  // brick ranges, merged into by the const row commits
+  mutable std::vector<std::atomic<double>> m_range_min;
+  mutable std::vector<std::atomic<double>> m_range_max;
+  FieldArena *m_arena;
+  std::vector<FieldBlock> m_blocks; // one per chunk
+  int m_threads;
+  size_t m_stage_row;    // doubles per staging row, padded
+  size_t m_stage_rows;   // staging rows per thread
+  double *m_stage;       // m_threads * m_stage_rows rows
+  bool m_linear;
+
+  //
+  // chunk_planes of 0 (or at least the cell planes) keeps one chunk, as
+  // do the bricked orders; bricks are 2^brick_shift values per edge
+  //
+  FieldRegistry(const int cell_dims[3], int chunk_planes,
+                FieldOrder order = ORDER_LINEAR, int brick_shift = 3)
+      : m_cell_dims{cell_dims[0], cell_dims[1], cell_dims[2]},
+        m_point_dims{cell_dims[0] + 1, cell_dims[1] + 1, cell_dims[2] + 1},
+        m_chunk_planes(order == ORDER_LINEAR && chunk_planes > 0 &&
+                               chunk_planes < cell_dims[2]
+                           ? chunk_planes
+                           : cell_dims[2]),
+        m_chunks((cell_dims[2] + m_chunk_planes - 1) / m_chunk_planes),
+        m_order(order),
+        m_point_bricks(m_point_dims, brick_shift, order == ORDER_MORTON),
+        m_cell_bricks(m_cell_dims, brick_shift, order == ORDER_MORTON),
+        m_arena(NULL), m_threads(0), m_stage_row(0), m_stage_rows(0),
+        m_stage(NULL), m_linear(false) {}
+
+  ~FieldRegistry() {
+    for (size_t b = 0; b < m_blocks.size(); ++b)
+      m_arena->Release(m_blocks[b]);
+  }
+
+  // registers a field and returns its index; only before Allocate
+  int Add(const std::string &name, FieldAssociation association,
+          int components, bool publish = true) {
+    assert(!m_arena && components >= 1 && components <= FIELD_MAX_COMPONENTS);
+    FieldEntry entry;
+    entry.m_name = name;
+    entry.m_association = association;
+    entry.m_components = components;
+    entry.m_publish = publish;
+    entry.m_bricked = publish && m_order != ORDER_LINEAR;
+    entry.m_ranges = 0;
+    m_fields.push_back(entry);
+    return int(m_fields.size()) - 1;
+  }
+
+  //
+  // Acquires the storage of the fields, staging rows for threads pool
+  // threads, the threads of the engine that updates them, and in the
+  // bricked orders with linear set, the linear copy of every bricked field
+  // that PopulateNode publishes (LinearizeBricks fills them).  The staging
+  // rows and the copies share the block of the first chunk, so a data set
+  // of one chunk is one arena block.
+  //
+  void Allocate(FieldArena &arena, int threads = 1, bool linear = false) {
+    m_arena = &arena;
+    size_t ranges = 0;
+    for (size_t f = 0; f < m_fields.size(); ++f) {
+      if (!m_fields[f].m_bricked)
+        continue;
+      m_fields[f].m_ranges = ranges;
+      ranges += size_t(m_fields[f].m_components) * BrickCount();
+    }
+    m_range_min = std::vector<std::atomic<double>>(ranges);
+    m_range_max = std::vector<std::atomic<double>>(ranges);
+    ResetRanges();
+    // staging rows of every field and a few scratch rows per thread, each
+    // thread's on cache lines of its own
+    const size_t align = FIELD_ALIGN / sizeof(double);
+    m_threads = std::max(threads, 1);
+    m_stage_row = (size_t(m_point_dims[0]) + align - 1) / align * align;
+    m_stage_rows = m_fields.size() * FIELD_MAX_COMPONENTS + 4;
+    m_linear = linear && m_order != ORDER_LINEAR;
+    for (int chunk = 0; chunk < m_chunks; ++chunk) {
+      FieldLayout layout;
+      std::vector<size_t> offsets;
+      for (size_t f = 0; f < m_fields.size(); ++f) {
+        const FieldEntry &field = m_fields[f];
+        for (int c = 0; c < field.m_components; ++c) {
+          offsets.push_back(layout.Add(
+              field.m_bricked ? Bricks(field).Size() : ChunkSize(field, chunk),
+              sizeof(double)));
+        }
+      }
+      size_t stage = 0;
+      std::vector<size_t> linear_offsets;
+      if (chunk == 0) {
+        stage = layout.Add(size_t(m_threads) * m_stage_rows * m_stage_row,
+                           sizeof(double));
+        for (size_t f = 0; m_linear && f < m_fields.size(); ++f) {
+          for (int c = 0;
+               m_fields[f].m_bricked && c < m_fields[f].m_components; ++c)
+            linear_offsets.push_back(
+                layout.Add(Size(m_fields[f]), sizeof(double)));
+        }
+      }
+      m_blocks.push_back(arena.Acquire(layout.m_bytes));
+      const FieldBlock &block = m_blocks[chunk];
+      size_t next = 0;
+      for (size_t f = 0; f < m_fields.size(); ++f) {
+        FieldEntry &field = m_fields[f];
+        for (int c = 0; c < field.m_components; ++c) {
+          field.m_values.push_back(
+              reinterpret_cast<double *>(block.m_base + offsets[next++]));
+        }
+      }
+      if (chunk != 0)
+        continue;
+      m_stage = reinterpret_cast<double *>(block.m_base + stage);
+      next = 0;
+      for (size_t f = 0; m_linear && f < m_fields.size(); ++f) {
+        for (int c = 0;
+             m_fields[f].m_bricked && c < m_fields[f].m_components; ++c)
+          m_fields[f].m_linear.push_back(reinterpret_cast<double *>(
+              block.m_base + linear_offsets[next++]));
+      }
+    }
+  }
+
+  const int *Dims(const FieldEntry &field) const {
+    return field.m_association == FIELD_VERTEX ? m_point_dims : m_cell_dims;
+  }
+
+  const FieldBricks &Bricks(const FieldEntry &field) const {
+    return field.m_association == FIELD_VERTEX ? m_point_bricks
+                                               : m_cell_bricks;
+  }
+
+  // values per component of the whole field
+  size_t Size(const FieldEntry &field) const {
+    const int *dims = Dims(field);
+    return size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]);
+  }
+
+  // cell planes of chunk, and the field's planes in it
+  int ChunkCells(int chunk) const {
+    return std::min(m_chunk_planes, m_cell_dims[2] - chunk * m_chunk_planes);
+  }
+  int ChunkPlanes(const FieldEntry &field, int chunk) const {
+    return ChunkCells(chunk) + (field.m_association == FIELD_VERTEX ? 1 : 0);
+  }
+
+  // values per component in chunk
+  size_t ChunkSize(const FieldEntry &field, int chunk) const {
+    const int *dims = Dims(field);
+    return size_t(dims[0]) * size_t(dims[1]) *
+           size_t(ChunkPlanes(field, chunk));
+  }
+
+  // the values of chunk in linear order, the copy of a bricked field (see
+  // Allocate)
+  double *Chunk(int field, int component, int chunk) const {
+    const FieldEntry &entry = m_fields[field];
+    assert(!entry.m_bricked || m_linear);
+    return entry.m_bricked
+               ? entry.m_linear[component]
+               : entry.m_values[chunk * entry.m_components + component];
+  }
+
+  // the whole component, when stored linear in one chunk
+  double *Values(int field, int component = 0) const {
+    return m_chunks == 1 && !m_fields[field].m_bricked
+               ? Chunk(field, component, 0)
+               : NULL;
+  }
+
+  // row (y, z) of a linear component, in the chunk owning plane z
+  double *Row(int field, int component, int y, int z) const {
+    assert(!m_fields[field].m_bricked);
+    const int chunk = std::min(z / m_chunk_planes, m_chunks - 1);
+    const int *dims = Dims(m_fields[field]);
+    return Chunk(field, component, chunk) +
+           (size_t(z - chunk * m_chunk_planes) * size_t(dims[1]) +
+            size_t(y)) *
+               size_t(dims[0]);
+  }
+
+  // value (x, y, z) of a component in either order
+  double &At(int field, int component, int x, int y, int z) const {
+    const FieldEntry &entry = m_fields[field];
+    if (entry.m_bricked)
+      return entry.m_values[component][Bricks(entry).Index(x, y, z)];
+    return Row(field, component, y, z)[x];
+  }
+
+  //
+  // Row (y, z) of a component to write, in place when linear; a bricked
+  // component's row is the calling thread's staging row until CommitRow.
+  //
+  double *WriteRow(int field, int component, int y, int z) const {
+    if (!m_fields[field].m_bricked)
+      return Row(field, component, y, z);
+    return StageRow(field * FIELD_MAX_COMPONENTS + component);
+  }
+
+  //
+  // After the rows (y, z) of the fields of association are written: the
+  // staged rows of the bricked fields go into their bricks and ranges, and
+  // a linear vertex row is shared with the chunk below (see ShareRow).
+  //
+  void CommitRow(FieldAssociation association, int y, int z) const {
+    if (m_order == ORDER_LINEAR) {
+      if (association == FIELD_VERTEX)
+        ShareRow(y, z);
+      return;
+    }
+    for (size_t f = 0; f < m_fields.size(); ++f) {
+      const FieldEntry &field = m_fields[f];
+      if (!field.m_bricked || field.m_association != association)
+        continue;
+      for (int c = 0; c < field.m_components; ++c) {
+        const double *row = StageRow(int(f) * FIELD_MAX_COMPONENTS + c);
+        Bricks(field).Scatter(field.m_values[c], y, z, row);
+        MergeRanges(field, c, y, z, row);
+      }
+    }
+  }
+
+  // row (y, z) of a component to read: in place, or gathered into scratch
+  const double *ReadRow(int field, int component, int y, int z,
+                        double *scratch) const {
+    const FieldEntry &entry = m_fields[field];
+    if (!entry.m_bricked)
+      return Row(field, component, y, z);
+    Bricks(entry).Gather(entry.m_values[component], y, z, scratch);
+    return scratch;
+  }
+
+  // the calling thread's scratch row slot, past the staging rows
+  double *ScratchRow(int slot) const {
+    return StageRow(int(m_fields.size()) * FIELD_MAX_COMPONENTS + slot);
+  }
+
+  // bricks (by, bz) of every bricked field into its linear copy
+  void LinearizeBricks(int by, int bz) const {
+    assert(m_linear);
+    for (size_t f = 0; f < m_fields.size(); ++f) {
+      const FieldEntry &field = m_fields[f];
+      const FieldBricks &bricks = Bricks(field);
+      if (!field.m_bricked || by >= bricks.m_bricks[1] ||
+          bz >= bricks.m_bricks[2])
+        continue;
+      for (int c = 0; c < field.m_components; ++c)
+        bricks.Linearize(field.m_values[c], by, bz, field.m_linear[c]);
+    }
+  }
+
+  // cell bricks, over which the value ranges are kept
+  size_t BrickCount() const { return m_cell_bricks.Count(); }
+
+  // cells [lo, hi) of cell brick
+  void BrickCells(size_t brick, int lo[3], int hi[3]) const {
+    const int *bricks = m_cell_bricks.m_bricks;
+    const size_t index[3] = {brick % size_t(bricks[0]),
+                             brick / size_t(bricks[0]) % size_t(bricks[1]),
+                             brick / size_t(bricks[0]) / size_t(bricks[1])};
+    for (int a = 0; a < 3; ++a) {
+      lo[a] = int(index[a]) << m_cell_bricks.m_shift;
+      hi[a] = std::min(lo[a] + m_cell_bricks.m_edge, m_cell_dims[a]);
+    }
+  }
+
+  // empty ranges for every brick, before the fields are written again
+  void ResetRanges() {
+    for (size_t r = 0; r < m_range_min.size(); ++r) {
+      m_range_min[r].store(HUGE_VAL, std::memory_order_relaxed);
+      m_range_max[r].store(-HUGE_VAL, std::memory_order_relaxed);
+    }
+  }
+
+  // range of a bricked component over the cells of brick
+  double RangeMin(int field, int component, size_t brick) const {
+    return m_range_min[RangeIndex(m_fields[field], component, brick)].load(
+        std::memory_order_relaxed);
+  }
+  double RangeMax(int field, int component, size_t brick) const {
+    return m_range_max[RangeIndex(m_fields[field], component, brick)].load(
+        std::memory_order_relaxed);
+  }
+
+  //
+  // Appends to bricks, in ascending order, the cell bricks of a bricked
+  // component whose range meets [lo, hi]; cells outside them all have
+  // values outside it, and a surface of a value in it misses them.
+  //
+  void BricksInRange(int field, int component, double lo, double hi,
+                     std::vector<size_t> &bricks) const {
+    const size_t first = RangeIndex(m_fields[field], component, 0);
+    for (size_t b = 0; b < BrickCount(); ++b) {
+      if (m_range_min[first + b].load(std::memory_order_relaxed) <= hi &&
+          m_range_max[first + b].load(std::memory_order_relaxed) >= lo)
+        bricks.push_back(b);
+    }
+  }
+
+  //
+  // Copies point row (y, z) of the published vertex fields to the top
+  // plane of the chunk below when z is a plane the two chunks share.  Call
+  // after the row is written.
+  //
+  void ShareRow(int y, int z) const {
+    if (z == 0 || z % m_chunk_planes != 0 || z / m_chunk_planes >= m_chunks)
+      return;
+    const int chunk = z / m_chunk_planes;
+    const size_t top = (size_t(m_chunk_planes) * size_t(m_point_dims[1]) +
+                        size_t(y)) *
+                       size_t(m_point_dims[0]);
+    const size_t row = size_t(y) * size_t(m_point_dims[0]);
+    for (size_t f = 0; f < m_fields.size(); ++f) {
+      if (!m_fields[f].m_publish || m_fields[f].m_association != FIELD_VERTEX)
+        continue;
+      for (int c = 0; c < m_fields[f].m_components; ++c)
+        std::memcpy(Chunk(int(f), c, chunk - 1) + top,
+                    Chunk(int(f), c, chunk) + row,
+                    size_t(m_point_dims[0]) * sizeof(double));
+    }
+  }
+
+  // field named name, or NULL
+  const FieldEntry *Find(const std::string &name) const {
+    for (size_t f = 0; f < m_fields.size(); ++f) {
+      if (m_fields[f].m_name == name)
+        return &m_fields[f];
+    }
+    return NULL;
+  }
+
+  // Blueprint names of the components of a vector field
+  static const char *ComponentName(int component) {
+    static const char *const names[FIELD_MAX_COMPONENTS] = {"u", "v", "w"};
+    return names[component];
+  }
+
+private:
+  size_t RangeIndex(const FieldEntry &field, int component,
+                    size_t brick) const {
+    assert(field.m_bricked);
+    return field.m_ranges + size_t(component) * BrickCount() + brick;
+  }
+
+  //
+  // Merges row (y, z) of a component into the ranges of the cell bricks
+  // it is in: its cells', or those its points are corners of, which for a
+  // point on a brick face are the bricks on both sides.
+  //
+  void MergeRanges(const FieldEntry &field, int component, int y, int z,
+                   const double *row) const {
+    const FieldBricks &cells = m_cell_bricks;
+    const int vertex = field.m_association == FIELD_VERTEX ? 1 : 0;
+    const int y0 = std::max(y - vertex, 0) >> cells.m_shift;
+    const int y1 = std::min(y, m_cell_dims[1] - 1) >> cells.m_shift;
+    const int z0 = std::max(z - vertex, 0) >> cells.m_shift;
+    const int z1 = std::min(z, m_cell_dims[2] - 1) >> cells.m_shift;
+    const int n = Dims(field)[0];
+    for (int bx = 0; bx < cells.m_bricks[0]; ++bx) {
+      const int x0 = bx << cells.m_shift;
+      const int x1 = std::min(x0 + cells.m_edge + vertex, n);
+      double lo = row[x0], hi = row[x0];
+      for (int x = x0 + 1; x < x1; ++x) {
+        lo = std::min(lo, row[x]);
+        hi = std::max(hi, row[x]);
+      }
+      for (int bz = z0; bz <= z1; ++bz)
+        for (int by = y0; by <= y1; ++by) {
+          const size_t r = RangeIndex(
+              field, component,
+              (size_t(bz) * size_t(cells.m_bricks[1]) + size_t(by)) *
+                      size_t(cells.m_bricks[0]) +
+                  size_t(bx));
+          BrickMin(m_range_min[r], lo);
+          BrickMax(m_range_max[r], hi);
+        }
+    }
+  }
+
+  // row slot of the calling pool thread's staging rows in this registry
+  double *StageRow(int slot) const {
+    const int thread = PoolThreadIndex();
+    assert(thread < m_threads && size_t(slot) < m_stage_rows);
+    return m_stage +
+           (size_t(thread) * m_stage_rows + size_t(slot)) * m_stage_row;
+  }
+};
+
+#endif
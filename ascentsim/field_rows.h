@@ -0,0 +1,130 @@
+#ifndef FIELD_ROWS_H
+#define FIELD_ROWS_H
+
+#include "open_simplex_noise.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FIELD_ROWS_X86
+#endif
+
+//
+// Inner loops of the DataSet field update, one version per instruction set
+// of enum osn_isa, so the driver runs the same ISA as the noise rows.  The
+// vector versions are compiled for their ISA with target attributes and
+// only called when open_simplex_noise_isa_supported says the CPU has it.
+// Each does the same operations in the same order as the scalar version,
+// so all versions write the same bits (with -ffp-contract=off).
+//
+
+// out[i] = radial_sin[i] * cos_t + radial_cos[i] * sin_t
+inline void SeparableRowScalar(const double *radial_sin,
+                               const double *radial_cos, double cos_t,
+                               double sin_t, int n, double *out) {
+  for (int i = 0; i < n; ++i)
+    out[i] = radial_sin[i] * cos_t + radial_cos[i] * sin_t;
+}
+
+// cells[i] = mean of the 8 corners of cell i, whose lower x corner is i on
+// the point rows p00, p10 (y + 1), p01 (z + 1) and p11 (y + 1, z + 1)
+inline void AverageRowScalar(const double *p00, const double *p10,
+                             const double *p01, const double *p11, int n,
+                             double *cells) {
+  for (int i = 0; i < n; ++i)
+    cells[i] = 0.125 * (p00[i] + p00[i + 1] + p10[i] + p10[i + 1] + p01[i] +
+                        p01[i + 1] + p11[i] + p11[i + 1]);
+}
+
+#ifdef FIELD_ROWS_X86
+__attribute__((target("avx2"))) inline void
+SeparableRowAvx2(const double *radial_sin, const double *radial_cos,
+                 double cos_t, double sin_t, int n, double *out) {
+  const __m256d c = _mm256_set1_pd(cos_t), s = _mm256_set1_pd(sin_t);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d a = _mm256_mul_pd(_mm256_loadu_pd(radial_sin + i), c);
+    const __m256d b = _mm256_mul_pd(_mm256_loadu_pd(radial_cos + i), s);
+    _mm256_storeu_pd(out + i, _mm256_add_pd(a, b));
+  }
+  SeparableRowScalar(radial_sin + i, radial_cos + i, cos_t, sin_t, n - i,
+                     out + i);
+}
+
+__attribute__((target("avx2"))) inline void
+AverageRowAvx2(const double *p00, const double *p10, const double *p01,
+               const double *p11, int n, double *cells) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d sum = _mm256_add_pd(_mm256_loadu_pd(p00 + i),
+                                _mm256_loadu_pd(p00 + i + 1));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p10 + i));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p10 + i + 1));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p01 + i));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p01 + i + 1));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p11 + i));
+    sum = _mm256_add_pd(sum, _mm256_loadu_pd(p11 + i + 1));
+    _mm256_storeu_pd(cells + i, _mm256_mul_pd(_mm256_set1_pd(0.125), sum));
+  }
+  AverageRowScalar(p00 + i, p10 + i, p01 + i, p11 + i, n - i, cells + i);
+}
+
+__attribute__((target("avx512f"))) inline void
+SeparableRowAvx512(const double *radial_sin, const double *radial_cos,
+                   double cos_t, double sin_t, int n, double *out) {
+  const __m512d c = _mm512_set1_pd(cos_t), s = _mm512_set1_pd(sin_t);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d a = _mm512_mul_pd(_mm512_loadu_pd(radial_sin + i), c);
+    const __m512d b = _mm512_mul_pd(_mm512_loadu_pd(radial_cos + i), s);
+    _mm512_storeu_pd(out + i, _mm512_add_pd(a, b));
+  }
+  SeparableRowScalar(radial_sin + i, radial_cos + i, cos_t, sin_t, n - i,
+                     out + i);
+}
+
+__attribute__((target("avx512f"))) inline void
+AverageRowAvx512(const double *p00, const double *p10, const double *p01,
+                 const double *p11, int n, double *cells) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d sum = _mm512_add_pd(_mm512_loadu_pd(p00 + i),
+                                _mm512_loadu_pd(p00 + i + 1));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p10 + i));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p10 + i + 1));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p01 + i));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p01 + i + 1));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p11 + i));
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(p11 + i + 1));
+    _mm512_storeu_pd(cells + i, _mm512_mul_pd(_mm512_set1_pd(0.125), sum));
+  }
+  AverageRowScalar(p00 + i, p10 + i, p01 + i, p11 + i, n - i, cells + i);
+}
+#endif
+
+//
+// The row loops of one instruction set.  Kernels call through it once per
+// row, never per point.
+//
+struct FieldRows {
+  void (*m_separable)(const double *radial_sin, const double *radial_cos,
+                      double cos_t, double sin_t, int n, double *out);
+  void (*m_average)(const double *p00, const double *p10, const double *p01,
+                    const double *p11, int n, double *cells);
+};
+
+inline FieldRows GetFieldRows(osn_isa isa) {
+#ifdef FIELD_ROWS_X86
+  if (isa == OSN_ISA_AVX512) {
+    const FieldRows rows = {SeparableRowAvx512, AverageRowAvx512};
+    return rows;
+  }
+  if (isa == OSN_ISA_AVX2) {
+    const FieldRows rows = {SeparableRowAvx2, AverageRowAvx2};
+    return rows;
+  }
+#endif
+  const FieldRows rows = {SeparableRowScalar, AverageRowScalar};
+  return rows;
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef KEYFRAME_CACHE_H
+#define KEYFRAME_CACHE_H
+
+#include "field_arena.h"
+#include "field_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+//
+// How a step is produced from the keyframes around it.
+//   linear : between the two nearest keyframes
+//   cubic  : Catmull-Rom through the four nearest keyframes
+//
+enum Interpolation { INTERP_LINEAR, INTERP_CUBIC };
+
+//
+// Ring of keyframe buffers for a time dependent field.  Keyframe j holds
+// the exact nodal and zonal values at time j * m_spacing; every step is
+// interpolated from the keyframes around it instead of being evaluated.
+//
+// A periodic field is sampled m_wrap times per period and keyframe j is
+// stored as j mod m_wrap, so the ring holds the whole period and nothing is
+// evaluated after the first pass through it.  Any other field keeps only
+// the stencil (2 or 4 keyframes) and evaluates a new keyframe each time the
+// stencil slides forward.
+//
+// The error falls with the keyframe spacing, as h^2 for linear and h^3 for
+// Catmull-Rom interpolation of a smooth field, and Calibrate picks the
+// spacing from a bound on it.  What a finer spacing costs differs: a
+// periodic ring holds one field per keyframe, so memory grows with the
+// keyframe count, while a sliding ring always holds the stencil and pays in
+// evaluations instead, one per keyframe passed; once the spacing is below
+// the time step it evaluates more often than direct evaluation would.  The
+// ring is one block of the FieldArena.
+//
+struct KeyframeCache {
+  Interpolation m_interp;
+  size_t m_point_size;
+  size_t m_cell_size;
+  double m_spacing;
+  long m_wrap;
+  double m_max_error;   // bound the spacing was calibrated for
+  double m_calibration; // largest deviation measured midway at m_spacing
+  FieldArena *m_arena;
+  FieldBlock m_block;
+  std::vector<double *> m_nodal;
+  std::vector<double *> m_zonal;
+  std::vector<long> m_frame; // keyframe held by each slot
+  long m_evaluations;
+  long m_updates;
+  double m_max_nodal_dev;
+  double m_max_zonal_dev;
+
+  KeyframeCache(Interpolation interp, size_t point_size, size_t cell_size)
+      : m_interp(interp), m_point_size(point_size), m_cell_size(cell_size),
+        m_spacing(0.), m_wrap(0), m_max_error(0.), m_calibration(0.),
+        m_arena(NULL), m_evaluations(0), m_updates(0), m_max_nodal_dev(0.),
+        m_max_zonal_dev(0.) {}
+
+  ~KeyframeCache() {
+    if (m_arena)
+      m_arena->Release(m_block);
+  }
+
+  int Stencil() const { return m_interp == INTERP_CUBIC ? 4 : 2; }
+
+  size_t Bytes() const {
+    return m_frame.size() * (m_point_size + m_cell_size) * sizeof(double);
+  }
+
+  //
+  // Chooses the keyframes per period and allocates the ring from arena.
+  // Starting at keyframes, the count doubles until the deviation of a step
+  // interpolated midway between keyframes, measured against the exact
+  // field over the whole grid in each of `intervals` stencil intervals
+  // spread evenly over the period, is within max_error, or until doubling
+  // would pass max_keyframes.  Returns the count, or 0 when max_keyframes
+  // still misses the bound, in which case nothing is allocated.  evaluate
+  // is called as for Update, 5 times (3 linear) per interval measured; a
+  // count stops at the first interval that misses the bound.
+  //
+  template <typename Evaluate>
+  long Calibrate(FieldArena &arena, double period, bool periodic,
+                 long keyframes, long max_keyframes, int intervals,
+                 double max_error, const Evaluate &evaluate, double *nodal,
+                 double *zonal) {
+    const int taps = Stencil();
+    FieldLayout layout;
+    std::vector<size_t> offsets;
+    for (int k = 0; k < taps; ++k) {
+      offsets.push_back(layout.Add(m_point_size, sizeof(double)));
+      offsets.push_back(layout.Add(m_cell_size, sizeof(double)));
+    }
+    const FieldBlock scratch = arena.Acquire(layout.m_bytes);
+    double *nodal_frames[4];
+    double *zonal_frames[4];
+    for (int k = 0; k < taps; ++k) {
+      nodal_frames[k] =
+          reinterpret_cast<double *>(scratch.m_base + offsets[2 * k]);
+      zonal_frames[k] =
+          reinterpret_cast<double *>(scratch.m_base + offsets[2 * k + 1]);
+    }
+    double weights[4];
+    Weights(0.5, weights);
+    // the stencil interval starts at keyframe 1 for cubic, 0 for linear
+    const double middle = m_interp == INTERP_CUBIC ? 1.5 : 0.5;
+    long count = keyframes;
+    double dev = 0.;
+    for (;; count *= 2) {
+      const double spacing = period / double(count);
+      dev = 0.;
+      for (int i = 0; i < intervals && dev <= max_error; ++i) {
+        // interval i starts i / intervals of the way, on a keyframe
+        const long start = count * i / intervals;
+        for (int k = 0; k < taps; ++k) {
+          evaluate(double(start + k) * spacing);
+          std::memcpy(nodal_frames[k], nodal, m_point_size * sizeof(double));
+          std::memcpy(zonal_frames[k], zonal, m_cell_size * sizeof(double));
+        }
+        evaluate((double(start) + middle) * spacing);
+        dev = std::max(
+            dev, std::max(Deviation(nodal_frames, weights, nodal, m_point_size),
+                          Deviation(zonal_frames, weights, zonal, m_cell_size)));
+      }
+      if (dev <= max_error || count * 2 > max_keyframes)
+        break;
+    }
+    arena.Release(scratch);
+    m_max_error = max_error;
+    m_calibration = dev;
+    if (dev > max_error)
+      return 0;
+    Allocate(arena, period / double(count), periodic ? count : 0);
+    return count;
+  }
+
+  //
+  // Writes the field at time into nodal/zonal.  evaluate(t) must write the
+  // exact field at t into the same arrays; it is only called for keyframes
+  // that are not in the ring yet.
+  //
+  template <typename Evaluate>
+  void Update(FieldEngine &engine, const int point_dims[3],
+              const int cell_dims[3], double time, const Evaluate &evaluate,
+              double *nodal, double *zonal) {
+    const double s = time / m_spacing;
+    const long j0 = long(std::floor(s));
+    const int taps = Stencil();
+    const long first = m_interp == INTERP_CUBIC ? j0 - 1 : j0;
+    double weights[4];
+    Weights(s - double(j0), weights);
+
+    const double *nodal_frames[4];
+    const double *zonal_frames[4];
+    for (int k = 0; k < taps; ++k) {
+      const int slot = Fetch(first + k, evaluate, nodal, zonal);
+      nodal_frames[k] = m_nodal[slot];
+      zonal_frames[k] = m_zonal[slot];
+    }
+    ++m_updates;
+
+    auto blend = [&](const double *const *frames, double *out,
+                     size_t offset, int n) {
+      for (int x = 0; x < n; ++x) {
+        double value = 0.;
+        for (int k = 0; k < taps; ++k)
+          value += weights[k] * frames[k][offset + x];
+        out[offset + x] = value;
+      }
+    };
+    engine.Update(point_dims, [&](int y, int z) {
+      blend(nodal_frames, nodal,
+            (size_t(z) * size_t(point_dims[1]) + size_t(y)) *
+                size_t(point_dims[0]),
+            point_dims[0]);
+      if (y < cell_dims[1] && z < cell_dims[2]) {
+        blend(zonal_frames, zonal,
+              (size_t(z) * size_t(cell_dims[1]) + size_t(y)) *
+                  size_t(cell_dims[0]),
+              cell_dims[0]);
+      }
+    });
+  }
+
+  //
+  // Evaluates the exact field at time over the interpolated one and records
+  // the largest deviation, leaving the interpolated values in place.
+  //
+  template <typename Evaluate>
+  void Compare(double time, const Evaluate &evaluate, double *nodal,
+               double *zonal) {
+    std::vector<double> nodal_interp(nodal, nodal + m_point_size);
+    std::vector<double> zonal_interp(zonal, zonal + m_cell_size);
+    evaluate(time);
+    for (size_t i = 0; i < m_point_size; ++i)
+      m_max_nodal_dev =
+          std::max(m_max_nodal_dev, std::fabs(nodal[i] - nodal_interp[i]));
+    for (size_t i = 0; i < m_cell_size; ++i)
+      m_max_zonal_dev =
+          std::max(m_max_zonal_dev, std::fabs(zonal[i] - zonal_interp[i]));
+    std::copy(nodal_interp.begin(), nodal_interp.end(), nodal);
+    std::copy(zonal_interp.begin(), zonal_interp.end(), zonal);
+  }
+
+  void PrintStats() const {
+    std::cout << "======== Keyframe Cache ========\n";
+    std::cout << "interp     : "
+              << (m_interp == INTERP_CUBIC ? "cubic" : "linear") << "\n";
+    std::cout << "spacing    : " << m_spacing << " ("
+              << (m_wrap > 0 ? "periodic" : "sliding") << ")\n";
+    std::cout << "bound      : " << m_max_error << " (" << m_calibration
+              << " measured midway)\n";
+    std::cout << "slots      : " << m_frame.size() << " ("
+              << double(Bytes()) / (1024. * 1024.) << " MB)\n";
+    std::cout << "evaluated  : " << m_evaluations << " keyframes ("
+              << (m_updates > 0 ? double(m_evaluations) / double(m_updates)
+                                : 0.)
+              << " per step)\n";
+    std::cout << "max dev    : nodal " << m_max_nodal_dev << ", zonal "
+              << m_max_zonal_dev << "\n";
+    std::cout << "================================\n";
+  }
+
+private:
+  // ring of one slot per keyframe when periodic (wrap > 0), else the stencil
+  void Allocate(FieldArena &arena, double spacing, long wrap) {
+    m_spacing = spacing;
+    m_wrap = wrap;
+    const int slots = wrap > 0 ? int(wrap) : Stencil();
+    FieldLayout layout;
+    std::vector<size_t> offsets;
+    for (int slot = 0; slot < slots; ++slot) {
+      offsets.push_back(layout.Add(m_point_size, sizeof(double)));
+      offsets.push_back(layout.Add(m_cell_size, sizeof(double)));
+    }
+    m_arena = &arena;
+    m_block = arena.Acquire(layout.m_bytes);
+    for (int slot = 0; slot < slots; ++slot) {
+      m_nodal.push_back(
+          reinterpret_cast<double *>(m_block.m_base + offsets[2 * slot]));
+      m_zonal.push_back(
+          reinterpret_cast<double *>(m_block.m_base + offsets[2 * slot + 1]));
+    }
+    // empty slots hold no keyframe; a cubic stencil starts at keyframe -1
+    m_frame.assign(slots, std::numeric_limits<long>::min());
+  }
+
+  // interpolation weights of the stencil at fraction a of its interval
+  void Weights(double a, double weights[4]) const {
+    if (m_interp == INTERP_CUBIC) {
+      const double a2 = a * a, a3 = a2 * a;
+      weights[0] = 0.5 * (-a3 + 2. * a2 - a);
+      weights[1] = 0.5 * (3. * a3 - 5. * a2 + 2.);
+      weights[2] = 0.5 * (-3. * a3 + 4. * a2 + a);
+      weights[3] = 0.5 * (a3 - a2);
+    } else {
+      weights[0] = 1. - a;
+      weights[1] = a;
+    }
+  }
+
+  // largest difference of the interpolated frames from exact, over n values
+  double Deviation(double *const *frames, const double weights[4],
+                   const double *exact, size_t n) const {
+    const int taps = Stencil();
+    double dev = 0.;
+    for (size_t i = 0; i < n; ++i) {
+      double value = 0.;
+      for (int k = 0; k < taps; ++k)
+        value += weights[k] * frames[k][i];
+      dev = std::max(dev, std::fabs(value - exact[i]));
+    }
+    return dev;
+  }
+
+  // slot holding keyframe j, evaluating it into the ring if needed
+  template <typename Evaluate>
+  int Fetch(long j, const Evaluate &evaluate, double *nodal, double *zonal) {
+    const long slots = long(m_frame.size());
+    const long frame = m_wrap > 0 ? ((j % m_wrap) + m_wrap) % m_wrap : j;
+    const int slot = int(((frame % slots) + slots) % slots);
+    if (m_frame[slot] != frame) {
+      evaluate(double(frame) * m_spacing);
+      std::memcpy(m_nodal[slot], nodal, m_point_size * sizeof(double));
+      std::memcpy(m_zonal[slot], zonal, m_cell_size * sizeof(double));
+      m_frame[slot] = frame;
+      ++m_evaluations;
+    }
+    return slot;
+  }
+};
+
+#endif
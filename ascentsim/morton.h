@@ -0,0 +1,24 @@
+#ifndef MORTON_H
+#define MORTON_H
+
+#include <cstdint>
+
+//
+// 3D Morton (Z-order) codes of up to 21 bits per axis: bit i of x, y and z
+// becomes bit 3i, 3i + 1 and 3i + 2 of the code, so points close in all
+// three axes get close codes.  FieldBricks only ever encodes, one axis at
+// a time into its tables, so the spread is all there is.
+//
+
+// the low 21 bits of v moved to every third bit
+inline uint64_t MortonSpread(uint64_t v) {
+  v &= 0x1fffffULL;
+  v = (v | v << 32) & 0x1f00000000ffffULL;
+  v = (v | v << 16) & 0x1f0000ff0000ffULL;
+  v = (v | v << 8) & 0x100f00f00f00f00fULL;
+  v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+  v = (v | v << 2) & 0x1249249249249249ULL;
+  return v;
+}
+
+#endif
@@ -1,9 +1,24 @@
+#include "brick_cull.h"
+#include "field_check.h"
+#include "field_engine.h"
+#include "field_registry.h"
+#include "field_rows.h"
+#include "keyframe_cache.h"
+#include "noise_kernel.h"
+#include "noise_report.h"
+#include "noise_tile.h"
+#include "open_simplex_fbm.h"
+#include "open_simplex_noise.h"
+
+#include <algorithm>
 #include <ascent.hpp>
 #include <assert.h>
+#include <atomic>
 #include <cmath>
 #include <conduit.hpp>
 #include <conduit_blueprint.hpp>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string.h>
 
@@ -12,17 +27,161 @@
 #define NZ 50
 #define PI 3.14159265
 #define PERIOD 100
+// keyframes per period the calibration may go up to
+#define KEYFRAME_MAX 1024
+// stencil intervals over the period the calibration measures
+#define KEYFRAME_INTERVALS 4
 
 double calculateVelocityMagnitude(double x, double y, double z, double t) {
   return sin(PI * sqrt(pow(x, 2) + pow(y, 2) + pow(z, 2)) + t);
 }
 
+//
+// How the field is produced each step.
+//   direct    : evaluate calculateVelocityMagnitude at every point
+//   separable : sin(pi r + t) = sin(pi r) cos t + cos(pi r) sin t, with the
+//               radial terms computed once when the data set is built
+//   keyframe  : interpolate between exact keyframes kept in a KeyframeCache.
+//               The sine field is periodic in t and gets m_keyframes per
+//               2 pi; any other field gets m_keyframes per PERIOD steps.
+//               The count is doubled, up to KEYFRAME_MAX, until the error
+//               is within m_keyframe_error.  Any other field evaluates
+//               directly once that takes keyframes closer than a step.
+//   tiled     : evaluate one periodic NoiseTile of m_tile points per axis
+//               and replicate it over the grid (noise fields only); a
+//               different field from direct, see NoiseTile
+//
+enum FieldMode { FIELD_DIRECT, FIELD_SEPARABLE, FIELD_KEYFRAME, FIELD_TILED };
+
+//
+// Which field is simulated.
+//   sine       : calculateVelocityMagnitude
+//   simplex    : 4D OpenSimplex noise, with time as the fourth coordinate
+//   fbm        : fractal sum of m_octaves simplex octaves, less the ones
+//                finer than the grid can resolve
+//   turbulence : as fbm, summing the magnitude of each octave
+//
+enum FieldKernel { KERNEL_SINE, KERNEL_SIMPLEX, KERNEL_FBM, KERNEL_TURBULENCE };
+
+//
+// Registry of the fields --field selects from: the option name, whether it
+// is a noise field (which tiled mode needs) and the description published
+// as state/info.  A new field takes a FieldKernel value, an entry here and
+// its row kernel in VisitFieldKernel.
+//
+struct FieldKernelEntry {
+  const char *m_name;
+  FieldKernel m_kernel;
+  bool m_noise;
+  const char *m_info;
+};
+
+static const FieldKernelEntry field_kernels[] = {
+    {"sine", KERNEL_SINE, false, "Pseudocolor of random math function"},
+    {"simplex", KERNEL_SIMPLEX, true, "simplex noise"},
+    {"fbm", KERNEL_FBM, true, "fractal simplex noise"},
+    {"turbulence", KERNEL_TURBULENCE, true, "fractal simplex noise"},
+};
+
+static const int num_field_kernels =
+    int(sizeof(field_kernels) / sizeof(field_kernels[0]));
+
+// entry named name, or NULL
+inline const FieldKernelEntry *FindFieldKernel(const std::string &name) {
+  for (int k = 0; k < num_field_kernels; ++k) {
+    if (name == field_kernels[k].m_name)
+      return &field_kernels[k];
+  }
+  return NULL;
+}
+
+inline const FieldKernelEntry &GetFieldKernel(FieldKernel kernel) {
+  for (int k = 0; k < num_field_kernels; ++k) {
+    if (field_kernels[k].m_kernel == kernel)
+      return field_kernels[k];
+  }
+  return field_kernels[0];
+}
+
+//
+// How zonal values are produced.
+//   independent : the field kernel evaluates every cell on its own
+//   fused       : mean of the cell's 8 corner nodal values, computed as soon
+//                 as the corner rows are written
+//
+enum ZonalMode { ZONAL_INDEPENDENT, ZONAL_FUSED };
+
+//
+// Nodal vector field published alongside the scalars.
+//   none     : scalars only
+//   gradient : velocity = spatial gradient of the simplex field, from the
+//              analytic derivatives of the same noise evaluation
+//
+enum VectorField { VECTOR_NONE, VECTOR_GRADIENT };
+
+//
+// Per-step validation of the scalars, see FieldCheck.
+//   none      : no checks
+//   checksum  : print order-independent checksums of every step, to diff
+//               between runs
+//   reference : also evaluate every step again with the direct field mode,
+//               scalar ISA and one thread, and fail steps that deviate
+//               from it by more than m_tolerance; tiled mode is held to
+//               its own field, every grid point evaluated from its terms
+//
+enum FieldCheckMode { CHECK_NONE, CHECK_CHECKSUM, CHECK_REFERENCE };
+
+//
+// What each step publishes.
+//   all    : the whole mesh
+//   active : only the cell bricks whose nodal range holds one of the
+//            iso-values (see BrickCull), each a domain of its own
+//
+enum PublishMode { PUBLISH_ALL, PUBLISH_ACTIVE };
+
 struct Options {
   int m_dims[3];
   double m_spacing[3];
   int m_time_steps;
   double m_time_delta;
-  Options() : m_dims{NX, NY, NZ}, m_time_steps(10), m_time_delta(0.5) {
+  FieldMode m_field_mode;
+  FieldKernel m_field;
+  ZonalMode m_zonal_mode;
+  VectorField m_vector;
+  int m_octaves;
+  osn_select m_select;
+  int m_threads;
+  Partition m_partition;
+  Schedule m_schedule;
+  int m_keyframes;
+  double m_keyframe_error;
+  Interpolation m_interp;
+  int m_tile;
+  osn_isa m_isa;
+  bool m_isa_auto;
+  PagePolicy m_pages;
+  int m_chunk;
+  FieldOrder m_order;
+  int m_brick;
+  std::vector<double> m_iso;
+  PublishMode m_publish;
+  NumaPolicy m_numa;
+  int m_numa_node;
+  FieldCheckMode m_check;
+  double m_tolerance;
+  std::vector<std::string> m_reports;
+  Options()
+      : m_dims{NX, NY, NZ}, m_time_steps(10), m_time_delta(0.5),
+        m_field_mode(FIELD_DIRECT), m_field(KERNEL_SINE),
+        m_zonal_mode(ZONAL_INDEPENDENT), m_vector(VECTOR_NONE), m_octaves(6),
+        m_select(OSN_SELECT_BRANCH), m_threads(1),
+        m_partition(PARTITION_SLABS), m_schedule(SCHEDULE_STATIC),
+        m_keyframes(32), m_keyframe_error(1e-3), m_interp(INTERP_CUBIC),
+        m_tile(64),
+        m_isa(OSN_ISA_SCALAR), m_isa_auto(true), m_pages(PAGES_TRANSPARENT),
+        m_chunk(0), m_order(ORDER_LINEAR), m_brick(8),
+        m_publish(PUBLISH_ALL), m_numa(NUMA_FIRST_TOUCH), m_numa_node(0),
+        m_check(CHECK_NONE), m_tolerance(0.) {
     SetSpacing();
   }
   void SetSpacing() {
@@ -56,10 +215,253 @@ struct Options {
         std::string time_delta;
         time_delta = GetArg(argv[i]);
         m_time_delta = stof(time_delta);
+      } else if (contains(argv[i], "--field_mode=")) {
+        std::string field_mode = GetArg(argv[i]);
+        if (field_mode == "direct") {
+          m_field_mode = FIELD_DIRECT;
+        } else if (field_mode == "separable") {
+          m_field_mode = FIELD_SEPARABLE;
+        } else if (field_mode == "keyframe") {
+          m_field_mode = FIELD_KEYFRAME;
+        } else if (field_mode == "tiled") {
+          m_field_mode = FIELD_TILED;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--field=")) {
+        const FieldKernelEntry *field = FindFieldKernel(GetArg(argv[i]));
+        if (field) {
+          m_field = field->m_kernel;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--zonal=")) {
+        std::string zonal = GetArg(argv[i]);
+        if (zonal == "independent") {
+          m_zonal_mode = ZONAL_INDEPENDENT;
+        } else if (zonal == "fused") {
+          m_zonal_mode = ZONAL_FUSED;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--vector=")) {
+        std::string vector = GetArg(argv[i]);
+        if (vector == "none") {
+          m_vector = VECTOR_NONE;
+        } else if (vector == "gradient") {
+          m_vector = VECTOR_GRADIENT;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--octaves=")) {
+        m_octaves = stoi(GetArg(argv[i]));
+        if (m_octaves < 1) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--noise4=")) {
+        std::string select = GetArg(argv[i]);
+        if (select == "branch") {
+          m_select = OSN_SELECT_BRANCH;
+        } else if (select == "table") {
+          m_select = OSN_SELECT_TABLE;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--threads=")) {
+        m_threads = stoi(GetArg(argv[i]));
+        if (m_threads < 1) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--partition=")) {
+        std::string partition = GetArg(argv[i]);
+        if (partition == "slabs") {
+          m_partition = PARTITION_SLABS;
+        } else if (partition == "tiles") {
+          m_partition = PARTITION_TILES;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--schedule=")) {
+        std::string schedule = GetArg(argv[i]);
+        if (schedule == "static") {
+          m_schedule = SCHEDULE_STATIC;
+        } else if (schedule == "dynamic") {
+          m_schedule = SCHEDULE_DYNAMIC;
+        } else if (schedule == "steal") {
+          m_schedule = SCHEDULE_STEAL;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--keyframes=")) {
+        m_keyframes = stoi(GetArg(argv[i]));
+      } else if (contains(argv[i], "--keyframe_error=")) {
+        m_keyframe_error = stod(GetArg(argv[i]));
+        if (!(m_keyframe_error > 0.)) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--tile=")) {
+        m_tile = stoi(GetArg(argv[i]));
+        if (m_tile < 1) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--interp=")) {
+        std::string interp = GetArg(argv[i]);
+        if (interp == "linear") {
+          m_interp = INTERP_LINEAR;
+        } else if (interp == "cubic") {
+          m_interp = INTERP_CUBIC;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--isa=")) {
+        std::string isa = GetArg(argv[i]);
+        m_isa_auto = isa == "auto";
+        if (isa == "scalar") {
+          m_isa = OSN_ISA_SCALAR;
+        } else if (isa == "avx2") {
+          m_isa = OSN_ISA_AVX2;
+        } else if (isa == "avx512") {
+          m_isa = OSN_ISA_AVX512;
+        } else if (!m_isa_auto) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--pages=")) {
+        std::string pages = GetArg(argv[i]);
+        if (pages == "small") {
+          m_pages = PAGES_SMALL;
+        } else if (pages == "transparent") {
+          m_pages = PAGES_TRANSPARENT;
+        } else if (pages == "huge") {
+          m_pages = PAGES_HUGE;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--chunk=")) {
+        m_chunk = stoi(GetArg(argv[i]));
+        if (m_chunk < 0) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--layout=")) {
+        std::string layout = GetArg(argv[i]);
+        if (layout == "linear") {
+          m_order = ORDER_LINEAR;
+        } else if (layout == "bricked") {
+          m_order = ORDER_BRICKED;
+        } else if (layout == "morton") {
+          m_order = ORDER_MORTON;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--brick=")) {
+        m_brick = stoi(GetArg(argv[i]));
+        if (m_brick < 2 || m_brick > 64 || (m_brick & (m_brick - 1)) != 0) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--iso=")) {
+        std::vector<std::string> iso = split(GetArg(argv[i]), ',');
+        m_iso.clear();
+        for (size_t v = 0; v < iso.size(); ++v)
+          m_iso.push_back(stod(iso[v]));
+      } else if (contains(argv[i], "--publish=")) {
+        std::string publish = GetArg(argv[i]);
+        if (publish == "all") {
+          m_publish = PUBLISH_ALL;
+        } else if (publish == "active") {
+          m_publish = PUBLISH_ACTIVE;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--numa=")) {
+        std::string numa = GetArg(argv[i]);
+        if (numa == "none") {
+          m_numa = NUMA_NONE;
+        } else if (numa == "first_touch") {
+          m_numa = NUMA_FIRST_TOUCH;
+        } else if (numa == "interleave") {
+          m_numa = NUMA_INTERLEAVE;
+        } else if (contains(numa, "bind:")) {
+          m_numa = NUMA_BIND;
+          m_numa_node = stoi(numa.substr(5));
+          if (m_numa_node < 0) {
+            Usage(argv[i]);
+          }
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--check=")) {
+        std::string check = GetArg(argv[i]);
+        if (check == "none") {
+          m_check = CHECK_NONE;
+        } else if (check == "checksum") {
+          m_check = CHECK_CHECKSUM;
+        } else if (check == "reference") {
+          m_check = CHECK_REFERENCE;
+        } else {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--tolerance=")) {
+        m_tolerance = stod(GetArg(argv[i]));
+        if (!(m_tolerance >= 0.)) {
+          Usage(argv[i]);
+        }
+      } else if (contains(argv[i], "--report=")) {
+        m_reports = split(GetArg(argv[i]), ',');
+        for (size_t r = 0; r < m_reports.size(); ++r) {
+          if (m_reports[r] != "precision" && m_reports[r] != "coherence" &&
+              m_reports[r] != "select" && m_reports[r] != "context" &&
+              m_reports[r] != "keyframe" && m_reports[r] != "threads" &&
+              m_reports[r] != "tile" && m_reports[r] != "memory" &&
+              m_reports[r] != "numa" && m_reports[r] != "layout" &&
+              m_reports[r] != "bricks") {
+            Usage(argv[i]);
+          }
+        }
       } else {
         Usage(argv[i]);
       }
     }
+    if (m_field_mode == FIELD_SEPARABLE && m_field != KERNEL_SINE) {
+      Usage("--field_mode=separable (sine field only)");
+    }
+    if (m_field_mode == FIELD_TILED && !GetFieldKernel(m_field).m_noise) {
+      Usage("--field_mode=tiled (noise fields only)");
+    }
+    if (m_numa == NUMA_BIND && m_numa_node >= NumaNodes()) {
+      Usage("--numa=bind:" + std::to_string(m_numa_node) + " (no such node)");
+    }
+    // keyframes are kept as whole fields
+    if (m_field_mode == FIELD_KEYFRAME && m_chunk > 0 && m_chunk < m_dims[2]) {
+      Usage("--chunk=" + std::to_string(m_chunk) + " (not in keyframe mode)");
+    }
+    // bricks are one block, and keyframes blend linear fields
+    if (m_order != ORDER_LINEAR &&
+        (m_field_mode == FIELD_KEYFRAME ||
+         (m_chunk > 0 && m_chunk < m_dims[2]))) {
+      Usage(std::string("--layout=") + FieldOrderName(m_order) +
+            " (not chunked or in keyframe mode)");
+    }
+    // the brick ranges are kept in the bricked orders only
+    if (m_publish == PUBLISH_ACTIVE &&
+        (m_order == ORDER_LINEAR || m_iso.empty())) {
+      Usage("--publish=active (bricked or morton layout, and --iso)");
+    }
+    // keyframes and tiles carry the scalars only
+    if (m_vector == VECTOR_GRADIENT &&
+        (m_field != KERNEL_SIMPLEX || m_field_mode == FIELD_KEYFRAME ||
+         m_field_mode == FIELD_TILED)) {
+      Usage("--vector=gradient (simplex field, not keyframed or tiled)");
+    }
+    if (m_isa_auto) {
+      m_isa = open_simplex_noise_best_isa();
+    } else if (!open_simplex_noise_isa_supported(m_isa)) {
+      Usage(std::string("--isa=") + open_simplex_noise_isa_name(m_isa) +
+            " (not supported by this CPU or build)");
+    }
+    // the ring must hold a whole interpolation stencil
+    if (m_keyframes < (m_interp == INTERP_CUBIC ? 4 : 2) ||
+        m_keyframes > KEYFRAME_MAX) {
+      Usage("--keyframes=" + std::to_string(m_keyframes));
+    }
   }
 
   std::string GetArg(const char *arg) {
@@ -84,9 +486,86 @@ struct Options {
               << ", " << m_spacing[2] << ")\n";
     std::cout << "time steps : " << m_time_steps << "\n";
     std::cout << "time delta : " << m_time_delta << "\n";
+    std::cout << "field      : " << FieldName() << "\n";
+    std::cout << "noise4     : "
+              << (m_select == OSN_SELECT_TABLE ? "table" : "branch") << "\n";
+    std::cout << "zonal      : "
+              << (m_zonal_mode == ZONAL_FUSED ? "fused" : "independent")
+              << "\n";
+    std::cout << "vector     : "
+              << (m_vector == VECTOR_GRADIENT ? "gradient" : "none") << "\n";
+    std::cout << "field mode : "
+              << (m_field_mode == FIELD_KEYFRAME
+                      ? "keyframe"
+                      : m_field_mode == FIELD_SEPARABLE
+                            ? "separable"
+                            : m_field_mode == FIELD_TILED ? "tiled"
+                                                          : "direct");
+    if (m_field_mode == FIELD_KEYFRAME) {
+      std::cout << " (" << m_keyframes << " keyframes or more, "
+                << (m_interp == INTERP_CUBIC ? "cubic" : "linear")
+                << ", max err " << m_keyframe_error << ")";
+    } else if (m_field_mode == FIELD_TILED) {
+      std::cout << " (" << m_tile << "^3 point tile)";
+    }
+    std::cout << "\n";
+    std::cout << "isa        : " << open_simplex_noise_isa_name(m_isa)
+              << (m_isa_auto ? " (auto)" : " (override)") << "\n";
+    std::cout << "pages      : " << PagePolicyName(m_pages) << "\n";
+    std::cout << "numa       : " << NumaPolicyName(m_numa);
+    if (m_numa == NUMA_BIND) {
+      std::cout << " (node " << m_numa_node << ")";
+    }
+    std::cout << "\n";
+    std::cout << "layout     : " << FieldOrderName(m_order);
+    if (m_order != ORDER_LINEAR) {
+      std::cout << " (" << m_brick << "^3 bricks)";
+    }
+    std::cout << "\n";
+    std::cout << "iso values :";
+    for (size_t v = 0; v < m_iso.size(); ++v)
+      std::cout << " " << m_iso[v];
+    std::cout << "\n";
+    std::cout << "publish    : "
+              << (m_publish == PUBLISH_ACTIVE ? "active bricks" : "all")
+              << "\n";
+    std::cout << "chunks     : ";
+    if (m_chunk > 0 && m_chunk < m_dims[2]) {
+      std::cout << m_chunk << " z planes each\n";
+    } else {
+      std::cout << "one\n";
+    }
+    std::cout << "check      : "
+              << (m_check == CHECK_REFERENCE
+                      ? "reference"
+                      : m_check == CHECK_CHECKSUM ? "checksum" : "none");
+    if (m_check == CHECK_REFERENCE) {
+      std::cout << " (tolerance " << m_tolerance << ")";
+    }
+    std::cout << "\n";
+    std::cout << "threads    : " << m_threads << " ("
+              << (m_partition == PARTITION_TILES ? "tiles" : "slabs") << ", "
+              << (m_schedule == SCHEDULE_STEAL
+                      ? "steal"
+                      : m_schedule == SCHEDULE_DYNAMIC ? "dynamic" : "static")
+              << ")\n";
+    std::cout << "reports    :";
+    for (size_t r = 0; r < m_reports.size(); ++r)
+      std::cout << " " << m_reports[r];
+    std::cout << "\n";
     std::cout << "================================\n";
   }
 
+  const char *FieldName() const { return GetFieldKernel(m_field).m_name; }
+
+  // log2 of m_brick
+  int BrickShift() const {
+    int shift = 0;
+    while ((1 << shift) < m_brick)
+      ++shift;
+    return shift;
+  }
+
   void Usage(std::string bad_arg) {
     std::cerr << "Invalid argument \"" << bad_arg << "\"\n";
     std::cout
@@ -95,7 +574,73 @@ struct Options {
            "--dims=32,32,32)\n"
         << "       --time_steps : number of time steps  (ex: --time_steps=10)\n"
         << "       --time_delta : amount of time to advance per time step  "
-           "(ex: --time_delta=0.5)\n";
+           "(ex: --time_delta=0.5)\n"
+        << "       --field      : ";
+    for (int k = 0; k < num_field_kernels; ++k) {
+      std::cout << field_kernels[k].m_name
+                << (k + 2 < num_field_kernels
+                        ? ", "
+                        : k + 1 < num_field_kernels ? " or " : "");
+    }
+    std::cout
+        << " (ex: --field=simplex)\n"
+        << "       --octaves    : octaves of the fbm and turbulence fields, "
+           "before grid culling (ex: --octaves=8)\n"
+        << "       --noise4     : branch or table (branchless) vertex "
+           "selection of the per-point and scalar-row 4D noise; vector "
+           "rows always run the table in lanes (ex: --noise4=table)\n"
+        << "       --zonal      : independent evaluation or fused average of "
+           "the corner nodes (ex: --zonal=fused)\n"
+        << "       --vector     : none or gradient, a nodal velocity field "
+           "from the simplex derivatives (ex: --vector=gradient)\n"
+        << "       --field_mode : direct, separable (sine only), keyframe "
+           "interpolated or tiled (noise only) time update "
+           "(ex: --field_mode=separable)\n"
+        << "       --tile       : points per axis of the replicated tile in "
+           "tiled mode (ex: --tile=16)\n"
+        << "       --keyframes  : keyframes per period to start from in keyframe "
+           "mode, doubled until within --keyframe_error (ex: "
+           "--keyframes=64)\n"
+        << "       --keyframe_error : largest interpolation error allowed, "
+           "finer keyframes cost memory (sine) or evaluations (others, "
+           "evaluated directly once keyframes would be closer than a step) "
+           "(ex: --keyframe_error=1e-2)\n"
+        << "       --interp     : linear or cubic keyframe interpolation "
+           "(ex: --interp=linear)\n"
+        << "       --isa        : auto (best the CPU supports), scalar, avx2 "
+           "or avx512 noise and field row kernels (ex: --isa=avx2)\n"
+        << "       --pages      : small, transparent or huge (hugetlb) "
+           "pages for the field buffers (ex: --pages=huge)\n"
+        << "       --chunk      : cell z planes per storage chunk, each "
+           "published as a domain, 0 for one block (ex: --chunk=256)\n"
+        << "       --layout     : linear, bricked (with per-brick value "
+           "ranges) or morton (bricked, Z-order inside, slower to read than "
+           "linear, see --report=layout) order of the published fields "
+           "(ex: --layout=bricked)\n"
+        << "       --brick      : points per edge of a brick, a power of two "
+           "(ex: --brick=16)\n"
+        << "       --iso        : iso-values the bricks are culled for, "
+           "bricked layouts (ex: --iso=-0.4,0.3)\n"
+        << "       --publish    : all, or active (the bricks holding an "
+           "iso-value, one domain each) (ex: --publish=active)\n"
+        << "       --numa       : none, first_touch (by the static slabs of "
+           "the threads), interleave or bind:NODE placement of the field "
+           "buffers (ex: --numa=interleave)\n"
+        << "       --check      : none, checksum (per step) or reference "
+           "(checksum and compare with a scalar direct run) "
+           "(ex: --check=reference)\n"
+        << "       --tolerance  : largest deviation from the reference that "
+           "passes, 0 for the same bits (ex: --tolerance=1e-12)\n"
+        << "       --threads    : worker threads for the field update "
+           "(ex: --threads=8)\n"
+        << "       --partition  : slabs (z planes) or tiles (y/z blocks) "
+           "(ex: --partition=tiles)\n"
+        << "       --schedule   : static, dynamic or steal (work-stealing) "
+           "distribution of the partition (ex: --schedule=steal)\n"
+        << "       --report     : diagnostics to print, any of precision, "
+           "coherence, select, context, tile, keyframe, threads, "
+           "memory, numa, layout, bricks "
+           "(ex: --report=precision,threads)\n";
     exit(0);
   }
 
@@ -148,31 +693,142 @@ struct SpatialDivision {
 struct DataSet {
   const int m_cell_dims[3];
   const int m_point_dims[3];
-  const int m_cell_size;
-  const int m_point_size;
+  const size_t m_cell_size;
+  const size_t m_point_size;
   double *m_nodal_scalars;
   double *m_zonal_scalars;
   double m_spacing[3];
   double m_origin[3];
   double m_time_step;
+  const FieldRows m_rows;
+  FieldRegistry m_fields;
+  int m_nodal_field;
+  int m_zonal_field;
+  int m_velocity_field;
+  int m_radial_field;
+  int m_cell_radial_field;
+  std::vector<std::vector<double>> m_brick_values; // PopulateBrick copies
 
-  DataSet(const Options &options, const SpatialDivision &div)
+  //
+  // Registers the fields of the options in m_fields, allocates them from
+  // arena in chunks of options.m_chunk cell planes, and writes them first
+  // on the engine's threads (see NumaPolicy).  Kernels write the fields a
+  // row at a time through NodalRow and the like, which the row adaptors
+  // commit with CommitNodalRow and CommitZonalRow, and read them through
+  // ReadNodalRow and ReadZonalRow, so any FieldOrder works;
+  // m_nodal_scalars and m_zonal_scalars are the whole fields when they are
+  // stored linear in one chunk, and NULL otherwise.  To publish another
+  // variable, register it here; PopulateNode picks it up.
+  //
+  DataSet(const Options &options, const SpatialDivision &div,
+          FieldArena &arena, FieldEngine &engine)
       : m_cell_dims{div.m_maxs[0] - div.m_mins[0] + 1,
                     div.m_maxs[1] - div.m_mins[1] + 1,
                     div.m_maxs[2] - div.m_mins[2] + 1},
         m_point_dims{m_cell_dims[0] + 1, m_cell_dims[1] + 1,
                      m_cell_dims[2] + 1},
-        m_cell_size(m_cell_dims[0] * m_cell_dims[1] * m_cell_dims[2]),
-        m_point_size(m_point_dims[0] * m_point_dims[1] * m_point_dims[2]),
+        m_cell_size(size_t(m_cell_dims[0]) * size_t(m_cell_dims[1]) *
+                    size_t(m_cell_dims[2])),
+        m_point_size(size_t(m_point_dims[0]) * size_t(m_point_dims[1]) *
+                     size_t(m_point_dims[2])),
         m_spacing{options.m_spacing[0], options.m_spacing[1],
                   options.m_spacing[2]},
         m_origin{0. + double(div.m_mins[0]) * m_spacing[0],
                  0. + double(div.m_mins[1]) * m_spacing[1],
-                 0. + double(div.m_mins[2]) * m_spacing[2]}
+                 0. + double(div.m_mins[2]) * m_spacing[2]},
+        m_rows(GetFieldRows(options.m_isa)),
+        m_fields(m_cell_dims, options.m_chunk, options.m_order,
+                 options.BrickShift())
 
   {
-    m_nodal_scalars = new double[m_point_size];
-    m_zonal_scalars = new double[m_cell_size];
+    const bool separable = options.m_field_mode == FIELD_SEPARABLE;
+    const bool velocity = options.m_vector == VECTOR_GRADIENT;
+    m_nodal_field = m_fields.Add("nodal_noise", FIELD_VERTEX, 1);
+    m_zonal_field = m_fields.Add("zonal_noise", FIELD_ELEMENT, 1);
+    m_velocity_field =
+        velocity ? m_fields.Add("velocity", FIELD_VERTEX, 3) : -1;
+    // sin and cos of the time invariant phase of the separable sine field
+    m_radial_field =
+        separable ? m_fields.Add("radial", FIELD_VERTEX, 2, false) : -1;
+    m_cell_radial_field =
+        separable ? m_fields.Add("cell_radial", FIELD_ELEMENT, 2, false) : -1;
+    // the linear copies of bricked fields, when whole meshes are published
+    m_fields.Allocate(arena, engine.NumThreads(),
+                      options.m_publish == PUBLISH_ALL);
+
+    m_nodal_scalars = m_fields.Values(m_nodal_field);
+    m_zonal_scalars = m_fields.Values(m_zonal_field);
+    if (options.m_numa == NUMA_NONE) {
+      for (int z = 0; z < m_point_dims[2]; ++z)
+        for (int y = 0; y < m_point_dims[1]; ++y)
+          InitRow(y, z);
+    } else {
+      engine.Place(m_point_dims, [this](int y, int z) { InitRow(y, z); });
+    }
+  }
+
+  // rows to write, until committed
+  double *NodalRow(int y, int z) const {
+    return m_fields.WriteRow(m_nodal_field, 0, y, z);
+  }
+  double *ZonalRow(int y, int z) const {
+    return m_fields.WriteRow(m_zonal_field, 0, y, z);
+  }
+  double *VelocityRow(int component, int y, int z) const {
+    return m_fields.WriteRow(m_velocity_field, component, y, z);
+  }
+
+  // rows to read, in place or gathered into scratch
+  const double *ReadNodalRow(int y, int z, double *scratch) const {
+    return m_fields.ReadRow(m_nodal_field, 0, y, z, scratch);
+  }
+  const double *ReadZonalRow(int y, int z, double *scratch) const {
+    return m_fields.ReadRow(m_zonal_field, 0, y, z, scratch);
+  }
+  // the calling thread's scratch rows, slots 0 to 3
+  double *ScratchRow(int slot) const { return m_fields.ScratchRow(slot); }
+  // component 0 holds sin(pi r), 1 cos(pi r)
+  double *RadialRow(int component, int y, int z) const {
+    return m_fields.Row(m_radial_field, component, y, z);
+  }
+  double *CellRadialRow(int component, int y, int z) const {
+    return m_fields.Row(m_cell_radial_field, component, y, z);
+  }
+
+  // first write of the point row (y, z) and the cell row there: zeros, and
+  // sin(pi r) and cos(pi r), the time invariant part of
+  // calculateVelocityMagnitude, for the separable field
+  void InitRow(int y, int z) {
+    std::fill(NodalRow(y, z), NodalRow(y, z) + m_point_dims[0], 0.);
+    if (m_velocity_field >= 0) {
+      for (int c = 0; c < 3; ++c)
+        std::fill(VelocityRow(c, y, z), VelocityRow(c, y, z) + m_point_dims[0],
+                  0.);
+    }
+    if (m_radial_field >= 0) {
+      double *radial_sin = RadialRow(0, y, z);
+      double *radial_cos = RadialRow(1, y, z);
+      for (int x = 0; x < m_point_dims[0]; ++x) {
+        const double phase = PI * sqrt(pow(x, 2) + pow(y, 2) + pow(z, 2));
+        radial_sin[x] = sin(phase);
+        radial_cos[x] = cos(phase);
+      }
+    }
+    CommitNodalRow(y, z);
+    if (y >= m_cell_dims[1] || z >= m_cell_dims[2])
+      return;
+    std::fill(ZonalRow(y, z), ZonalRow(y, z) + m_cell_dims[0], 0.);
+    if (m_cell_radial_field >= 0) {
+      double *radial_sin = CellRadialRow(0, y, z);
+      double *radial_cos = CellRadialRow(1, y, z);
+      for (int x = 0; x < m_cell_dims[0]; ++x) {
+        const double phase =
+            PI * sqrt(pow(x + .5, 2) + pow(y + .5, 2) + pow(z + .5, 2));
+        radial_sin[x] = sin(phase);
+        radial_cos[x] = cos(phase);
+      }
+    }
+    CommitZonalRow(y, z);
   }
 
   inline void GetCoord(const int &x, const int &y, const int &z,
@@ -181,30 +837,83 @@ struct DataSet {
     coord[1] = m_origin[1] + m_spacing[1] * double(y);
     coord[2] = m_origin[2] + m_spacing[2] * double(z);
   }
+  // least and greatest x + y + z over the local points, which bound the
+  // noise slices of a step
+  double CoordSumMin() const {
+    return std::min(CoordSum(0, 0, 0),
+                    CoordSum(m_point_dims[0] - 1, m_point_dims[1] - 1,
+                             m_point_dims[2] - 1));
+  }
+  double CoordSumMax() const {
+    return std::max(CoordSum(0, 0, 0),
+                    CoordSum(m_point_dims[0] - 1, m_point_dims[1] - 1,
+                             m_point_dims[2] - 1));
+  }
+  double CoordSum(int x, int y, int z) const {
+    return (m_origin[0] + m_spacing[0] * double(x)) +
+           (m_origin[1] + m_spacing[1] * double(y)) +
+           (m_origin[2] + m_spacing[2] * double(z));
+  }
   inline void SetPoint(const double &val, const int &x, const int &y,
                        const int &z) {
-    const int offset =
-        z * m_point_dims[0] * m_point_dims[1] + y * m_point_dims[0] + x;
-    m_nodal_scalars[offset] = val;
+    m_fields.At(m_nodal_field, 0, x, y, z) = val;
   }
 
   inline void SetCell(const double &val, const int &x, const int &y,
                       const int &z) {
-    const int offset =
-        z * m_cell_dims[0] * m_cell_dims[1] + y * m_cell_dims[0] + x;
-    m_zonal_scalars[offset] = val;
+    m_fields.At(m_zonal_field, 0, x, y, z) = val;
   }
 
-  void PopulateNode(conduit::Node &node) {
+  // after the nodal and velocity rows (y, z) are written
+  void CommitNodalRow(int y, int z) const {
+    m_fields.CommitRow(FIELD_VERTEX, y, z);
+  }
+  // after zonal row (y, z) is written
+  void CommitZonalRow(int y, int z) const {
+    m_fields.CommitRow(FIELD_ELEMENT, y, z);
+  }
+
+  // zonal row (y, z) as the mean of each cell's 8 corner nodes, committed
+  void AverageCellRow(const int y, const int z) {
+    m_rows.m_average(ReadNodalRow(y, z, m_fields.ScratchRow(0)),
+                     ReadNodalRow(y + 1, z, m_fields.ScratchRow(1)),
+                     ReadNodalRow(y, z + 1, m_fields.ScratchRow(2)),
+                     ReadNodalRow(y + 1, z + 1, m_fields.ScratchRow(3)),
+                     m_cell_dims[0], ZonalRow(y, z));
+    CommitZonalRow(y, z);
+  }
+
+  //
+  // Bricked orders: brings the linear copies PopulateNode publishes up to
+  // date, a row of bricks at a time on the engine's threads.  Call before
+  // the mesh is populated and before each publish of it; a no-op for
+  // linear fields.
+  //
+  void Linearize(FieldEngine &engine) {
+    if (m_fields.m_order == ORDER_LINEAR)
+      return;
+    const int *bricks = m_fields.m_point_bricks.m_bricks;
+    engine.Place(bricks, [this](int by, int bz) {
+      m_fields.LinearizeBricks(by, bz);
+    });
+  }
+
+  //
+  // Fills node with chunk of the mesh, its fields zero-copy from the
+  // registry.  Without chunks the one chunk is the whole data set.
+  //
+  void PopulateNode(conduit::Node &node, int chunk = 0) {
+    const int first_plane = chunk * m_fields.m_chunk_planes;
     node["coordsets/coords/type"] = "uniform";
 
     node["coordsets/coords/dims/i"] = m_point_dims[0];
     node["coordsets/coords/dims/j"] = m_point_dims[1];
-    node["coordsets/coords/dims/k"] = m_point_dims[2];
+    node["coordsets/coords/dims/k"] = m_fields.ChunkCells(chunk) + 1;
 
     node["coordsets/coords/origin/x"] = m_origin[0];
     node["coordsets/coords/origin/y"] = m_origin[1];
-    node["coordsets/coords/origin/z"] = m_origin[2];
+    node["coordsets/coords/origin/z"] =
+        m_origin[2] + m_spacing[2] * double(first_plane);
 
     node["coordsets/coords/spacing/dx"] = m_spacing[0];
     node["coordsets/coords/spacing/dy"] = m_spacing[1];
@@ -213,15 +922,91 @@ struct DataSet {
     node["topologies/mesh/type"] = "uniform";
     node["topologies/mesh/coordset"] = "coords";
 
-    node["fields/nodal_noise/association"] = "vertex";
-    node["fields/nodal_noise/type"] = "scalar";
-    node["fields/nodal_noise/topology"] = "mesh";
-    node["fields/nodal_noise/values"].set_external(m_nodal_scalars);
+    // every published field
+    for (size_t f = 0; f < m_fields.m_fields.size(); ++f) {
+      const FieldEntry &field = m_fields.m_fields[f];
+      if (!field.m_publish)
+        continue;
+      conduit::Node &entry = node["fields/" + field.m_name];
+      entry["association"] =
+          field.m_association == FIELD_VERTEX ? "vertex" : "element";
+      entry["type"] = field.m_components == 1 ? "scalar" : "vector";
+      entry["topology"] = "mesh";
+      const size_t size = m_fields.ChunkSize(field, chunk);
+      if (field.m_components == 1) {
+        entry["values"].set_external(m_fields.Chunk(int(f), 0, chunk), size);
+      } else {
+        for (int c = 0; c < field.m_components; ++c)
+          entry["values/" + std::string(FieldRegistry::ComponentName(c))]
+              .set_external(m_fields.Chunk(int(f), c, chunk), size);
+      }
+    }
+  }
+
+  //
+  // Fills node with cell brick of a bricked data set, a mesh of its cells
+  // and their corner points, the fields copied out of the bricks into a
+  // buffer of the brick's own, so only the bricks published are converted.
+  //
+  void PopulateBrick(conduit::Node &node, size_t brick) {
+    int cells[2][3], points[2][3];
+    m_fields.BrickCells(brick, cells[0], cells[1]);
+    size_t size[2] = {1, 1}; // points, cells
+    for (int a = 0; a < 3; ++a) {
+      points[0][a] = cells[0][a];
+      points[1][a] = cells[1][a] + 1;
+      size[0] *= size_t(points[1][a] - points[0][a]);
+      size[1] *= size_t(cells[1][a] - cells[0][a]);
+    }
+    node["coordsets/coords/type"] = "uniform";
+    node["coordsets/coords/dims/i"] = points[1][0] - points[0][0];
+    node["coordsets/coords/dims/j"] = points[1][1] - points[0][1];
+    node["coordsets/coords/dims/k"] = points[1][2] - points[0][2];
+    node["coordsets/coords/origin/x"] =
+        m_origin[0] + m_spacing[0] * double(points[0][0]);
+    node["coordsets/coords/origin/y"] =
+        m_origin[1] + m_spacing[1] * double(points[0][1]);
+    node["coordsets/coords/origin/z"] =
+        m_origin[2] + m_spacing[2] * double(points[0][2]);
+    node["coordsets/coords/spacing/dx"] = m_spacing[0];
+    node["coordsets/coords/spacing/dy"] = m_spacing[1];
+    node["coordsets/coords/spacing/dz"] = m_spacing[2];
+    node["topologies/mesh/type"] = "uniform";
+    node["topologies/mesh/coordset"] = "coords";
 
-    node["fields/zonal_noise/association"] = "element";
-    node["fields/zonal_noise/type"] = "scalar";
-    node["fields/zonal_noise/topology"] = "mesh";
-    node["fields/zonal_noise/values"].set_external(m_zonal_scalars);
+    size_t total = 0;
+    for (size_t f = 0; f < m_fields.m_fields.size(); ++f) {
+      const FieldEntry &field = m_fields.m_fields[f];
+      if (field.m_publish)
+        total += size_t(field.m_components) *
+                 size[field.m_association == FIELD_VERTEX ? 0 : 1];
+    }
+    m_brick_values.resize(m_fields.BrickCount());
+    std::vector<double> &values = m_brick_values[brick];
+    values.resize(total);
+    double *next = values.data();
+    for (size_t f = 0; f < m_fields.m_fields.size(); ++f) {
+      const FieldEntry &field = m_fields.m_fields[f];
+      if (!field.m_publish)
+        continue;
+      const int vertex = field.m_association == FIELD_VERTEX ? 0 : 1;
+      const int(&box)[2][3] = vertex == 0 ? points : cells;
+      conduit::Node &entry = node["fields/" + field.m_name];
+      entry["association"] = vertex == 0 ? "vertex" : "element";
+      entry["type"] = field.m_components == 1 ? "scalar" : "vector";
+      entry["topology"] = "mesh";
+      for (int c = 0; c < field.m_components; ++c) {
+        m_fields.Bricks(field).Extract(field.m_values[c], box[0], box[1],
+                                       next);
+        if (field.m_components == 1) {
+          entry["values"].set_external(next, size[vertex]);
+        } else {
+          entry["values/" + std::string(FieldRegistry::ComponentName(c))]
+              .set_external(next, size[vertex]);
+        }
+        next += size[vertex];
+      }
+    }
   }
 
   void Print() {
@@ -234,24 +1019,437 @@ struct DataSet {
               << m_origin[2] + m_spacing[2] * m_cell_dims[2] << ")\n ";
   }
 
-  ~DataSet() {
-    if (m_nodal_scalars)
-      delete[] m_nodal_scalars;
-    if (m_zonal_scalars)
-      delete[] m_zonal_scalars;
-  }
-
 private:
   DataSet()
       : m_cell_dims{1, 1, 1}, m_point_dims{2, 2, 2}, m_cell_size(1),
-        m_point_size(8) {
+        m_point_size(8), m_rows(GetFieldRows(OSN_ISA_SCALAR)),
+        m_fields(m_cell_dims, 0), m_nodal_field(-1), m_zonal_field(-1),
+        m_velocity_field(-1), m_radial_field(-1), m_cell_radial_field(-1) {
     m_nodal_scalars = NULL;
     m_zonal_scalars = NULL;
   };
 };
 
+//
+// Field kernels.  Nodes(y, z) fills the nodal row (y, z); Cells(y, z) fills
+// the zonal row (y, z) with an evaluation of its own.
+//
+
+// calculateVelocityMagnitude at every point; zonal values at cell centers
+struct DirectRowKernel {
+  DataSet &m_data_set;
+  const double m_time;
+
+  DirectRowKernel(DataSet &data_set, double time)
+      : m_data_set(data_set), m_time(time) {}
+
+  void Nodes(int y, int z) const {
+    double *nodal = m_data_set.NodalRow(y, z);
+    for (int x = 0; x < m_data_set.m_point_dims[0]; ++x) {
+      nodal[x] = calculateVelocityMagnitude(x, y, z, m_time);
+    }
+  }
+
+  void Cells(int y, int z) const {
+    double *zonal = m_data_set.ZonalRow(y, z);
+    for (int x = 0; x < m_data_set.m_cell_dims[0]; ++x) {
+      zonal[x] = calculateVelocityMagnitude(x + .5, y + .5, z + .5, m_time);
+    }
+  }
+};
+
+// sin(pi r + t) from the precomputed radial terms, two multiply-adds per
+// value
+struct SeparableRowKernel {
+  DataSet &m_data_set;
+  const double m_cos_t;
+  const double m_sin_t;
+
+  SeparableRowKernel(DataSet &data_set, double time)
+      : m_data_set(data_set), m_cos_t(cos(time)), m_sin_t(sin(time)) {}
+
+  void Nodes(int y, int z) const {
+    const DataSet &ds = m_data_set;
+    ds.m_rows.m_separable(ds.RadialRow(0, y, z), ds.RadialRow(1, y, z),
+                          m_cos_t, m_sin_t, ds.m_point_dims[0],
+                          ds.NodalRow(y, z));
+  }
+
+  void Cells(int y, int z) const {
+    const DataSet &ds = m_data_set;
+    ds.m_rows.m_separable(ds.CellRadialRow(0, y, z),
+                          ds.CellRadialRow(1, y, z), m_cos_t, m_sin_t,
+                          ds.m_cell_dims[0], ds.ZonalRow(y, z));
+  }
+};
+
+// 4D simplex noise at (x, y, z, time), a row at a time; zonal values use a
+// second noise context at the cell's lower corner.  Rows go through one
+// w = time slice of each context, built with the kernel.  With a velocity
+// field the nodes use the gradient form instead, which yields the value and
+// the velocity from one evaluation per point.
+struct SimplexRowKernel {
+  DataSet &m_data_set;
+  const Noise<4, double> m_nodal;
+  const NoiseSlice<double> m_nodal_slice;
+  const NoiseSlice<double> m_zonal_slice;
+  const double m_time;
+  std::vector<double> m_xcoords;
+
+  SimplexRowKernel(DataSet &data_set, const struct osn_context *nodal_ctx,
+                   const struct osn_context *zonal_ctx, double time)
+      : m_data_set(data_set), m_nodal(nodal_ctx),
+        m_nodal_slice(nodal_ctx, time, data_set.CoordSumMin(),
+                      data_set.CoordSumMax()),
+        m_zonal_slice(zonal_ctx, time, data_set.CoordSumMin(),
+                      data_set.CoordSumMax()),
+        m_time(time), m_xcoords(data_set.m_point_dims[0]) {
+    double coord[3];
+    for (int x = 0; x < data_set.m_point_dims[0]; ++x) {
+      data_set.GetCoord(x, 0, 0, coord);
+      m_xcoords[x] = coord[0];
+    }
+  }
+
+  void Nodes(int y, int z) const {
+    DataSet &ds = m_data_set;
+    double coord[3];
+    ds.GetCoord(0, y, z, coord);
+    double *nodal = ds.NodalRow(y, z);
+    if (ds.m_velocity_field >= 0) {
+      double *velocity[3] = {ds.VelocityRow(0, y, z), ds.VelocityRow(1, y, z),
+                             ds.VelocityRow(2, y, z)};
+      double grad[4];
+      for (int x = 0; x < ds.m_point_dims[0]; ++x) {
+        nodal[x] =
+            m_nodal.Grad(m_xcoords[x], coord[1], coord[2], m_time, grad);
+        velocity[0][x] = grad[0];
+        velocity[1][x] = grad[1];
+        velocity[2][x] = grad[2];
+      }
+      return;
+    }
+    m_nodal_slice.Row(&m_xcoords[0], ds.m_point_dims[0], coord[1], coord[2],
+                      nodal);
+  }
+
+  void Cells(int y, int z) const {
+    DataSet &ds = m_data_set;
+    double coord[3];
+    ds.GetCoord(0, y, z, coord);
+    m_zonal_slice.Row(&m_xcoords[0], ds.m_cell_dims[0], coord[1], coord[2],
+                      ds.ZonalRow(y, z));
+  }
+};
+
+// fractal sum of simplex octaves at (x, y, z, time), the octaves finer than
+// the coarsest grid spacing dropped once up front; zonal values use the
+// zonal context at the cell's lower corner, as in SimplexRowKernel, and each
+// octave goes through a slice of its own
+struct FbmRowKernel {
+  DataSet &m_data_set;
+  const Fbm<double> m_nodal;
+  const Fbm<double> m_zonal;
+  std::vector<double> m_xcoords;
+
+  FbmRowKernel(DataSet &data_set, const struct osn_context *nodal_ctx,
+               const struct osn_context *zonal_ctx, const struct osn_fbm &fbm,
+               int octaves, double time)
+      : m_data_set(data_set),
+        m_nodal(nodal_ctx, fbm, octaves, time, data_set.CoordSumMin(),
+                data_set.CoordSumMax()),
+        m_zonal(zonal_ctx, fbm, octaves, time, data_set.CoordSumMin(),
+                data_set.CoordSumMax()),
+        m_xcoords(data_set.m_point_dims[0]) {
+    double coord[3];
+    for (int x = 0; x < data_set.m_point_dims[0]; ++x) {
+      data_set.GetCoord(x, 0, 0, coord);
+      m_xcoords[x] = coord[0];
+    }
+  }
+
+  void Nodes(int y, int z) const {
+    DataSet &ds = m_data_set;
+    double coord[3];
+    ds.GetCoord(0, y, z, coord);
+    m_nodal.Row(&m_xcoords[0], ds.m_point_dims[0], coord[1], coord[2],
+                ds.NodalRow(y, z));
+  }
+
+  void Cells(int y, int z) const {
+    DataSet &ds = m_data_set;
+    double coord[3];
+    ds.GetCoord(0, y, z, coord);
+    m_zonal.Row(&m_xcoords[0], ds.m_cell_dims[0], coord[1], coord[2],
+                ds.ZonalRow(y, z));
+  }
+};
+
+// copies of the nodal and zonal tiles, built for the step beforehand; the
+// zonal tile may be NULL when only fused zonal values are needed
+struct TiledRowKernel {
+  DataSet &m_data_set;
+  const NoiseTile &m_nodal_tile;
+  const NoiseTile *m_zonal_tile;
+
+  TiledRowKernel(DataSet &data_set, const NoiseTile &nodal_tile,
+                 const NoiseTile *zonal_tile)
+      : m_data_set(data_set), m_nodal_tile(nodal_tile),
+        m_zonal_tile(zonal_tile) {}
+
+  void Nodes(int y, int z) const {
+    DataSet &ds = m_data_set;
+    m_nodal_tile.Row(y, z, ds.m_point_dims[0], ds.NodalRow(y, z));
+  }
+
+  void Cells(int y, int z) const {
+    DataSet &ds = m_data_set;
+    m_zonal_tile->Row(y, z, ds.m_cell_dims[0], ds.ZonalRow(y, z));
+  }
+};
+
+// the tiled field straight from its definition, for --check=reference:
+// every point of the grid evaluates its terms rather than copy a tile
+template <typename Row> struct DirectTileRowKernel {
+  DataSet &m_data_set;
+  const NoiseTile &m_nodal_tile;
+  const NoiseTile &m_zonal_tile;
+  const Row m_nodal;
+  const Row m_zonal;
+
+  DirectTileRowKernel(DataSet &data_set, const NoiseTile &nodal_tile,
+                      const NoiseTile &zonal_tile, const Row &nodal,
+                      const Row &zonal)
+      : m_data_set(data_set), m_nodal_tile(nodal_tile),
+        m_zonal_tile(zonal_tile), m_nodal(nodal), m_zonal(zonal) {}
+
+  void Nodes(int y, int z) const {
+    DataSet &ds = m_data_set;
+    m_nodal_tile.DirectRow(ds.m_origin, y, z, ds.m_point_dims[0], m_nodal,
+                           ds.NodalRow(y, z));
+  }
+
+  void Cells(int y, int z) const {
+    DataSet &ds = m_data_set;
+    m_zonal_tile.DirectRow(ds.m_origin, y, z, ds.m_cell_dims[0], m_zonal,
+                           ds.ZonalRow(y, z));
+  }
+};
+
+// rows of 4D noise at w, and of its fbm, as NoiseTile takes them
+struct NoiseTileRow {
+  const struct osn_context *m_ctx;
+  double m_w;
+
+  void operator()(const double *x, int n, double y, double z,
+                  double *out) const {
+    open_simplex_noise4_row(m_ctx, x, n, y, z, m_w, out);
+  }
+};
+
+struct FbmTileRow {
+  const struct osn_context *m_ctx;
+  const struct osn_fbm *m_fbm;
+  int m_octaves;
+  double m_w;
+
+  void operator()(const double *x, int n, double y, double z,
+                  double *out) const {
+    open_simplex_fbm4_row(m_ctx, m_fbm, m_octaves, x, n, y, z, m_w, out);
+  }
+};
+
+//
+// Row adaptors for FieldEngine, one per ZonalMode.
+//
+
+// nodal row, then the zonal row at the same (y, z) from the kernel's own
+// zonal evaluation
+template <typename Kernel> struct IndependentZonalRows {
+  const Kernel &m_kernel;
+  const DataSet &m_data_set;
+
+  IndependentZonalRows(const Kernel &kernel, const DataSet &data_set)
+      : m_kernel(kernel), m_data_set(data_set) {}
+
+  void operator()(int y, int z) const {
+    m_kernel.Nodes(y, z);
+    m_data_set.CommitNodalRow(y, z);
+    if (y < m_data_set.m_cell_dims[1] && z < m_data_set.m_cell_dims[2]) {
+      m_kernel.Cells(y, z);
+      m_data_set.CommitZonalRow(y, z);
+    }
+  }
+};
+
+// nodal row, then every zonal row whose four corner rows are now complete,
+// averaged from its corners while they are still in cache.  m_ready counts
+// the finished corner rows of each cell row; whichever thread finishes the
+// fourth one does the averaging, so any partition and schedule works.
+template <typename Kernel> struct FusedZonalRows {
+  const Kernel &m_kernel;
+  DataSet &m_data_set;
+  std::vector<std::atomic<int>> &m_ready;
+
+  FusedZonalRows(const Kernel &kernel, DataSet &data_set,
+                 std::vector<std::atomic<int>> &ready)
+      : m_kernel(kernel), m_data_set(data_set), m_ready(ready) {}
+
+  void operator()(int y, int z) const {
+    m_kernel.Nodes(y, z);
+    m_data_set.CommitNodalRow(y, z);
+    const int *cell_dims = m_data_set.m_cell_dims;
+    for (int cz = z - 1; cz <= z; ++cz)
+      for (int cy = y - 1; cy <= y; ++cy) {
+        if (cy < 0 || cz < 0 || cy >= cell_dims[1] || cz >= cell_dims[2])
+          continue;
+        const size_t row = size_t(cz) * size_t(cell_dims[1]) + size_t(cy);
+        if (m_ready[row].fetch_add(1, std::memory_order_acq_rel) == 3) {
+          m_data_set.AverageCellRow(cy, cz);
+        }
+      }
+  }
+};
+
+template <typename Kernel>
+void UpdateFields(FieldEngine &engine, DataSet &data_set, const Kernel &kernel,
+                  const ZonalMode zonal_mode,
+                  std::vector<std::atomic<int>> &ready) {
+  data_set.m_fields.ResetRanges();
+  if (zonal_mode == ZONAL_FUSED) {
+    for (size_t i = 0; i < ready.size(); ++i)
+      ready[i].store(0, std::memory_order_relaxed);
+    engine.Update(data_set.m_point_dims,
+                  FusedZonalRows<Kernel>(kernel, data_set, ready));
+  } else {
+    engine.Update(data_set.m_point_dims,
+                  IndependentZonalRows<Kernel>(kernel, data_set));
+  }
+}
+
+// UpdateFields as a visitor, for VisitFieldKernel
+struct FieldUpdate {
+  FieldEngine &m_engine;
+  DataSet &m_data_set;
+  const ZonalMode m_zonal_mode;
+  std::vector<std::atomic<int>> &m_ready;
+
+  template <typename Kernel> void operator()(const Kernel &kernel) const {
+    UpdateFields(m_engine, m_data_set, kernel, m_zonal_mode, m_ready);
+  }
+};
+
+//
+// Passes the tile rows of the selected noise field at time, for the nodal
+// and the zonal context, to visit(nodal, zonal).
+//
+template <typename Visit>
+void VisitTileRows(const Options &options,
+                   const struct osn_context *nodal_ctx,
+                   const struct osn_context *zonal_ctx,
+                   const struct osn_fbm &fbm, int fbm_octaves, double time,
+                   const Visit &visit) {
+  if (options.m_field == KERNEL_SIMPLEX) {
+    const NoiseTileRow nodal = {nodal_ctx, time}, zonal = {zonal_ctx, time};
+    visit(nodal, zonal);
+  } else {
+    const FbmTileRow nodal = {nodal_ctx, &fbm, fbm_octaves, time};
+    const FbmTileRow zonal = {zonal_ctx, &fbm, fbm_octaves, time};
+    visit(nodal, zonal);
+  }
+}
+
+// both tiles for the step, then their copies, for VisitTileRows; the zonal
+// tile is only built when the zonal values are evaluated independently
+struct TileUpdate {
+  const FieldUpdate &m_update;
+  NoiseTile &m_nodal_tile;
+  NoiseTile &m_zonal_tile;
+
+  template <typename Row>
+  void operator()(const Row &nodal, const Row &zonal) const {
+    const bool independent = m_update.m_zonal_mode == ZONAL_INDEPENDENT;
+    const double *origin = m_update.m_data_set.m_origin;
+    m_nodal_tile.Build(m_update.m_engine, origin, nodal);
+    if (independent)
+      m_zonal_tile.Build(m_update.m_engine, origin, zonal);
+    m_update(TiledRowKernel(m_update.m_data_set, m_nodal_tile,
+                            independent ? &m_zonal_tile : NULL));
+  }
+};
+
+// the same tiled field from its definition, for VisitTileRows
+struct DirectTileUpdate {
+  const FieldUpdate &m_update;
+  const NoiseTile &m_nodal_tile;
+  const NoiseTile &m_zonal_tile;
+
+  template <typename Row>
+  void operator()(const Row &nodal, const Row &zonal) const {
+    m_update(DirectTileRowKernel<Row>(m_update.m_data_set, m_nodal_tile,
+                                      m_zonal_tile, nodal, zonal));
+  }
+};
+
+//
+// Builds the row kernel of the selected field at time and passes it to
+// visit(kernel).  The field is resolved here, once per step; each branch
+// instantiates visit for its concrete kernel type, so the row loops call
+// the kernel directly rather than through a pointer.
+//
+template <typename Visit>
+void VisitFieldKernel(const Options &options, DataSet &data_set,
+                      const struct osn_context *nodal_ctx,
+                      const struct osn_context *zonal_ctx,
+                      const struct osn_fbm &fbm, int fbm_octaves, double time,
+                      const Visit &visit) {
+  switch (options.m_field) {
+  case KERNEL_SIMPLEX:
+    visit(SimplexRowKernel(data_set, nodal_ctx, zonal_ctx, time));
+    break;
+  case KERNEL_FBM:
+  case KERNEL_TURBULENCE:
+    visit(FbmRowKernel(data_set, nodal_ctx, zonal_ctx, fbm, fbm_octaves,
+                       time));
+    break;
+  case KERNEL_SINE:
+    if (options.m_field_mode == FIELD_SEPARABLE) {
+      visit(SeparableRowKernel(data_set, time));
+    } else {
+      visit(DirectRowKernel(data_set, time));
+    }
+    break;
+  }
+}
+
 void Init(SpatialDivision &div, const Options &options) { options.Print(); }
 
+void RunReports(const Options &options, const DataSet &data_set) {
+  const int64_t seed = 77374;
+  struct osn_context *ctx;
+  open_simplex_noise(seed, &ctx);
+  for (size_t r = 0; r < options.m_reports.size(); ++r) {
+    if (options.m_reports[r] == "precision") {
+      ReportPrecision(ctx, data_set.m_point_dims, data_set.m_origin,
+                      data_set.m_spacing, 0.);
+    } else if (options.m_reports[r] == "context") {
+      ReportContext(options.m_threads);
+    } else if (options.m_reports[r] == "coherence") {
+      ReportCoherence(ctx, data_set.m_point_dims, data_set.m_origin, 0.);
+    } else if (options.m_reports[r] == "select") {
+      ReportSelect(ctx, data_set.m_point_dims, data_set.m_origin,
+                   data_set.m_spacing, 0.);
+    } else if (options.m_reports[r] == "tile") {
+      ReportTile(ctx, data_set.m_point_dims, data_set.m_origin,
+                 data_set.m_spacing, 0., options.m_tile);
+    } else if (options.m_reports[r] == "layout") {
+      ReportLayout(ctx, data_set.m_point_dims, data_set.m_origin,
+                   data_set.m_spacing, 0., options.BrickShift());
+    }
+  }
+  open_simplex_noise_free(ctx);
+}
+
 int main(int argc, char **argv) {
   std::cout << "We be simulatin' all day!!!" << std::endl;
 
@@ -268,7 +1466,41 @@ int main(int argc, char **argv) {
   div.m_maxs[2] = options.m_dims[2] - 1;
 
   Init(div, options);
-  DataSet data_set(options, div);
+  open_simplex_noise_set_isa(options.m_isa);
+  // field buffers, reused by any data set made after one is freed
+  FieldArena arena(options.m_pages, options.m_numa, options.m_numa_node);
+  FieldEngine engine(options.m_threads, options.m_partition,
+                     options.m_schedule);
+  const long setup_start_faults = PageFaults();
+  DataSet data_set(options, div, arena, engine);
+  const long setup_faults = PageFaults() - setup_start_faults;
+  RunReports(options, data_set);
+  std::vector<std::atomic<int>> cell_rows_ready(
+      size_t(data_set.m_cell_dims[1]) * size_t(data_set.m_cell_dims[2]));
+
+  struct osn_context *ctx_zonal;
+  struct osn_context *ctx_nodal;
+  open_simplex_noise(77374, &ctx_nodal);
+  open_simplex_noise(59142, &ctx_zonal);
+  open_simplex_noise4_select(ctx_nodal, options.m_select);
+  open_simplex_noise4_select(ctx_zonal, options.m_select);
+
+  // fractal fields: features of the first octave span about four units,
+  // and only the octaves the grid can resolve are evaluated
+  struct osn_fbm fbm;
+  fbm.octaves = options.m_octaves;
+  fbm.frequency = 0.25;
+  fbm.lacunarity = 2.;
+  fbm.gain = 0.5;
+  fbm.turbulence = options.m_field == KERNEL_TURBULENCE;
+  const double coarsest = std::max(
+      data_set.m_spacing[0], std::max(data_set.m_spacing[1],
+                                      data_set.m_spacing[2]));
+  const int fbm_octaves = open_simplex_fbm_octaves(&fbm, coarsest);
+  if (options.m_field == KERNEL_FBM || options.m_field == KERNEL_TURBULENCE) {
+    std::cout << "octaves    : " << fbm_octaves << " of " << fbm.octaves
+              << " above the grid Nyquist limit\n";
+  }
 
   double spatial_extents[3];
   spatial_extents[0] = options.m_spacing[0] * options.m_dims[0] + 1;
@@ -285,11 +1517,32 @@ int main(int argc, char **argv) {
   ascent.open(ascent_opts);
 
   conduit::Node mesh_data;
-  mesh_data["state/time"].set_external(&time);
-  mesh_data["state/cycle"].set_external(&time);
-  mesh_data["state/domain_id"] = 0;
-  mesh_data["state/info"] = "Pseudocolor of random math function";
-  data_set.PopulateNode(mesh_data);
+  // one domain per storage chunk
+  auto populate = [&](conduit::Node &domain, int chunk) {
+    domain["state/time"].set_external(&time);
+    domain["state/cycle"].set_external(&time);
+    domain["state/domain_id"] = chunk;
+    domain["state/info"] = GetFieldKernel(options.m_field).m_info;
+    data_set.PopulateNode(domain, chunk);
+  };
+  // or one per active brick, made each step
+  auto populate_brick = [&](conduit::Node &domain, size_t brick) {
+    domain["state/time"].set_external(&time);
+    domain["state/cycle"].set_external(&time);
+    domain["state/domain_id"] = int(brick);
+    domain["state/info"] = GetFieldKernel(options.m_field).m_info;
+    data_set.PopulateBrick(domain, brick);
+  };
+  // the whole mesh, populated once before its first publish (the active
+  // bricks are known after each update)
+  auto populate_mesh = [&]() {
+    if (data_set.m_fields.m_chunks == 1) {
+      populate(mesh_data, 0);
+    } else {
+      for (int chunk = 0; chunk < data_set.m_fields.m_chunks; ++chunk)
+        populate(mesh_data.append(), chunk);
+    }
+  };
 
   /*conduit::Node pipelines;
   // pipeline 1
@@ -320,22 +1573,201 @@ int main(int argc, char **argv) {
   conduit::Node &reset_action = reset.append();
   reset_action["action"] = "reset";
 
+  // exact field at time at
+  const FieldUpdate update = {engine, data_set, options.m_zonal_mode,
+                              cell_rows_ready};
+  auto evaluate = [&](double at) {
+    VisitFieldKernel(options, data_set, ctx_nodal, ctx_zonal, fbm,
+                     fbm_octaves, at, update);
+  };
+
+  // tiled field at time at
+  int tile_dims[3];
+  for (int a = 0; a < 3; ++a)
+    tile_dims[a] = std::min(options.m_tile, data_set.m_point_dims[a]);
+  NoiseTile nodal_tile(tile_dims, data_set.m_spacing, 77374, 0.25);
+  NoiseTile zonal_tile(tile_dims, data_set.m_spacing, 59142, 0.25);
+  auto tiled = [&](double at) {
+    VisitTileRows(options, ctx_nodal, ctx_zonal, fbm, fbm_octaves, at,
+                  TileUpdate{update, nodal_tile, zonal_tile});
+  };
+
+  const bool periodic = options.m_field == KERNEL_SINE;
+  const double period =
+      periodic ? 2. * std::acos(-1.) : PERIOD * options.m_time_delta;
+  KeyframeCache keyframes(options.m_interp, data_set.m_point_size,
+                          data_set.m_cell_size);
+  if (options.m_field_mode == FIELD_KEYFRAME) {
+    // a sliding ring evaluates one keyframe per spacing passed, so it only
+    // pays while the spacing stays above the time step; any finer and the
+    // field is evaluated directly
+    const long max_keyframes =
+        periodic ? KEYFRAME_MAX
+                 : std::min(long(KEYFRAME_MAX),
+                            long(std::ceil(period / options.m_time_delta)) - 1);
+    const long count =
+        options.m_keyframes > max_keyframes
+            ? 0
+            : keyframes.Calibrate(arena, period, periodic, options.m_keyframes,
+                                  max_keyframes, KEYFRAME_INTERVALS,
+                                  options.m_keyframe_error, evaluate,
+                                  data_set.m_nodal_scalars,
+                                  data_set.m_zonal_scalars);
+    if (count == 0 && !periodic) {
+      std::cerr << "warning: keyframes within --keyframe_error="
+                << options.m_keyframe_error << " would be closer than the "
+                << "time step, using --field_mode=direct\n";
+      options.m_field_mode = FIELD_DIRECT;
+    } else if (count == 0) {
+      std::cerr << "--keyframe_error=" << options.m_keyframe_error
+                << ": " << KEYFRAME_MAX << " keyframes still deviate by "
+                << keyframes.m_calibration << "\n";
+      open_simplex_noise_free(ctx_nodal);
+      open_simplex_noise_free(ctx_zonal);
+      ascent.close();
+      return 1;
+    } else {
+      std::cout << "keyframes  : " << count << " per period, spacing "
+                << keyframes.m_spacing << ", max err "
+                << keyframes.m_calibration << " midway\n";
+    }
+  }
+  const bool compare_keyframes =
+      options.m_field_mode == FIELD_KEYFRAME &&
+      std::find(options.m_reports.begin(), options.m_reports.end(),
+                "keyframe") != options.m_reports.end();
+
+  //
+  // reference for --check=reference: the same field evaluated directly
+  // (the tiled field point by point), with the scalar rows on one thread, into a data set of its own, from
+  // contexts of the same seeds that keep the default vertex selection
+  //
+  const bool check_reference = options.m_check == CHECK_REFERENCE;
+  Options reference_options = options;
+  reference_options.m_field_mode = FIELD_DIRECT;
+  reference_options.m_vector = VECTOR_NONE;
+  reference_options.m_isa = OSN_ISA_SCALAR;
+  reference_options.m_select = OSN_SELECT_BRANCH;
+  reference_options.m_threads = 1;
+  reference_options.m_chunk = 0;
+  reference_options.m_order = ORDER_LINEAR;
+  std::unique_ptr<DataSet> reference;
+  std::unique_ptr<FieldEngine> reference_engine;
+  struct osn_context *reference_nodal = NULL;
+  struct osn_context *reference_zonal = NULL;
+  if (check_reference) {
+    open_simplex_noise(77374, &reference_nodal);
+    open_simplex_noise(59142, &reference_zonal);
+    reference_engine.reset(new FieldEngine(1, PARTITION_SLABS,
+                                           SCHEDULE_STATIC));
+    reference.reset(
+        new DataSet(reference_options, div, arena, *reference_engine));
+  }
+  std::vector<std::atomic<int>> reference_rows_ready(
+      check_reference ? cell_rows_ready.size() : 0);
+  auto evaluate_reference = [&](double at) {
+    const FieldUpdate reference_update = {*reference_engine, *reference,
+                                          options.m_zonal_mode,
+                                          reference_rows_ready};
+    open_simplex_noise_set_isa(OSN_ISA_SCALAR);
+    if (options.m_field_mode == FIELD_TILED) {
+      VisitTileRows(reference_options, reference_nodal, reference_zonal, fbm,
+                    fbm_octaves, at,
+                    DirectTileUpdate{reference_update, nodal_tile,
+                                     zonal_tile});
+    } else {
+      VisitFieldKernel(reference_options, *reference, reference_nodal,
+                       reference_zonal, fbm, fbm_octaves, at,
+                       reference_update);
+    }
+    open_simplex_noise_set_isa(options.m_isa);
+  };
+  FieldCheck check(options.m_tolerance);
+  // bricks holding the iso-values, for --publish=active or the report
+  const bool cull_bricks =
+      options.m_order != ORDER_LINEAR && !options.m_iso.empty();
+  BrickCull cull(options.m_iso,
+                 std::find(options.m_reports.begin(), options.m_reports.end(),
+                           "bricks") != options.m_reports.end());
+  long first_faults = 0, later_faults = 0;
+
   for (int t = 0; t < options.m_time_steps; ++t) {
     //
     // update scalars
     //
-    for (int z = 0; z < data_set.m_point_dims[2]; ++z)
-      for (int y = 0; y < data_set.m_point_dims[1]; ++y)
-        for (int x = 0; x < data_set.m_point_dims[0]; ++x) {
-          double val_point = calculateVelocityMagnitude(x, y, z, time);
-          data_set.SetPoint(val_point, x, y, z);
-        }
+    const long step_start_faults = PageFaults();
+    if (options.m_field_mode == FIELD_KEYFRAME) {
+      keyframes.Update(engine, data_set.m_point_dims, data_set.m_cell_dims,
+                       time, evaluate, data_set.m_nodal_scalars,
+                       data_set.m_zonal_scalars);
+      if (compare_keyframes) {
+        keyframes.Compare(time, evaluate, data_set.m_nodal_scalars,
+                          data_set.m_zonal_scalars);
+      }
+    } else if (options.m_field_mode == FIELD_TILED) {
+      tiled(time);
+    } else {
+      evaluate(time);
+    }
+    (t == 0 ? first_faults : later_faults) += PageFaults() - step_start_faults;
+    if (check_reference) {
+      evaluate_reference(time);
+      check.Compare(engine, data_set, *reference);
+      check.PrintStep(t, time, true);
+    } else if (options.m_check == CHECK_CHECKSUM) {
+      check.Digest(engine, data_set);
+      check.PrintStep(t, time, false);
+    }
+    if (cull_bricks) {
+      cull.Select(data_set.m_fields, data_set.m_nodal_field);
+    }
+    if (options.m_publish == PUBLISH_ACTIVE) {
+      mesh_data.reset();
+      for (size_t b = 0; b < cull.m_active.size(); ++b)
+        populate_brick(mesh_data.append(), cull.m_active[b]);
+    } else {
+      data_set.Linearize(engine);
+      if (t == 0)
+        populate_mesh();
+    }
     time += options.m_time_delta;
-    ascent.publish(mesh_data);
-    ascent.execute(actions);
-    ascent.execute(reset);
+    // no domains when no brick is active
+    if (mesh_data.number_of_children() > 0) {
+      ascent.publish(mesh_data);
+      ascent.execute(actions);
+      ascent.execute(reset);
+    }
   } // for each time step
 
+  for (size_t r = 0; r < options.m_reports.size(); ++r) {
+    if (options.m_reports[r] == "threads") {
+      engine.PrintStats();
+    } else if (options.m_reports[r] == "keyframe" &&
+               options.m_field_mode == FIELD_KEYFRAME) {
+      keyframes.PrintStats();
+    } else if (options.m_reports[r] == "memory") {
+      arena.PrintStats(setup_faults, first_faults, later_faults,
+                       options.m_time_steps - 1);
+    } else if (options.m_reports[r] == "numa") {
+      arena.PrintPlacement();
+    } else if (options.m_reports[r] == "bricks" && cull_bricks) {
+      cull.PrintStats();
+    }
+  }
+  if (options.m_check != CHECK_NONE) {
+    check.PrintStats(check_reference);
+  }
+
+  //
+  // cleanup
+  //
+  open_simplex_noise_free(ctx_nodal);
+  open_simplex_noise_free(ctx_zonal);
+  if (check_reference) {
+    open_simplex_noise_free(reference_nodal);
+    open_simplex_noise_free(reference_zonal);
+  }
   ascent.close();
-  return 0;
+  // a step outside the tolerance fails the run
+  return check.m_failures > 0 ? 1 : 0;
 }
@@ -0,0 +1,209 @@
+#ifndef NOISE_KERNEL_H
+#define NOISE_KERNEL_H
+
+#include "open_simplex_fbm.h"
+#include "open_simplex_noise.h"
+#include "open_simplex_noise_gradients.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+//
+// Header-only C++ front end to the noise library.  Noise<Dim, Real> fixes
+// the dimension and precision of a context at compile time, so each call
+// resolves to its C entry point with no dispatch on either, and a field
+// loop written against it switches precision by its template argument.
+// The C functions stay the entry points underneath, and the evaluation
+// stays in the library's row kernels, whose lanes no inlined per-point
+// loop matches.  The gradient sets are the library's own, constexpr here.
+//
+// NoiseSlice<Real> owns a w = const slice of a 4D context for one step
+// (see open_simplex_noise4_slice), and Fbm<Real> sums octaves through one
+// slice per octave, bit-identical to open_simplex_fbm4_row.
+//
+
+// The C entry points by precision, for the templates below
+inline double NoisePoint(const osn_context *ctx, double x, double y,
+                         double z) {
+  return open_simplex_noise3(ctx, x, y, z);
+}
+inline float NoisePoint(const osn_context *ctx, float x, float y, float z) {
+  return open_simplex_noise3f(ctx, x, y, z);
+}
+inline double NoisePoint(const osn_context *ctx, double x, double y, double z,
+                         double w) {
+  return open_simplex_noise4(ctx, x, y, z, w);
+}
+inline float NoisePoint(const osn_context *ctx, float x, float y, float z,
+                        float w) {
+  return open_simplex_noise4f(ctx, x, y, z, w);
+}
+inline double NoiseGrad(const osn_context *ctx, double x, double y, double z,
+                        double w, double grad[4]) {
+  return open_simplex_noise4_grad(ctx, x, y, z, w, grad);
+}
+inline float NoiseGrad(const osn_context *ctx, float x, float y, float z,
+                       float w, float grad[4]) {
+  return open_simplex_noise4f_grad(ctx, x, y, z, w, grad);
+}
+inline void NoiseRow(const osn_context *ctx, const double *x, int n, double y,
+                     double z, double *out) {
+  open_simplex_noise3_row(ctx, x, n, y, z, out);
+}
+inline void NoiseRow(const osn_context *ctx, const float *x, int n, float y,
+                     float z, float *out) {
+  open_simplex_noise3f_row(ctx, x, n, y, z, out);
+}
+inline void NoiseRow(const osn_context *ctx, const double *x, int n, double y,
+                     double z, double w, double *out) {
+  open_simplex_noise4_row(ctx, x, n, y, z, w, out);
+}
+inline void NoiseRow(const osn_context *ctx, const float *x, int n, float y,
+                     float z, float w, float *out) {
+  open_simplex_noise4f_row(ctx, x, n, y, z, w, out);
+}
+inline void NoiseRow(const osn_slice *slice, const double *x, int n, double y,
+                     double z, double *out) {
+  open_simplex_noise4_slice_row(slice, x, n, y, z, out);
+}
+inline void NoiseRow(const osn_slice *slice, const float *x, int n, float y,
+                     float z, float *out) {
+  open_simplex_noise4f_slice_row(slice, x, n, y, z, out);
+}
+
+template <int Dim, typename Real> struct Noise;
+
+template <typename Real> struct Noise<3, Real> {
+  static constexpr int kGradients = sizeof(gradients3D) / 3;
+  const osn_context *m_ctx;
+
+  explicit Noise(const osn_context *ctx) : m_ctx(ctx) {}
+
+  // component a of gradient i, as the library weighs vertices with it
+  static constexpr int Gradient(int i, int a) { return gradients3D[3 * i + a]; }
+
+  Real operator()(Real x, Real y, Real z) const {
+    return NoisePoint(m_ctx, x, y, z);
+  }
+
+  void Row(const Real *x, int n, Real y, Real z, Real *out) const {
+    NoiseRow(m_ctx, x, n, y, z, out);
+  }
+};
+
+template <typename Real> struct Noise<4, Real> {
+  static constexpr int kGradients = sizeof(gradients4D) / 4;
+  const osn_context *m_ctx;
+
+  explicit Noise(const osn_context *ctx) : m_ctx(ctx) {}
+
+  static constexpr int Gradient(int i, int a) { return gradients4D[4 * i + a]; }
+
+  Real operator()(Real x, Real y, Real z, Real w) const {
+    return NoisePoint(m_ctx, x, y, z, w);
+  }
+
+  // the value, and its partial derivatives in grad
+  Real Grad(Real x, Real y, Real z, Real w, Real grad[4]) const {
+    return NoiseGrad(m_ctx, x, y, z, w, grad);
+  }
+
+  void Row(const Real *x, int n, Real y, Real z, Real w, Real *out) const {
+    NoiseRow(m_ctx, x, n, y, z, w, out);
+  }
+};
+
+//
+// 4D noise of a context at w, for points whose x + y + z lies within
+// [sum_min, sum_max] (others evaluate correctly, through the full hash).
+// Movable so a vector can hold one per octave; not copyable.
+//
+template <typename Real> struct NoiseSlice {
+  osn_slice *m_slice;
+
+  NoiseSlice(const osn_context *ctx, double w, double sum_min,
+             double sum_max)
+      : m_slice(NULL) {
+    if (open_simplex_noise4_slice(ctx, w, sum_min, sum_max, &m_slice) != 0) {
+      std::cerr << "NoiseSlice: cannot allocate the slice at w " << w
+                << "\n";
+      exit(1);
+    }
+  }
+
+  NoiseSlice(NoiseSlice &&other) : m_slice(other.m_slice) {
+    other.m_slice = NULL;
+  }
+
+  ~NoiseSlice() { open_simplex_noise4_slice_free(m_slice); }
+
+  void Row(const Real *x, int n, Real y, Real z, Real *out) const {
+    NoiseRow(m_slice, x, n, y, z, out);
+  }
+
+private:
+  NoiseSlice(const NoiseSlice &);
+  NoiseSlice &operator=(const NoiseSlice &);
+};
+
+//
+// The first octaves of fbm at w, for points whose x + y + z lies within
+// [sum_min, sum_max]: octave k goes through a slice at w * frequency_k,
+// and the octaves sum in the order and with the roundings of
+// open_simplex_fbm4_row, chunk by chunk on the stack.
+//
+template <typename Real> struct Fbm {
+  static const int kChunk = 256;
+  const osn_fbm &m_fbm;
+  Real m_total;
+  std::vector<NoiseSlice<Real>> m_slices;
+
+  Fbm(const osn_context *ctx, const osn_fbm &fbm, int octaves, double w,
+      double sum_min, double sum_max)
+      : m_fbm(fbm), m_total(0) {
+    Real amplitude = 1;
+    for (int k = 0; k < fbm.octaves; ++k) {
+      m_total += amplitude;
+      amplitude *= Real(fbm.gain);
+    }
+    octaves = std::min(octaves, fbm.octaves);
+    m_slices.reserve(octaves);
+    Real frequency = Real(fbm.frequency);
+    for (int k = 0; k < octaves; ++k) {
+      m_slices.emplace_back(ctx, w * frequency, sum_min * frequency,
+                            sum_max * frequency);
+      frequency *= Real(fbm.lacunarity);
+    }
+  }
+
+  void Row(const Real *x, int n, Real y, Real z, Real *out) const {
+    Real xs[kChunk], values[kChunk];
+    for (int start = 0; start < n; start += kChunk) {
+      const int count = std::min(n - start, int(kChunk));
+      Real *sum = out + start;
+      for (int i = 0; i < count; ++i)
+        sum[i] = 0;
+      Real frequency = Real(m_fbm.frequency);
+      Real amplitude = 1 / m_total;
+      for (size_t k = 0; k < m_slices.size(); ++k) {
+        for (int i = 0; i < count; ++i)
+          xs[i] = x[start + i] * frequency;
+        m_slices[k].Row(xs, count, y * frequency, z * frequency, values);
+        if (m_fbm.turbulence) {
+          for (int i = 0; i < count; ++i)
+            sum[i] += amplitude * std::fabs(values[i]);
+        } else {
+          for (int i = 0; i < count; ++i)
+            sum[i] += amplitude * values[i];
+        }
+        frequency *= Real(m_fbm.lacunarity);
+        amplitude *= Real(m_fbm.gain);
+      }
+    }
+  }
+};
+
+#endif
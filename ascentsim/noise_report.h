@@ -0,0 +1,537 @@
+#ifndef NOISE_REPORT_H
+#define NOISE_REPORT_H
+
+#include "field_bricks.h"
+#include "noise_tile.h"
+#include "open_simplex_noise.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//
+// Diagnostics for the noise library, run over the point lattice of a data
+// set.  Each report prints a short block in the style of Options::Print.
+//
+
+inline double ReportSeconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+//
+// Compares the float family against the double path on every point of the
+// lattice at time w: max and RMS absolute error and the time per point of
+// each precision through the row API.
+//
+inline void ReportPrecision(osn_context *ctx, const int dims[3],
+                            const double origin[3], const double spacing[3],
+                            double w) {
+  std::vector<double> xd(dims[0]), vd(dims[0]);
+  std::vector<float> xf(dims[0]), vf(dims[0]);
+  for (int x = 0; x < dims[0]; ++x) {
+    xd[x] = origin[0] + spacing[0] * double(x);
+    xf[x] = float(xd[x]);
+  }
+
+  double max_err = 0., sum_sq = 0., max_abs = 0.;
+  double time_d = 0., time_f = 0.;
+  for (int z = 0; z < dims[2]; ++z)
+    for (int y = 0; y < dims[1]; ++y) {
+      const double yc = origin[1] + spacing[1] * double(y);
+      const double zc = origin[2] + spacing[2] * double(z);
+      double start = ReportSeconds();
+      open_simplex_noise4_row(ctx, &xd[0], dims[0], yc, zc, w, &vd[0]);
+      time_d += ReportSeconds() - start;
+      start = ReportSeconds();
+      open_simplex_noise4f_row(ctx, &xf[0], dims[0], float(yc), float(zc),
+                               float(w), &vf[0]);
+      time_f += ReportSeconds() - start;
+      for (int x = 0; x < dims[0]; ++x) {
+        const double err = std::fabs(double(vf[x]) - vd[x]);
+        max_err = std::max(max_err, err);
+        max_abs = std::max(max_abs, std::fabs(vd[x]));
+        sum_sq += err * err;
+      }
+    }
+
+  const double points = double(dims[0]) * double(dims[1]) * double(dims[2]);
+  std::cout << "======= Noise Precision ========\n";
+  std::cout << "points     : " << points << "\n";
+  std::cout << "max |err|  : " << max_err << " (max |value| " << max_abs
+            << ")\n";
+  std::cout << "rms err    : " << std::sqrt(sum_sq / points) << "\n";
+  std::cout << "double     : " << 1e9 * time_d / points << " ns/point\n";
+  std::cout << "float      : " << 1e9 * time_f / points << " ns/point\n";
+  std::cout << "================================\n";
+}
+
+//
+// Row vs per-point evaluation of 4D noise over one z plane of the lattice
+// at a range of x spacings, from coarser than the lattice down to many
+// points per super-cell.  Both must agree exactly; the timings show how
+// much the rows gain from neighbouring points sharing lattice vertices,
+// whose hashes and gradients the lanes then gather from the same lines.
+//
+inline void ReportCoherence(osn_context *ctx, const int dims[3],
+                            const double origin[3], double w) {
+  const double spacings[] = {1., 1. / 4., 1. / 16., 1. / 64., 1. / 256.};
+  const int num_spacings = int(sizeof(spacings) / sizeof(spacings[0]));
+  std::vector<double> xs(dims[0]), row(dims[0]), point(dims[0]);
+  const double points = double(dims[0]) * double(dims[1]);
+
+  std::cout << "======= Noise Coherence ========\n";
+  std::cout << "points     : " << points << " per spacing\n";
+  for (int s = 0; s < num_spacings; ++s) {
+    const double spacing = spacings[s];
+    for (int x = 0; x < dims[0]; ++x)
+      xs[x] = origin[0] + spacing * double(x);
+
+    double time_row = 0., time_point = 0.;
+    long mismatches = 0;
+    for (int y = 0; y < dims[1]; ++y) {
+      const double yc = origin[1] + spacing * double(y);
+      const double zc = origin[2];
+      double start = ReportSeconds();
+      open_simplex_noise4_row(ctx, &xs[0], dims[0], yc, zc, w, &row[0]);
+      time_row += ReportSeconds() - start;
+      start = ReportSeconds();
+      for (int x = 0; x < dims[0]; ++x)
+        point[x] = open_simplex_noise4(ctx, xs[x], yc, zc, w);
+      time_point += ReportSeconds() - start;
+      for (int x = 0; x < dims[0]; ++x)
+        mismatches += row[x] != point[x];
+    }
+    std::cout << "spacing " << spacing << " : row "
+              << 1e9 * time_row / points << ", point "
+              << 1e9 * time_point / points << " ns/point, " << mismatches
+              << " mismatches\n";
+  }
+  std::cout << "================================\n";
+}
+
+//
+// Branching vs table-driven vertex selection of 4D noise, per point over
+// the lattice at time w and over as many points scattered at random through
+// the same box, where the region branches are unpredictable, and the table
+// selection evaluated in vector lanes by the row form over the lattice rows
+// (on the instruction set in use).  All must agree exactly.  Leaves ctx on
+// the branching selection.
+//
+inline void ReportSelect(osn_context *ctx, const int dims[3],
+                         const double origin[3], const double spacing[3],
+                         double w) {
+  const size_t count = size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]);
+  std::vector<double> lattice(4 * count), scattered(4 * count);
+  unsigned long long state = 88172645463325252ULL;
+  size_t i = 0;
+  for (int z = 0; z < dims[2]; ++z)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int x = 0; x < dims[0]; ++x, ++i) {
+        const int index[3] = {x, y, z};
+        for (int d = 0; d < 3; ++d) {
+          lattice[4 * i + d] = origin[d] + spacing[d] * double(index[d]);
+          state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+          scattered[4 * i + d] =
+              origin[d] + spacing[d] * double(dims[d]) *
+                              (double(state >> 11) / 9007199254740992.);
+        }
+        lattice[4 * i + 3] = w;
+        scattered[4 * i + 3] = w;
+      }
+
+  auto run = [&](const std::vector<double> &points, osn_select select,
+                 std::vector<double> &out) {
+    open_simplex_noise4_select(ctx, select);
+    const double start = ReportSeconds();
+    for (size_t p = 0; p < count; ++p)
+      out[p] = open_simplex_noise4(ctx, points[4 * p], points[4 * p + 1],
+                                   points[4 * p + 2], points[4 * p + 3]);
+    return ReportSeconds() - start;
+  };
+
+  std::vector<double> branch(count), table(count);
+  std::cout << "======= Noise4 Selection =======\n";
+  std::cout << "points     : " << count << " per input\n";
+  const std::vector<double> *inputs[2] = {&lattice, &scattered};
+  const char *names[2] = {"lattice    : ", "scattered  : "};
+  for (int k = 0; k < 2; ++k) {
+    const double time_branch = run(*inputs[k], OSN_SELECT_BRANCH, branch);
+    const double time_table = run(*inputs[k], OSN_SELECT_TABLE, table);
+    long mismatches = 0;
+    for (size_t p = 0; p < count; ++p)
+      mismatches += branch[p] != table[p];
+    std::cout << names[k] << "branch " << 1e9 * time_branch / double(count)
+              << ", table " << 1e9 * time_table / double(count)
+              << " ns/point, " << mismatches << " mismatches\n";
+  }
+
+  run(lattice, OSN_SELECT_BRANCH, branch);
+  std::vector<double> x(dims[0]);
+  for (int k = 0; k < dims[0]; ++k)
+    x[k] = origin[0] + spacing[0] * double(k);
+  const double start = ReportSeconds();
+  size_t row = 0;
+  for (int z = 0; z < dims[2]; ++z)
+    for (int y = 0; y < dims[1]; ++y, row += size_t(dims[0]))
+      open_simplex_noise4_row(ctx, &x[0], dims[0],
+                              origin[1] + spacing[1] * double(y),
+                              origin[2] + spacing[2] * double(z), w,
+                              &table[row]);
+  const double time_rows = ReportSeconds() - start;
+  long mismatches = 0;
+  for (size_t p = 0; p < count; ++p)
+    mismatches += branch[p] != table[p];
+  std::cout << "rows       : "
+            << open_simplex_noise_isa_name(open_simplex_noise_get_isa())
+            << " lanes " << 1e9 * time_rows / double(count) << " ns/point, "
+            << mismatches << " mismatches\n";
+  std::cout << "================================\n";
+  open_simplex_noise4_select(ctx, OSN_SELECT_BRANCH);
+}
+
+//
+// Full evaluation of the 4D noise over the point lattice at time w against
+// a NoiseTile of tile points per axis replicated over it, on one thread:
+// time per point of each (tile build included), the speedup, and the mean
+// and standard deviation of both fields, which the tile should keep.
+//
+inline void ReportTile(const osn_context *ctx, const int dims[3],
+                       const double origin[3], const double spacing[3],
+                       double w, int tile) {
+  const size_t count = size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]);
+  std::vector<double> x(dims[0]), full(count), tiled(count);
+  for (int i = 0; i < dims[0]; ++i)
+    x[i] = origin[0] + spacing[0] * double(i);
+
+  double start = ReportSeconds();
+  size_t row = 0;
+  for (int k = 0; k < dims[2]; ++k)
+    for (int j = 0; j < dims[1]; ++j, row += size_t(dims[0]))
+      open_simplex_noise4_row(ctx, &x[0], dims[0],
+                              origin[1] + spacing[1] * double(j),
+                              origin[2] + spacing[2] * double(k), w,
+                              &full[row]);
+  const double time_full = ReportSeconds() - start;
+
+  const int tile_dims[3] = {std::min(tile, dims[0]), std::min(tile, dims[1]),
+                            std::min(tile, dims[2])};
+  FieldEngine serial(1, PARTITION_SLABS, SCHEDULE_STATIC);
+  NoiseTile noise_tile(tile_dims, spacing, 77374, 0.25);
+  long evaluations = 0;
+  start = ReportSeconds();
+  noise_tile.Build(serial, origin,
+                   [&](const double *xs, int n, double y, double z,
+                       double *out) {
+                     open_simplex_noise4_row(ctx, xs, n, y, z, w, out);
+                     evaluations += n;
+                   });
+  row = 0;
+  for (int k = 0; k < dims[2]; ++k)
+    for (int j = 0; j < dims[1]; ++j, row += size_t(dims[0]))
+      noise_tile.Row(j, k, dims[0], &tiled[row]);
+  const double time_tiled = ReportSeconds() - start;
+
+  auto moments = [&](const std::vector<double> &v, double &mean,
+                     double &deviation) {
+    double sum = 0., sum_sq = 0.;
+    for (size_t p = 0; p < count; ++p) {
+      sum += v[p];
+      sum_sq += v[p] * v[p];
+    }
+    mean = sum / double(count);
+    deviation = std::sqrt(std::max(sum_sq / double(count) - mean * mean, 0.));
+  };
+  double full_mean, full_dev, tiled_mean, tiled_dev;
+  moments(full, full_mean, full_dev);
+  moments(tiled, tiled_mean, tiled_dev);
+
+  std::cout << "========== Noise Tile ==========\n";
+  std::cout << "points     : " << count << "\n";
+  std::cout << "tile       : (" << tile_dims[0] << ", " << tile_dims[1] << ", "
+            << tile_dims[2] << "), "
+            << double(evaluations) / double(noise_tile.m_values.size())
+            << " evaluations per tile point\n";
+  std::cout << "full       : " << 1e9 * time_full / double(count)
+            << " ns/point, mean " << full_mean << ", std dev " << full_dev
+            << "\n";
+  std::cout << "tiled      : " << 1e9 * time_tiled / double(count)
+            << " ns/point, mean " << tiled_mean << ", std dev " << tiled_dev
+            << "\n";
+  std::cout << "speedup    : " << time_full / time_tiled << "\n";
+  std::cout << "================================\n";
+}
+
+//
+// visit(lo, hi, window) for every brick holding points [lo, hi) with lower
+// neighbours below and upper above them in the lattice, window being the
+// box [lo - lower, hi + upper) copied out x fastest (FieldBricks::Extract)
+//
+template <typename Visit>
+void ReportBrickWindows(const FieldBricks &bricks, const double *values,
+                        int lower, int upper, const Visit &visit) {
+  const int *dims = bricks.m_dims;
+  const size_t edge = size_t(bricks.m_edge + lower + upper);
+  std::vector<double> window(edge * edge * edge);
+  for (int bz = 0; bz < bricks.m_bricks[2]; ++bz)
+    for (int by = 0; by < bricks.m_bricks[1]; ++by)
+      for (int bx = 0; bx < bricks.m_bricks[0]; ++bx) {
+        const int brick[3] = {bx, by, bz};
+        int lo[3], hi[3], box_lo[3], box_hi[3];
+        bool empty = false;
+        for (int a = 0; a < 3; ++a) {
+          lo[a] = std::max(brick[a] << bricks.m_shift, lower);
+          hi[a] = std::min((brick[a] + 1) << bricks.m_shift, dims[a] - upper);
+          empty |= lo[a] >= hi[a];
+          box_lo[a] = lo[a] - lower;
+          box_hi[a] = hi[a] + upper;
+        }
+        if (empty)
+          continue;
+        bricks.Extract(values, box_lo, box_hi, &window[0]);
+        visit(lo, hi, &window[0]);
+      }
+}
+
+//
+// Neighbourhood access in the linear and Morton field layouts, on one
+// thread, over the 4D noise on the point lattice at time w: a 7-point
+// Laplacian at every interior point, and the value range of every cell's 8
+// corners tested against 0, as an isosurface filter reads them.  Each
+// layout is visited in its own storage order: linear with fixed neighbour
+// offsets, Morton brick by brick, each brick and its halo copied out x
+// fastest with the Morton decoding done once per brick row, and the same
+// fixed-offset stencil run on the copy.  The results must match.  Also
+// times the conversion of the bricks to linear order done for publishing.
+//
+inline void ReportLayout(const osn_context *ctx, const int dims[3],
+                         const double origin[3], const double spacing[3],
+                         double w, int brick_shift) {
+  const size_t count = size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]);
+  const FieldBricks bricks(dims, brick_shift, true);
+  std::vector<double> x(dims[0]), linear(count), morton(bricks.Size(), 0.),
+      copy(count);
+  for (int i = 0; i < dims[0]; ++i)
+    x[i] = origin[0] + spacing[0] * double(i);
+  size_t row = 0;
+  for (int k = 0; k < dims[2]; ++k)
+    for (int j = 0; j < dims[1]; ++j, row += size_t(dims[0])) {
+      open_simplex_noise4_row(ctx, &x[0], dims[0],
+                              origin[1] + spacing[1] * double(j),
+                              origin[2] + spacing[2] * double(k), w,
+                              &linear[row]);
+      bricks.Scatter(&morton[0], j, k, &linear[row]);
+    }
+
+  const ptrdiff_t sy = dims[0], sz = ptrdiff_t(dims[0]) * dims[1];
+  double start = ReportSeconds();
+  double linear_laplacian = 0.;
+  for (int k = 1; k + 1 < dims[2]; ++k)
+    for (int j = 1; j + 1 < dims[1]; ++j) {
+      const double *p = &linear[size_t(k) * size_t(sz) + size_t(j) * sy];
+      for (int i = 1; i + 1 < dims[0]; ++i)
+        linear_laplacian += p[i - 1] + p[i + 1] + p[i - sy] + p[i + sy] +
+                            p[i - sz] + p[i + sz] - 6. * p[i];
+    }
+  const double time_linear_laplacian = ReportSeconds() - start;
+
+  start = ReportSeconds();
+  long linear_cells = 0;
+  for (int k = 0; k + 1 < dims[2]; ++k)
+    for (int j = 0; j + 1 < dims[1]; ++j) {
+      const double *p = &linear[size_t(k) * size_t(sz) + size_t(j) * sy];
+      for (int i = 0; i + 1 < dims[0]; ++i) {
+        const double corners[8] = {p[i], p[i + 1], p[i + sy], p[i + sy + 1],
+                                   p[i + sz], p[i + sz + 1], p[i + sy + sz],
+                                   p[i + sy + sz + 1]};
+        const double lo = *std::min_element(corners, corners + 8);
+        const double hi = *std::max_element(corners, corners + 8);
+        linear_cells += lo <= 0. && hi > 0.;
+      }
+    }
+  const double time_linear_cells = ReportSeconds() - start;
+
+  const double *m = &morton[0];
+  start = ReportSeconds();
+  double morton_laplacian = 0.;
+  ReportBrickWindows(bricks, m, 1, 1, [&](const int lo[3], const int hi[3],
+                                          const double *window) {
+    const ptrdiff_t wy = hi[0] - lo[0] + 2, wz = wy * (hi[1] - lo[1] + 2);
+    for (int k = 1; k <= hi[2] - lo[2]; ++k)
+      for (int j = 1; j <= hi[1] - lo[1]; ++j) {
+        const double *p = window + k * wz + j * wy;
+        for (int i = 1; i <= hi[0] - lo[0]; ++i)
+          morton_laplacian += p[i - 1] + p[i + 1] + p[i - wy] + p[i + wy] +
+                              p[i - wz] + p[i + wz] - 6. * p[i];
+      }
+  });
+  const double time_morton_laplacian = ReportSeconds() - start;
+
+  start = ReportSeconds();
+  long morton_cells = 0;
+  ReportBrickWindows(bricks, m, 0, 1, [&](const int lo[3], const int hi[3],
+                                          const double *window) {
+    const ptrdiff_t wy = hi[0] - lo[0] + 1, wz = wy * (hi[1] - lo[1] + 1);
+    for (int k = 0; k < hi[2] - lo[2]; ++k)
+      for (int j = 0; j < hi[1] - lo[1]; ++j) {
+        const double *p = window + k * wz + j * wy;
+        for (int i = 0; i < hi[0] - lo[0]; ++i) {
+          const double corners[8] = {p[i], p[i + 1], p[i + wy],
+                                     p[i + wy + 1], p[i + wz],
+                                     p[i + wz + 1], p[i + wy + wz],
+                                     p[i + wy + wz + 1]};
+          const double lo = *std::min_element(corners, corners + 8);
+          const double hi = *std::max_element(corners, corners + 8);
+          morton_cells += lo <= 0. && hi > 0.;
+        }
+      }
+  });
+  const double time_morton_cells = ReportSeconds() - start;
+
+  start = ReportSeconds();
+  for (int bz = 0; bz < bricks.m_bricks[2]; ++bz)
+    for (int by = 0; by < bricks.m_bricks[1]; ++by)
+      bricks.Linearize(&morton[0], by, bz, &copy[0]);
+  const double time_convert = ReportSeconds() - start;
+
+  const double interior = double(dims[0] - 2) * double(dims[1] - 2) *
+                          double(dims[2] - 2);
+  const double cells = double(dims[0] - 1) * double(dims[1] - 1) *
+                       double(dims[2] - 1);
+  std::cout << "========= Field Layout =========\n";
+  std::cout << "points     : " << count << " (" << bricks.m_edge
+            << "^3 bricks, " << bricks.Size() - count << " padding)\n";
+  std::cout << "laplacian  : linear " << 1e9 * time_linear_laplacian / interior
+            << " ns/point, morton " << 1e9 * time_morton_laplacian / interior
+            << " ns/point\n";
+  std::cout << "cell range : linear " << 1e9 * time_linear_cells / cells
+            << " ns/cell, morton " << 1e9 * time_morton_cells / cells
+            << " ns/cell, " << linear_cells << " cells cross 0\n";
+  std::cout << "to linear  : " << 1e9 * time_convert / double(count)
+            << " ns/point\n";
+  // the sums add in different orders, so only to rounding
+  std::cout << "match      : "
+            << (linear_cells == morton_cells &&
+                        std::fabs(linear_laplacian - morton_laplacian) <=
+                            1e-9 * interior &&
+                        copy == linear
+                    ? "yes"
+                    : "NO")
+            << "\n";
+  std::cout << "================================\n";
+}
+
+//
+// FNV-1a digests of the bit patterns of the 2D, 3D and 4D noise and the
+// float 3D and 4D noise over a fixed grid around the origin.
+//
+enum { DIGEST_NOISE2, DIGEST_NOISE3, DIGEST_NOISE4, DIGEST_NOISE3F,
+       DIGEST_NOISE4F, DIGEST_COUNT };
+
+inline void ReportDigest(unsigned long long &hash, const void *value,
+                         size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(value);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+inline void ReportDigests(const osn_context *ctx,
+                          unsigned long long digests[DIGEST_COUNT]) {
+  for (int d = 0; d < DIGEST_COUNT; ++d)
+    digests[d] = 14695981039346656037ULL;
+  for (int l = 0; l < 6; ++l)
+    for (int k = 0; k < 12; ++k)
+      for (int j = 0; j < 24; ++j)
+        for (int i = 0; i < 48; ++i) {
+          const double x = -5.3 + 0.37 * i, y = -2.9 + 0.41 * j;
+          const double z = -1.7 + 0.53 * k, w = -0.6 + 0.61 * l;
+          double v;
+          float f;
+          if (k == 0 && l == 0) {
+            v = open_simplex_noise2(ctx, x, y);
+            ReportDigest(digests[DIGEST_NOISE2], &v, sizeof(v));
+          }
+          if (l == 0) {
+            v = open_simplex_noise3(ctx, x, y, z);
+            ReportDigest(digests[DIGEST_NOISE3], &v, sizeof(v));
+            f = open_simplex_noise3f(ctx, float(x), float(y), float(z));
+            ReportDigest(digests[DIGEST_NOISE3F], &f, sizeof(f));
+          }
+          v = open_simplex_noise4(ctx, x, y, z, w);
+          ReportDigest(digests[DIGEST_NOISE4], &v, sizeof(v));
+          f = open_simplex_noise4f(ctx, float(x), float(y), float(z),
+                                   float(w));
+          ReportDigest(digests[DIGEST_NOISE4F], &f, sizeof(f));
+        }
+}
+
+//
+// Checks the context against digests recorded with the original layout
+// (separately allocated int16_t tables) for a seeded and an explicitly
+// permuted context, then recomputes the digests from threads sharing one
+// context, which must all agree with the serial ones.
+//
+inline void ReportContext(int threads) {
+  static const unsigned long long seeded[DIGEST_COUNT] = {
+      0x0b7b704ac236c2cdULL, 0x9193f0e355ccf401ULL, 0x45af3b579280dde4ULL,
+      0x566f3b49287981c3ULL, 0x05ced051d1b13f19ULL};
+  static const unsigned long long permuted[DIGEST_COUNT] = {
+      0x9c5213a77b46cd24ULL, 0xa8a1383ea53f0dd8ULL, 0xf58d9cc7aa1c0aadULL,
+      0xf45d2e13905ad303ULL, 0xaf0d30448738364cULL};
+  static const char *names[DIGEST_COUNT] = {"noise2", "noise3", "noise4",
+                                            "noise3f", "noise4f"};
+  auto check = [&](const char *label, const unsigned long long *digests,
+                   const unsigned long long *expected) {
+    std::cout << label;
+    int failed = 0;
+    for (int d = 0; d < DIGEST_COUNT; ++d) {
+      if (digests[d] != expected[d]) {
+        std::cout << (failed++ ? ", " : "MISMATCH ") << names[d];
+      }
+    }
+    std::cout << (failed ? "\n" : "match\n");
+  };
+
+  osn_context *ctx;
+  if (open_simplex_noise(77374, &ctx))
+    return;
+  unsigned long long digests[DIGEST_COUNT];
+  std::cout << "========= Noise Context ========\n";
+  std::cout << "alignment  : "
+            << reinterpret_cast<unsigned long long>(ctx) % 64
+            << " (address mod 64)\n";
+  ReportDigests(ctx, digests);
+  check("seeded     : ", digests, seeded);
+
+  std::vector<unsigned long long> shared(size_t(threads) * DIGEST_COUNT);
+  const osn_context *readonly = ctx;
+  ThreadPool pool(threads);
+  const std::function<void(int)> job = [&](int thread) {
+    ReportDigests(readonly, &shared[size_t(thread) * DIGEST_COUNT]);
+  };
+  pool.Run(job);
+  int disagree = 0;
+  for (int t = 0; t < threads; ++t)
+    disagree += !std::equal(digests, digests + DIGEST_COUNT,
+                            &shared[size_t(t) * DIGEST_COUNT]);
+  std::cout << "shared     : " << threads << " threads, "
+            << (disagree ? "MISMATCH" : "match") << "\n";
+
+  int16_t perm[256];
+  for (int i = 0; i < 256; ++i)
+    perm[i] = int16_t((i * 167 + 13) & 0xFF);
+  open_simplex_noise_init_perm(ctx, perm, 256);
+  ReportDigests(ctx, digests);
+  check("permuted   : ", digests, permuted);
+  std::cout << "================================\n";
+  open_simplex_noise_free(ctx);
+}
+
+#endif
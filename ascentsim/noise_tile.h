@@ -0,0 +1,219 @@
+#ifndef NOISE_TILE_H
+#define NOISE_TILE_H
+
+#include "field_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//
+// Periodic tile of a noise field, evaluated once per step and replicated
+// over the whole grid.
+//
+// The noise repeats every 256 cells of its skewed lattice, which is not a
+// whole number of grid points along any grid axis, so the tile is made
+// periodic by blending.  Wrapping the lattice hash modulo the tile instead
+// would not do: the 4D skew mixes w into every lattice coordinate with an
+// irrational factor, so no wrapped lattice repeats along a grid axis.
+//
+// A tile of m_dims points spans m_length = m_dims * spacing.  Along each
+// axis its last NoiseTileBand(m_dims) points form a band at whose point j
+// (from 1 to band) the angle is pi/2 j / (band + 1), and the angle is 0
+// elsewhere; the tile's point is
+//
+//   sum over c in {0,1}^3 of  prod_a (c_a ? sin : cos)(angle_a)
+//                             * noise(p - c * m_length)
+//
+// which ramps across the band towards the noise at the start of the tile,
+// so the copies join continuously.  The weights' squares sum to one on
+// every axis, so the variance of the field is kept, unlike a linear blend.
+// Terms of weight zero are not evaluated: a point outside the bands costs
+// one evaluation, and the tile (1 + band / m_dims)^3 per point on average,
+// under 2 at the default band, once per step whatever the size of the grid.
+//
+// Copies are told apart by a gain in [1 - m_amplitude, 1 + m_amplitude]
+// hashed at each tile corner and interpolated trilinearly between them,
+// which keeps the field continuous across the tile faces.
+//
+
+// points of the blending band along an axis of dims tile points
+inline int NoiseTileBand(int dims) { return (dims + 3) / 4; }
+
+struct NoiseTile {
+  int m_dims[3];
+  double m_length[3];
+  uint64_t m_seed;
+  double m_amplitude;
+  std::vector<double> m_values;
+  std::vector<double> m_weights[3]; // cos, sin of the angle per tile point
+  std::vector<int> m_xindex;        // 0 .. m_dims[0] - 1, the tile's row
+  std::vector<double> m_scratch;    // two rows per engine thread
+  size_t m_scratch_row;             // doubles per row, whole cache lines
+  double m_build_seconds;
+  long m_builds;
+
+  NoiseTile(const int dims[3], const double spacing[3], uint64_t seed,
+            double amplitude)
+      : m_dims{dims[0], dims[1], dims[2]},
+        m_length{spacing[0] * dims[0], spacing[1] * dims[1],
+                 spacing[2] * dims[2]},
+        m_seed(seed), m_amplitude(amplitude),
+        m_values(size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2])),
+        m_xindex(dims[0]), m_scratch_row((size_t(dims[0]) + 7) / 8 * 8),
+        m_build_seconds(0.), m_builds(0) {
+    const double half_pi = 0.5 * std::acos(-1.);
+    for (int a = 0; a < 3; ++a) {
+      const int band = NoiseTileBand(m_dims[a]);
+      m_weights[a].resize(2 * m_dims[a]);
+      for (int i = 0; i < m_dims[a]; ++i) {
+        const int j = std::max(i - (m_dims[a] - band) + 1, 0);
+        const double angle = half_pi * double(j) / double(band + 1);
+        m_weights[a][2 * i] = j > 0 ? std::cos(angle) : 1.;
+        m_weights[a][2 * i + 1] = j > 0 ? std::sin(angle) : 0.;
+      }
+    }
+    for (int x = 0; x < m_dims[0]; ++x)
+      m_xindex[x] = x;
+  }
+
+  //
+  // Evaluates the tile whose first point is at origin.  row(x, n, y, z,
+  // out) must write the field at (x[i], y, z) for i < n into out, and is
+  // called from the engine's threads, each into scratch rows of its own
+  // that are allocated on the first build.
+  //
+  template <typename Row>
+  void Build(FieldEngine &engine, const double origin[3], const Row &row) {
+    const double start = PoolSeconds();
+    const int nx = m_dims[0];
+    m_scratch.resize(size_t(engine.NumThreads()) * 2 * m_scratch_row);
+    engine.Update(m_dims, [&](int y, int z) {
+      double *scratch =
+          &m_scratch[size_t(PoolThreadIndex()) * 2 * m_scratch_row];
+      Blend(origin, y, z, &m_xindex[0], nx, row, scratch,
+            scratch + m_scratch_row,
+            &m_values[(size_t(z) * size_t(m_dims[1]) + size_t(y)) *
+                      size_t(nx)]);
+    });
+    m_build_seconds += PoolSeconds() - start;
+    ++m_builds;
+  }
+
+  //
+  // Writes the n grid points (0 .. n-1, y, z) of the replicated field into
+  // out.  Grid point i lies at i mod m_dims of copy i / m_dims.
+  //
+  void Row(int y, int z, int n, double *out) const {
+    const int iy = y % m_dims[1], iz = z % m_dims[2];
+    Replicate(y, z, n,
+              &m_values[(size_t(iz) * size_t(m_dims[1]) + size_t(iy)) *
+                        size_t(m_dims[0])],
+              0, out);
+  }
+
+  //
+  // The same n grid points as Row, but with no tile: each point's terms
+  // are evaluated at its own place in its copy, on the calling thread.
+  // Bit-identical to Build then Row when row is, so it is the reference
+  // that --check=reference holds the tiled field to.
+  //
+  template <typename Row>
+  void DirectRow(const double origin[3], int y, int z, int n, const Row &row,
+                 double *out) const {
+    std::vector<int> index(n);
+    std::vector<double> xs(n), shifted(n), values(n);
+    for (int x = 0; x < n; ++x)
+      index[x] = x % m_dims[0];
+    Blend(origin, y % m_dims[1], z % m_dims[2], &index[0], n, row, &xs[0],
+          &shifted[0], &values[0]);
+    Replicate(y, z, n, &values[0], m_dims[0], out);
+  }
+
+  // gain of the tile corner (tx, ty, tz), from a 64-bit finalizer hash
+  double Gain(int tx, int ty, int tz) const {
+    uint64_t h = m_seed ^ (uint64_t(uint32_t(tx)) * 0x9E3779B97F4A7C15ULL) ^
+                 (uint64_t(uint32_t(ty)) * 0xC2B2AE3D27D4EB4FULL) ^
+                 (uint64_t(uint32_t(tz)) * 0x165667B19E3779F9ULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    const double unit = double(h >> 11) * (1. / 9007199254740992.);
+    return 1. + m_amplitude * (2. * unit - 1.);
+  }
+private:
+  //
+  // Blends the terms at tile row (y, z) for the n tile x indices in index
+  // into out, skipping terms of weight zero.  xs and shifted hold n each.
+  //
+  template <typename Row>
+  void Blend(const double origin[3], int y, int z, const int *index, int n,
+             const Row &row, double *xs, double *shifted, double *out) const {
+    const double spacing = m_length[0] / double(m_dims[0]);
+    for (int x = 0; x < n; ++x)
+      out[x] = 0.;
+    for (int cz = 0; cz < 2; ++cz)
+      for (int cy = 0; cy < 2; ++cy) {
+        const double wyz = m_weights[1][2 * y + cy] * m_weights[2][2 * z + cz];
+        if (wyz == 0.)
+          continue;
+        const double ycoord = origin[1] +
+                              m_length[1] / double(m_dims[1]) * double(y) -
+                              cy * m_length[1];
+        const double zcoord = origin[2] +
+                              m_length[2] / double(m_dims[2]) * double(z) -
+                              cz * m_length[2];
+        for (int cx = 0; cx < 2; ++cx) {
+          // the points whose weight is not zero, packed into one row
+          int count = 0;
+          for (int x = 0; x < n; ++x)
+            if (m_weights[0][2 * index[x] + cx] != 0.)
+              xs[count++] = origin[0] + spacing * double(index[x]) -
+                            cx * m_length[0];
+          if (count == 0)
+            continue;
+          row(xs, count, ycoord, zcoord, shifted);
+          for (int x = 0, k = 0; x < n; ++x) {
+            const double wx = m_weights[0][2 * index[x] + cx];
+            if (wx != 0.)
+              out[x] += wyz * wx * shifted[k++];
+          }
+        }
+      }
+  }
+
+  //
+  // Scales the values of grid row (y, z) by the gain of their copies into
+  // out; values advances by stride per copy along x.
+  //
+  void Replicate(int y, int z, int n, const double *values, int stride,
+                 double *out) const {
+    const int nx = m_dims[0];
+    const int ty = y / m_dims[1], iy = y % m_dims[1];
+    const int tz = z / m_dims[2], iz = z % m_dims[2];
+    const double fy = double(iy) / double(m_dims[1]);
+    const double fz = double(iz) / double(m_dims[2]);
+    for (int x0 = 0, tx = 0; x0 < n; x0 += nx, ++tx, values += stride) {
+      // gains at the copy's two x faces, interpolated in y and z
+      double gain[2];
+      for (int c = 0; c < 2; ++c) {
+        const double g00 = Gain(tx + c, ty, tz);
+        const double g10 = Gain(tx + c, ty + 1, tz);
+        const double g01 = Gain(tx + c, ty, tz + 1);
+        const double g11 = Gain(tx + c, ty + 1, tz + 1);
+        const double g0 = g00 + (g10 - g00) * fy;
+        const double g1 = g01 + (g11 - g01) * fy;
+        gain[c] = g0 + (g1 - g0) * fz;
+      }
+      const double slope = (gain[1] - gain[0]) / double(nx);
+      const int count = std::min(nx, n - x0);
+      for (int x = 0; x < count; ++x)
+        out[x0 + x] = values[x] * (gain[0] + slope * double(x));
+    }
+  }
+};
+
+#endif
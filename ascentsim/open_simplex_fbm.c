@@ -0,0 +1,63 @@
+/*
+ * Fractal sums of OpenSimplex noise octaves, built on the row API of
+ * open_simplex_noise.c.
+ */
+
+#include <math.h>
+
+#include "open_simplex_fbm.h"
+
+/* Points per chunk; the scaled coordinates and octave values live on the stack. */
+#define FBM_CHUNK 256
+
+int open_simplex_fbm_octaves(const struct osn_fbm *fbm, double spacing)
+{
+	double frequency = fbm->frequency;
+	int k;
+
+	for (k = 1; k < fbm->octaves; k++) {
+		frequency *= fbm->lacunarity;
+		if (spacing * frequency > 0.5)
+			break;
+	}
+	return fbm->octaves < 1 ? 0 : k;
+}
+
+void open_simplex_fbm4_row(const struct osn_context *ctx, const struct osn_fbm *fbm, int octaves,
+	const double *x, int n, double y, double z, double w, double *out)
+{
+	double xs[FBM_CHUNK], values[FBM_CHUNK];
+	double frequency, amplitude, total = 0;
+	int start, count, i, k;
+
+	amplitude = 1;
+	for (k = 0; k < fbm->octaves; k++) {
+		total += amplitude;
+		amplitude *= fbm->gain;
+	}
+	if (octaves > fbm->octaves)
+		octaves = fbm->octaves;
+
+	for (start = 0; start < n; start += FBM_CHUNK) {
+		count = n - start < FBM_CHUNK ? n - start : FBM_CHUNK;
+		for (i = 0; i < count; i++)
+			out[start + i] = 0;
+		frequency = fbm->frequency;
+		amplitude = 1 / total;
+		for (k = 0; k < octaves; k++) {
+			for (i = 0; i < count; i++)
+				xs[i] = x[start + i] * frequency;
+			open_simplex_noise4_row(ctx, xs, count, y * frequency,
+				z * frequency, w * frequency, values);
+			if (fbm->turbulence) {
+				for (i = 0; i < count; i++)
+					out[start + i] += amplitude * fabs(values[i]);
+			} else {
+				for (i = 0; i < count; i++)
+					out[start + i] += amplitude * values[i];
+			}
+			frequency *= fbm->lacunarity;
+			amplitude *= fbm->gain;
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef OPEN_SIMPLEX_FBM_H__
+#define OPEN_SIMPLEX_FBM_H__
+
+/*
+ * Fractal (fBm / turbulence) sums of OpenSimplex noise octaves.
+ *
+ * Octave k samples the noise at frequency * lacunarity^k with amplitude
+ * gain^k.  The sum is divided by the total amplitude of all requested
+ * octaves, so dropping the finest octaves removes detail without changing
+ * the scale of the field.
+ */
+
+#include "open_simplex_noise.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+struct osn_fbm {
+	int octaves;		/* octaves requested */
+	double frequency;	/* frequency of the first octave */
+	double lacunarity;	/* frequency ratio between octaves */
+	double gain;		/* amplitude ratio between octaves */
+	int turbulence;		/* sum |noise| instead of noise */
+};
+
+/*
+ * Number of leading octaves a grid with the given sample spacing can
+ * represent.  Noise features are about one lattice unit across, so octave k
+ * is kept while spacing * frequency_k stays within the Nyquist limit of 1/2.
+ * The first octave is always kept.
+ */
+int open_simplex_fbm_octaves(const struct osn_fbm *fbm, double spacing);
+
+/*
+ * Evaluates the first `octaves` octaves of 4D fBm at (x[i], y, z, w) for
+ * i < n into out, one row evaluation per octave over chunks of the row.
+ */
+void open_simplex_fbm4_row(const struct osn_context *ctx, const struct osn_fbm *fbm, int octaves,
+	const double *x, int n, double y, double z, double w, double *out);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
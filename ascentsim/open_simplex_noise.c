@@ -19,8 +19,31 @@
 #include <string.h>
 #include <errno.h>
 
+/*
+ * This file is built once as the library itself, with scalar row kernels,
+ * and once more for each vector instruction set by a small file
+ * (open_simplex_noise_avx2.c, open_simplex_noise_avx512.c) that sets
+ * OSN_ISA_LEVEL and includes it.  Those builds only provide the row kernels,
+ * as a struct osn_row_kernels the library picks from at run time.
+ */
+#ifndef OSN_ISA_LEVEL
+#define OSN_ISA_LEVEL 0
+#endif
+#if OSN_ISA_LEVEL > 0
+#include <immintrin.h>
+#endif
+
 #include "open_simplex_noise.h"
 
+/* For the per-vertex helpers, which must stay inlined into the region code. */
+#if defined(__GNUC__)
+	#define FORCE_INLINE INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+	#define FORCE_INLINE __forceinline
+#else
+	#define FORCE_INLINE INLINE
+#endif
+
 #define STRETCH_CONSTANT_2D (-0.211324865405187)    /* (1 / sqrt(2 + 1) - 1 ) / 2; */
 #define SQUISH_CONSTANT_2D  (0.366025403784439)     /* (sqrt(2 + 1) -1) / 2; */
 #define STRETCH_CONSTANT_3D (-1.0 / 6.0)            /* (1 / sqrt(3 + 1) - 1) / 3; */
@@ -34,129 +57,219 @@
 	
 #define DEFAULT_SEED (0LL)
 
-struct osn_context {
-	int16_t *perm;
-	int16_t *permGradIndex3D;
-};
+#define CONTEXT_ALIGN 64
 
-#define ARRAYSIZE(x) (sizeof((x)) / sizeof((x)[0]))
-
-/* 
- * Gradients for 2D. They approximate the directions to the
- * vertices of an octagon from the center.
+/*
+ * Everything a lookup reads, in one cache-aligned block: the permutation
+ * that chains the lattice coordinates together, and for each dimension the
+ * gradient index of the last stage, precombined with the permutation.  The
+ * row lanes gather whole gradients instead, so for 3D and 4D the gradient
+ * itself is precombined too, as a word of bytes, component i in bits
+ * 8i..8i+7.
  */
-static const int8_t gradients2D[] = {
-	 5,  2,    2,  5,
-	-5,  2,   -2,  5,
-	 5, -2,    2, -5,
-	-5, -2,   -2, -5,
+struct osn_context {
+	uint8_t perm[256];
+	uint8_t permGradIndex2D[256];	/* perm & 0x0E */
+	uint8_t permGradIndex3D[256];	/* (perm % 24) * 3 */
+	uint8_t permGradIndex4D[256];	/* perm & 0xFC */
+	uint32_t permGrad3D[256];	/* gradients3D at permGradIndex3D */
+	uint32_t permGrad4D[256];	/* gradients4D at permGradIndex4D */
+	enum osn_select select4;
+	void *block;			/* allocation the context is aligned within */
 };
 
-/*	
- * Gradients for 3D. They approximate the directions to the
- * vertices of a rhombicuboctahedron from the center, skewed so
- * that the triangular and square facets can be inscribed inside
- * circles of the same radius.
+/*
+ * A w = const slice of a context's 4D noise.  The last two stages of the 4D
+ * hash, through z and then w, are fused into one table per lattice w: row
+ * wsv - wsv_min of permGrad4D holds, for every chain h through y plus zsv,
+ * the gradient word the context reaches from perm[h & 0xFF] + wsv.  The
+ * rows cover every wsv the points of the slice's x + y + z range can reach;
+ * lanes whose vertices fall outside hash in full.
  */
-static const signed char gradients3D[] = {
-	-11,  4,  4,     -4,  11,  4,    -4,  4,  11,
-	 11,  4,  4,      4,  11,  4,     4,  4,  11,
-	-11, -4,  4,     -4, -11,  4,    -4, -4,  11,
-	 11, -4,  4,      4, -11,  4,     4, -4,  11,
-	-11,  4, -4,     -4,  11, -4,    -4,  4, -11,
-	 11,  4, -4,      4,  11, -4,     4,  4, -11,
-	-11, -4, -4,     -4, -11, -4,    -4, -4, -11,
-	 11, -4, -4,      4, -11, -4,     4, -4, -11,
+struct osn_slice {
+	const struct osn_context *ctx;
+	double w;
+	int wsv_min;
+	int wsv_count;
+	uint32_t *permGrad4D;		/* [wsv_count][256], follows the struct */
 };
 
-/*	
- * Gradients for 4D. They approximate the directions to the
- * vertices of a disprismatotesseractihexadecachoron from the center,
- * skewed so that the tetrahedral and cubic facets can be inscribed inside
- * spheres of the same radius.
- */
-static const signed char gradients4D[] = {
-	 3,  1,  1,  1,      1,  3,  1,  1,      1,  1,  3,  1,      1,  1,  1,  3,
-	-3,  1,  1,  1,     -1,  3,  1,  1,     -1,  1,  3,  1,     -1,  1,  1,  3,
-	 3, -1,  1,  1,      1, -3,  1,  1,      1, -1,  3,  1,      1, -1,  1,  3,
-	-3, -1,  1,  1,     -1, -3,  1,  1,     -1, -1,  3,  1,     -1, -1,  1,  3,
-	 3,  1, -1,  1,      1,  3, -1,  1,      1,  1, -3,  1,      1,  1, -1,  3,
-	-3,  1, -1,  1,     -1,  3, -1,  1,     -1,  1, -3,  1,     -1,  1, -1,  3,
-	 3, -1, -1,  1,      1, -3, -1,  1,      1, -1, -3,  1,      1, -1, -1,  3,
-	-3, -1, -1,  1,     -1, -3, -1,  1,     -1, -1, -3,  1,     -1, -1, -1,  3,
-	 3,  1,  1, -1,      1,  3,  1, -1,      1,  1,  3, -1,      1,  1,  1, -3,
-	-3,  1,  1, -1,     -1,  3,  1, -1,     -1,  1,  3, -1,     -1,  1,  1, -3,
-	 3, -1,  1, -1,      1, -3,  1, -1,      1, -1,  3, -1,      1, -1,  1, -3,
-	-3, -1,  1, -1,     -1, -3,  1, -1,     -1, -1,  3, -1,     -1, -1,  1, -3,
-	 3,  1, -1, -1,      1,  3, -1, -1,      1,  1, -3, -1,      1,  1, -1, -3,
-	-3,  1, -1, -1,     -1,  3, -1, -1,     -1,  1, -3, -1,     -1,  1, -1, -3,
-	 3, -1, -1, -1,      1, -3, -1, -1,      1, -1, -3, -1,      1, -1, -1, -3,
-	-3, -1, -1, -1,     -1, -3, -1, -1,     -1, -1, -3, -1,     -1, -1, -1, -3,
+#define ARRAYSIZE(x) (sizeof((x)) / sizeof((x)[0]))
+
+#include "open_simplex_noise_gradients.h"
+#include "open_simplex_noise4_tables.h"
+#if OSN_ISA_LEVEL > 0
+#include "open_simplex_noise3_tables.h"
+#endif
+
+/* Row forms of both precisions, built once per instruction set. */
+struct osn_row_kernels {
+	void (*noise3_row)(const struct osn_context *ctx, const double *x, int n, double y, double z, double *out);
+	void (*noise4_row)(const struct osn_context *ctx, const double *x, int n, double y, double z, double w, double *out);
+	void (*noise3f_row)(const struct osn_context *ctx, const float *x, int n, float y, float z, float *out);
+	void (*noise4f_row)(const struct osn_context *ctx, const float *x, int n, float y, float z, float w, float *out);
+	void (*noise4_slice_row)(const struct osn_slice *slice, const double *x, int n, double y, double z, double *out);
+	void (*noise4f_slice_row)(const struct osn_slice *slice, const float *x, int n, float y, float z, float *out);
 };
 
-static double extrapolate2(struct osn_context *ctx, int xsb, int ysb, double dx, double dy)
+#if OSN_ISA_LEVEL == 0
+static double extrapolate2(const struct osn_context *ctx, int xsb, int ysb, double dx, double dy)
 {
-	int16_t *perm = ctx->perm;	
-	int index = perm[(perm[xsb & 0xFF] + ysb) & 0xFF] & 0x0E;
+	const uint8_t *perm = ctx->perm;
+	int index = ctx->permGradIndex2D[(perm[xsb & 0xFF] + ysb) & 0xFF];
 	return gradients2D[index] * dx
 		+ gradients2D[index + 1] * dy;
 }
+#endif
 	
-static double extrapolate3(struct osn_context *ctx, int xsb, int ysb, int zsb, double dx, double dy, double dz)
+static INLINE int fastFloor(double x) {
+	int xi = (int) x;
+	return x < xi ? xi - 1 : xi;
+}
+
+static INLINE int grad_index3(const struct osn_context *ctx, int xsb, int ysb, int zsb)
 {
-	int16_t *perm = ctx->perm;	
-	int16_t *permGradIndex3D = ctx->permGradIndex3D;
-	int index = permGradIndex3D[(perm[(perm[xsb & 0xFF] + ysb) & 0xFF] + zsb) & 0xFF];
-	return gradients3D[index] * dx
-		+ gradients3D[index + 1] * dy
-		+ gradients3D[index + 2] * dz;
+	const uint8_t *perm = ctx->perm;
+	return ctx->permGradIndex3D[(perm[(perm[xsb & 0xFF] + ysb) & 0xFF] + zsb) & 0xFF];
 }
-	
-static double extrapolate4(struct osn_context *ctx, int xsb, int ysb, int zsb, int wsb, double dx, double dy, double dz, double dw)
+
+static INLINE int grad_index4(const struct osn_context *ctx, int xsb, int ysb, int zsb, int wsb)
 {
-	int16_t *perm = ctx->perm;
-	int index = perm[(perm[(perm[(perm[xsb & 0xFF] + ysb) & 0xFF] + zsb) & 0xFF] + wsb) & 0xFF] & 0xFC;
-	return gradients4D[index] * dx
-		+ gradients4D[index + 1] * dy
-		+ gradients4D[index + 2] * dz
-		+ gradients4D[index + 3] * dw;
+	const uint8_t *perm = ctx->perm;
+	return ctx->permGradIndex4D[(perm[(perm[(perm[xsb & 0xFF] + ysb) & 0xFF] + zsb) & 0xFF] + wsb) & 0xFF];
 }
-	
-static INLINE int fastFloor(double x) {
-	int xi = (int) x;
-	return x < xi ? xi - 1 : xi;
+
+#if OSN_ISA_LEVEL == 0
+extern const struct osn_row_kernels osn_row_kernels_scalar;
+#if defined(OSN_HAVE_AVX2)
+extern const struct osn_row_kernels osn_row_kernels_avx2;
+#endif
+#if defined(OSN_HAVE_AVX512)
+extern const struct osn_row_kernels osn_row_kernels_avx512;
+#endif
+
+/* Row kernels in use, set by the first context or open_simplex_noise_set_isa. */
+static const struct osn_row_kernels *row_kernels;
+static enum osn_isa row_isa = OSN_ISA_SCALAR;
+
+const char *open_simplex_noise_isa_name(enum osn_isa isa)
+{
+	switch (isa) {
+	case OSN_ISA_AVX2:
+		return "avx2";
+	case OSN_ISA_AVX512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
 }
-	
-static int allocate_perm(struct osn_context *ctx, int nperm, int ngrad)
+
+/* Built into the library, and reported by cpuid (with OS support for its registers). */
+int open_simplex_noise_isa_supported(enum osn_isa isa)
 {
-	if (ctx->perm)
-		free(ctx->perm);
-	if (ctx->permGradIndex3D)
-		free(ctx->permGradIndex3D);
-	ctx->perm = (int16_t *) malloc(sizeof(*ctx->perm) * nperm); 
-	if (!ctx->perm)
-		return -ENOMEM;
-	ctx->permGradIndex3D = (int16_t *) malloc(sizeof(*ctx->permGradIndex3D) * ngrad);
-	if (!ctx->permGradIndex3D) {
-		free(ctx->perm);
-		return -ENOMEM;
+	switch (isa) {
+	case OSN_ISA_SCALAR:
+		return 1;
+#if defined(OSN_HAVE_AVX2)
+	case OSN_ISA_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+#if defined(OSN_HAVE_AVX512)
+	case OSN_ISA_AVX512:
+		return __builtin_cpu_supports("avx512f");
+#endif
+	default:
+		return 0;
+	}
+}
+
+enum osn_isa open_simplex_noise_best_isa(void)
+{
+	if (open_simplex_noise_isa_supported(OSN_ISA_AVX512))
+		return OSN_ISA_AVX512;
+	if (open_simplex_noise_isa_supported(OSN_ISA_AVX2))
+		return OSN_ISA_AVX2;
+	return OSN_ISA_SCALAR;
+}
+
+int open_simplex_noise_set_isa(enum osn_isa isa)
+{
+	if (!open_simplex_noise_isa_supported(isa))
+		return -EINVAL;
+	switch (isa) {
+#if defined(OSN_HAVE_AVX2)
+	case OSN_ISA_AVX2:
+		row_kernels = &osn_row_kernels_avx2;
+		break;
+#endif
+#if defined(OSN_HAVE_AVX512)
+	case OSN_ISA_AVX512:
+		row_kernels = &osn_row_kernels_avx512;
+		break;
+#endif
+	default:
+		row_kernels = &osn_row_kernels_scalar;
+		break;
 	}
+	row_isa = isa;
 	return 0;
 }
-	
-int open_simplex_noise_init_perm(struct osn_context *ctx, int16_t p[], int nelements)
+
+enum osn_isa open_simplex_noise_get_isa(void)
 {
-	int i, rc;
+	if (!row_kernels)
+		open_simplex_noise_set_isa(open_simplex_noise_best_isa());
+	return row_isa;
+}
+
+static struct osn_context *allocate_context(void)
+{
+	void *block = malloc(sizeof(struct osn_context) + CONTEXT_ALIGN - 1);
+	struct osn_context *ctx;
+
+	/* every row evaluation needs a context, so choose the kernels here */
+	if (!row_kernels)
+		open_simplex_noise_set_isa(open_simplex_noise_best_isa());
+	if (!block)
+		return NULL;
+	ctx = (struct osn_context *) (((uintptr_t) block + CONTEXT_ALIGN - 1) & ~(uintptr_t) (CONTEXT_ALIGN - 1));
+	ctx->block = block;
+	ctx->select4 = OSN_SELECT_BRANCH;
+	return ctx;
+}
+
+/* The n components of gradient g as a word of bytes, see struct osn_context. */
+static uint32_t gradient_word(const signed char *g, int n)
+{
+	uint32_t word = 0;
+	int i;
+
+	for (i = 0; i < n; i++)
+		word |= (uint32_t) (uint8_t) g[i] << (8 * i);
+	return word;
+}
+
+/* Fills the permutation and the precombined gradient tables from p[0..255]. */
+static void combine_perm(struct osn_context *ctx, const int16_t p[])
+{
+	int i;
 
-	rc = allocate_perm(ctx, nelements, 256);
-	if (rc)
-		return rc;
-	memcpy(ctx->perm, p, sizeof(*ctx->perm) * nelements);
-		
 	for (i = 0; i < 256; i++) {
+		ctx->perm[i] = (uint8_t) p[i];
+		ctx->permGradIndex2D[i] = (uint8_t) (p[i] & 0x0E);
 		/* Since 3D has 24 gradients, simple bitmask won't work, so precompute modulo array. */
-		ctx->permGradIndex3D[i] = (int16_t)((ctx->perm[i] % (ARRAYSIZE(gradients3D) / 3)) * 3);
+		ctx->permGradIndex3D[i] = (uint8_t) ((p[i] % (ARRAYSIZE(gradients3D) / 3)) * 3);
+		ctx->permGradIndex4D[i] = (uint8_t) (p[i] & 0xFC);
+		ctx->permGrad3D[i] = gradient_word(&gradients3D[ctx->permGradIndex3D[i]], 3);
+		ctx->permGrad4D[i] = gradient_word(&gradients4D[ctx->permGradIndex4D[i]], 4);
 	}
+}
+
+int open_simplex_noise_init_perm(struct osn_context *ctx, int16_t p[], int nelements)
+{
+	if (nelements < 256)
+		return -EINVAL;
+	combine_perm(ctx, p);
 	return 0;
 }
 
@@ -167,27 +280,14 @@ int open_simplex_noise_init_perm(struct osn_context *ctx, int16_t p[], int nelem
  */
 int open_simplex_noise(int64_t seed, struct osn_context **ctx)
 {
-	int rc;
 	int16_t source[256];
+	int16_t perm[256];
 	int i;
-	int16_t *perm;
-	int16_t *permGradIndex3D;
 	int r;
 
-	*ctx = (struct osn_context *) malloc(sizeof(**ctx));
+	*ctx = allocate_context();
 	if (!(*ctx))
 		return -ENOMEM;
-	(*ctx)->perm = NULL;
-	(*ctx)->permGradIndex3D = NULL;
-
-	rc = allocate_perm(*ctx, 256, 256);
-	if (rc) {
-		free(*ctx);
-		return rc;
-	}
-
-	perm = (*ctx)->perm;
-	permGradIndex3D = (*ctx)->permGradIndex3D;
 
 	for (i = 0; i < 256; i++)
 		source[i] = (int16_t) i;
@@ -200,9 +300,9 @@ int open_simplex_noise(int64_t seed, struct osn_context **ctx)
 		if (r < 0)
 			r += (i + 1);
 		perm[i] = source[r];
-		permGradIndex3D[i] = (short)((perm[i] % (ARRAYSIZE(gradients3D) / 3)) * 3);
 		source[r] = source[i];
 	}
+	combine_perm(*ctx, perm);
 	return 0;
 }
 
@@ -210,19 +310,53 @@ void open_simplex_noise_free(struct osn_context *ctx)
 {
 	if (!ctx)
 		return;
-	if (ctx->perm) {
-		free(ctx->perm);
-		ctx->perm = NULL;	
-	}
-	if (ctx->permGradIndex3D) {
-		free(ctx->permGradIndex3D);
-		ctx->permGradIndex3D = NULL;
+	free(ctx->block);
+}
+
+void open_simplex_noise4_select(struct osn_context *ctx, enum osn_select select)
+{
+	ctx->select4 = select;
+}
+
+int open_simplex_noise4_slice(const struct osn_context *ctx, double w, double sum_min, double sum_max, struct osn_slice **slice)
+{
+	int wsb_min, wsb_max, k, h;
+
+	/*
+	 * ws = w + (x + y + z + w) * STRETCH falls as x + y + z grows; one more
+	 * lattice w either side absorbs rounding (and the float forms), and the
+	 * vertices of a super-cell reach from wsb - 1 to wsb + 2.
+	 */
+	wsb_min = (int) floor(w + (sum_max + w) * STRETCH_CONSTANT_4D) - 1;
+	wsb_max = (int) floor(w + (sum_min + w) * STRETCH_CONSTANT_4D) + 1;
+	if (wsb_max < wsb_min) {
+		k = wsb_min;
+		wsb_min = wsb_max;
+		wsb_max = k;
 	}
-	free(ctx);
+
+	*slice = (struct osn_slice *) malloc(sizeof(**slice) + ((size_t) (wsb_max - wsb_min + 4) << 10));
+	if (!(*slice))
+		return -ENOMEM;
+	(*slice)->ctx = ctx;
+	(*slice)->w = w;
+	(*slice)->wsv_min = wsb_min - 1;
+	(*slice)->wsv_count = wsb_max - wsb_min + 4;
+	(*slice)->permGrad4D = (uint32_t *) (*slice + 1);
+	for (k = 0; k < (*slice)->wsv_count; k++)
+		for (h = 0; h < 256; h++)
+			(*slice)->permGrad4D[k << 8 | h] = ctx->permGrad4D[(ctx->perm[h] + (*slice)->wsv_min + k) & 0xFF];
+	return 0;
 }
+
+void open_simplex_noise4_slice_free(struct osn_slice *slice)
+{
+	free(slice);
+}
+
 	
 /* 2D OpenSimplex (Simplectic) Noise. */
-double open_simplex_noise2(struct osn_context *ctx, double x, double y) 
+double open_simplex_noise2(const struct osn_context *ctx, double x, double y) 
 {
 	
 	/* Place input coordinates onto grid. */
@@ -346,1906 +480,201 @@ double open_simplex_noise2(struct osn_context *ctx, double x, double y)
 	
 	return value / NORM_CONSTANT_2D;
 }
-	
+#endif
+
 /*
- * 3D OpenSimplex (Simplectic) Noise
+ * 3D and 4D noise in double precision, then again in single precision.  The
+ * float family uses float arithmetic throughout, which doubles the number of
+ * vector lanes of the row forms.  The gathers of hashes and gradients still
+ * cost per lane, so float rows evaluate about 1.5 to 2 times as many points
+ * per second as double rows, not twice as many; the scalar kernels gain
+ * nothing.
  */
-double open_simplex_noise3(struct osn_context *ctx, double x, double y, double z)
-{
-
-	/* Place input coordinates on simplectic honeycomb. */
-	double stretchOffset = (x + y + z) * STRETCH_CONSTANT_3D;
-	double xs = x + stretchOffset;
-	double ys = y + stretchOffset;
-	double zs = z + stretchOffset;
-	
-	/* Floor to get simplectic honeycomb coordinates of rhombohedron (stretched cube) super-cell origin. */
-	int xsb = fastFloor(xs);
-	int ysb = fastFloor(ys);
-	int zsb = fastFloor(zs);
-	
-	/* Skew out to get actual coordinates of rhombohedron origin. We'll need these later. */
-	double squishOffset = (xsb + ysb + zsb) * SQUISH_CONSTANT_3D;
-	double xb = xsb + squishOffset;
-	double yb = ysb + squishOffset;
-	double zb = zsb + squishOffset;
-	
-	/* Compute simplectic honeycomb coordinates relative to rhombohedral origin. */
-	double xins = xs - xsb;
-	double yins = ys - ysb;
-	double zins = zs - zsb;
-	
-	/* Sum those together to get a value that determines which region we're in. */
-	double inSum = xins + yins + zins;
-
-	/* Positions relative to origin point. */
-	double dx0 = x - xb;
-	double dy0 = y - yb;
-	double dz0 = z - zb;
-	
-	/* We'll be defining these inside the next block and using them afterwards. */
-	double dx_ext0, dy_ext0, dz_ext0;
-	double dx_ext1, dy_ext1, dz_ext1;
-	int xsv_ext0, ysv_ext0, zsv_ext0;
-	int xsv_ext1, ysv_ext1, zsv_ext1;
-
-	double wins;
-	int8_t c, c1, c2;
-	int8_t aPoint, bPoint;
-	double aScore, bScore;
-	int aIsFurtherSide;
-	int bIsFurtherSide;
-	double p1, p2, p3;
-	double score;
-	double attn0, attn1, attn2, attn3, attn4, attn5, attn6;
-	double dx1, dy1, dz1;
-	double dx2, dy2, dz2;
-	double dx3, dy3, dz3;
-	double dx4, dy4, dz4;
-	double dx5, dy5, dz5;
-	double dx6, dy6, dz6;
-	double attn_ext0, attn_ext1;
-	
-	double value = 0;
-	if (inSum <= 1) { /* We're inside the tetrahedron (3-Simplex) at (0,0,0) */
-		
-		/* Determine which two of (0,0,1), (0,1,0), (1,0,0) are closest. */
-		aPoint = 0x01;
-		aScore = xins;
-		bPoint = 0x02;
-		bScore = yins;
-		if (aScore >= bScore && zins > bScore) {
-			bScore = zins;
-			bPoint = 0x04;
-		} else if (aScore < bScore && zins > aScore) {
-			aScore = zins;
-			aPoint = 0x04;
-		}
-		
-		/* Now we determine the two lattice points not part of the tetrahedron that may contribute.
-		   This depends on the closest two tetrahedral vertices, including (0,0,0) */
-		wins = 1 - inSum;
-		if (wins > aScore || wins > bScore) { /* (0,0,0) is one of the closest two tetrahedral vertices. */
-			c = (bScore > aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
-			
-			if ((c & 0x01) == 0) {
-				xsv_ext0 = xsb - 1;
-				xsv_ext1 = xsb;
-				dx_ext0 = dx0 + 1;
-				dx_ext1 = dx0;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb + 1;
-				dx_ext0 = dx_ext1 = dx0 - 1;
-			}
-
-			if ((c & 0x02) == 0) {
-				ysv_ext0 = ysv_ext1 = ysb;
-				dy_ext0 = dy_ext1 = dy0;
-				if ((c & 0x01) == 0) {
-					ysv_ext1 -= 1;
-					dy_ext1 += 1;
-				} else {
-					ysv_ext0 -= 1;
-					dy_ext0 += 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy0 - 1;
-			}
-
-			if ((c & 0x04) == 0) {
-				zsv_ext0 = zsb;
-				zsv_ext1 = zsb - 1;
-				dz_ext0 = dz0;
-				dz_ext1 = dz0 + 1;
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb + 1;
-				dz_ext0 = dz_ext1 = dz0 - 1;
-			}
-		} else { /* (0,0,0) is not one of the closest two tetrahedral vertices. */
-			c = (int8_t)(aPoint | bPoint); /* Our two extra vertices are determined by the closest two. */
-			
-			if ((c & 0x01) == 0) {
-				xsv_ext0 = xsb;
-				xsv_ext1 = xsb - 1;
-				dx_ext0 = dx0 - 2 * SQUISH_CONSTANT_3D;
-				dx_ext1 = dx0 + 1 - SQUISH_CONSTANT_3D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb + 1;
-				dx_ext0 = dx0 - 1 - 2 * SQUISH_CONSTANT_3D;
-				dx_ext1 = dx0 - 1 - SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x02) == 0) {
-				ysv_ext0 = ysb;
-				ysv_ext1 = ysb - 1;
-				dy_ext0 = dy0 - 2 * SQUISH_CONSTANT_3D;
-				dy_ext1 = dy0 + 1 - SQUISH_CONSTANT_3D;
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb + 1;
-				dy_ext0 = dy0 - 1 - 2 * SQUISH_CONSTANT_3D;
-				dy_ext1 = dy0 - 1 - SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x04) == 0) {
-				zsv_ext0 = zsb;
-				zsv_ext1 = zsb - 1;
-				dz_ext0 = dz0 - 2 * SQUISH_CONSTANT_3D;
-				dz_ext1 = dz0 + 1 - SQUISH_CONSTANT_3D;
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb + 1;
-				dz_ext0 = dz0 - 1 - 2 * SQUISH_CONSTANT_3D;
-				dz_ext1 = dz0 - 1 - SQUISH_CONSTANT_3D;
-			}
-		}
-
-		/* Contribution (0,0,0) */
-		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0;
-		if (attn0 > 0) {
-			attn0 *= attn0;
-			value += attn0 * attn0 * extrapolate3(ctx, xsb + 0, ysb + 0, zsb + 0, dx0, dy0, dz0);
-		}
-
-		/* Contribution (1,0,0) */
-		dx1 = dx0 - 1 - SQUISH_CONSTANT_3D;
-		dy1 = dy0 - 0 - SQUISH_CONSTANT_3D;
-		dz1 = dz0 - 0 - SQUISH_CONSTANT_3D;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate3(ctx, xsb + 1, ysb + 0, zsb + 0, dx1, dy1, dz1);
-		}
-
-		/* Contribution (0,1,0) */
-		dx2 = dx0 - 0 - SQUISH_CONSTANT_3D;
-		dy2 = dy0 - 1 - SQUISH_CONSTANT_3D;
-		dz2 = dz1;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate3(ctx, xsb + 0, ysb + 1, zsb + 0, dx2, dy2, dz2);
-		}
-
-		/* Contribution (0,0,1) */
-		dx3 = dx2;
-		dy3 = dy1;
-		dz3 = dz0 - 1 - SQUISH_CONSTANT_3D;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate3(ctx, xsb + 0, ysb + 0, zsb + 1, dx3, dy3, dz3);
-		}
-	} else if (inSum >= 2) { /* We're inside the tetrahedron (3-Simplex) at (1,1,1) */
-	
-		/* Determine which two tetrahedral vertices are the closest, out of (1,1,0), (1,0,1), (0,1,1) but not (1,1,1). */
-		aPoint = 0x06;
-		aScore = xins;
-		bPoint = 0x05;
-		bScore = yins;
-		if (aScore <= bScore && zins < bScore) {
-			bScore = zins;
-			bPoint = 0x03;
-		} else if (aScore > bScore && zins < aScore) {
-			aScore = zins;
-			aPoint = 0x03;
-		}
-		
-		/* Now we determine the two lattice points not part of the tetrahedron that may contribute.
-		   This depends on the closest two tetrahedral vertices, including (1,1,1) */
-		wins = 3 - inSum;
-		if (wins < aScore || wins < bScore) { /* (1,1,1) is one of the closest two tetrahedral vertices. */
-			c = (bScore < aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
-			
-			if ((c & 0x01) != 0) {
-				xsv_ext0 = xsb + 2;
-				xsv_ext1 = xsb + 1;
-				dx_ext0 = dx0 - 2 - 3 * SQUISH_CONSTANT_3D;
-				dx_ext1 = dx0 - 1 - 3 * SQUISH_CONSTANT_3D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb;
-				dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x02) != 0) {
-				ysv_ext0 = ysv_ext1 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_CONSTANT_3D;
-				if ((c & 0x01) != 0) {
-					ysv_ext1 += 1;
-					dy_ext1 -= 1;
-				} else {
-					ysv_ext0 += 1;
-					dy_ext0 -= 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb;
-				dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x04) != 0) {
-				zsv_ext0 = zsb + 1;
-				zsv_ext1 = zsb + 2;
-				dz_ext0 = dz0 - 1 - 3 * SQUISH_CONSTANT_3D;
-				dz_ext1 = dz0 - 2 - 3 * SQUISH_CONSTANT_3D;
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb;
-				dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_CONSTANT_3D;
-			}
-		} else { /* (1,1,1) is not one of the closest two tetrahedral vertices. */
-			c = (int8_t)(aPoint & bPoint); /* Our two extra vertices are determined by the closest two. */
-			
-			if ((c & 0x01) != 0) {
-				xsv_ext0 = xsb + 1;
-				xsv_ext1 = xsb + 2;
-				dx_ext0 = dx0 - 1 - SQUISH_CONSTANT_3D;
-				dx_ext1 = dx0 - 2 - 2 * SQUISH_CONSTANT_3D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb;
-				dx_ext0 = dx0 - SQUISH_CONSTANT_3D;
-				dx_ext1 = dx0 - 2 * SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x02) != 0) {
-				ysv_ext0 = ysb + 1;
-				ysv_ext1 = ysb + 2;
-				dy_ext0 = dy0 - 1 - SQUISH_CONSTANT_3D;
-				dy_ext1 = dy0 - 2 - 2 * SQUISH_CONSTANT_3D;
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb;
-				dy_ext0 = dy0 - SQUISH_CONSTANT_3D;
-				dy_ext1 = dy0 - 2 * SQUISH_CONSTANT_3D;
-			}
-
-			if ((c & 0x04) != 0) {
-				zsv_ext0 = zsb + 1;
-				zsv_ext1 = zsb + 2;
-				dz_ext0 = dz0 - 1 - SQUISH_CONSTANT_3D;
-				dz_ext1 = dz0 - 2 - 2 * SQUISH_CONSTANT_3D;
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb;
-				dz_ext0 = dz0 - SQUISH_CONSTANT_3D;
-				dz_ext1 = dz0 - 2 * SQUISH_CONSTANT_3D;
-			}
-		}
-		
-		/* Contribution (1,1,0) */
-		dx3 = dx0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		dy3 = dy0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		dz3 = dz0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate3(ctx, xsb + 1, ysb + 1, zsb + 0, dx3, dy3, dz3);
-		}
-
-		/* Contribution (1,0,1) */
-		dx2 = dx3;
-		dy2 = dy0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		dz2 = dz0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate3(ctx, xsb + 1, ysb + 0, zsb + 1, dx2, dy2, dz2);
-		}
-
-		/* Contribution (0,1,1) */
-		dx1 = dx0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		dy1 = dy3;
-		dz1 = dz2;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate3(ctx, xsb + 0, ysb + 1, zsb + 1, dx1, dy1, dz1);
-		}
-
-		/* Contribution (1,1,1) */
-		dx0 = dx0 - 1 - 3 * SQUISH_CONSTANT_3D;
-		dy0 = dy0 - 1 - 3 * SQUISH_CONSTANT_3D;
-		dz0 = dz0 - 1 - 3 * SQUISH_CONSTANT_3D;
-		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0;
-		if (attn0 > 0) {
-			attn0 *= attn0;
-			value += attn0 * attn0 * extrapolate3(ctx, xsb + 1, ysb + 1, zsb + 1, dx0, dy0, dz0);
-		}
-	} else { /* We're inside the octahedron (Rectified 3-Simplex) in between.
-		        Decide between point (0,0,1) and (1,1,0) as closest */
-		p1 = xins + yins;
-		if (p1 > 1) {
-			aScore = p1 - 1;
-			aPoint = 0x03;
-			aIsFurtherSide = 1;
-		} else {
-			aScore = 1 - p1;
-			aPoint = 0x04;
-			aIsFurtherSide = 0;
-		}
-
-		/* Decide between point (0,1,0) and (1,0,1) as closest */
-		p2 = xins + zins;
-		if (p2 > 1) {
-			bScore = p2 - 1;
-			bPoint = 0x05;
-			bIsFurtherSide = 1;
-		} else {
-			bScore = 1 - p2;
-			bPoint = 0x02;
-			bIsFurtherSide = 0;
-		}
-		
-		/* The closest out of the two (1,0,0) and (0,1,1) will replace the furthest out of the two decided above, if closer. */
-		p3 = yins + zins;
-		if (p3 > 1) {
-			score = p3 - 1;
-			if (aScore <= bScore && aScore < score) {
-				aScore = score;
-				aPoint = 0x06;
-				aIsFurtherSide = 1;
-			} else if (aScore > bScore && bScore < score) {
-				bScore = score;
-				bPoint = 0x06;
-				bIsFurtherSide = 1;
-			}
-		} else {
-			score = 1 - p3;
-			if (aScore <= bScore && aScore < score) {
-				aScore = score;
-				aPoint = 0x01;
-				aIsFurtherSide = 0;
-			} else if (aScore > bScore && bScore < score) {
-				bScore = score;
-				bPoint = 0x01;
-				bIsFurtherSide = 0;
-			}
-		}
-		
-		/* Where each of the two closest points are determines how the extra two vertices are calculated. */
-		if (aIsFurtherSide == bIsFurtherSide) {
-			if (aIsFurtherSide) { /* Both closest points on (1,1,1) side */
-
-				/* One of the two extra points is (1,1,1) */
-				dx_ext0 = dx0 - 1 - 3 * SQUISH_CONSTANT_3D;
-				dy_ext0 = dy0 - 1 - 3 * SQUISH_CONSTANT_3D;
-				dz_ext0 = dz0 - 1 - 3 * SQUISH_CONSTANT_3D;
-				xsv_ext0 = xsb + 1;
-				ysv_ext0 = ysb + 1;
-				zsv_ext0 = zsb + 1;
-
-				/* Other extra point is based on the shared axis. */
-				c = (int8_t)(aPoint & bPoint);
-				if ((c & 0x01) != 0) {
-					dx_ext1 = dx0 - 2 - 2 * SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 - 2 * SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 - 2 * SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb + 2;
-					ysv_ext1 = ysb;
-					zsv_ext1 = zsb;
-				} else if ((c & 0x02) != 0) {
-					dx_ext1 = dx0 - 2 * SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 - 2 - 2 * SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 - 2 * SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb;
-					ysv_ext1 = ysb + 2;
-					zsv_ext1 = zsb;
-				} else {
-					dx_ext1 = dx0 - 2 * SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 - 2 * SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 - 2 - 2 * SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb;
-					ysv_ext1 = ysb;
-					zsv_ext1 = zsb + 2;
-				}
-			} else { /* Both closest points on (0,0,0) side */
-
-				/* One of the two extra points is (0,0,0) */
-				dx_ext0 = dx0;
-				dy_ext0 = dy0;
-				dz_ext0 = dz0;
-				xsv_ext0 = xsb;
-				ysv_ext0 = ysb;
-				zsv_ext0 = zsb;
-
-				/* Other extra point is based on the omitted axis. */
-				c = (int8_t)(aPoint | bPoint);
-				if ((c & 0x01) == 0) {
-					dx_ext1 = dx0 + 1 - SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 - 1 - SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 - 1 - SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb - 1;
-					ysv_ext1 = ysb + 1;
-					zsv_ext1 = zsb + 1;
-				} else if ((c & 0x02) == 0) {
-					dx_ext1 = dx0 - 1 - SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 + 1 - SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 - 1 - SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb + 1;
-					ysv_ext1 = ysb - 1;
-					zsv_ext1 = zsb + 1;
-				} else {
-					dx_ext1 = dx0 - 1 - SQUISH_CONSTANT_3D;
-					dy_ext1 = dy0 - 1 - SQUISH_CONSTANT_3D;
-					dz_ext1 = dz0 + 1 - SQUISH_CONSTANT_3D;
-					xsv_ext1 = xsb + 1;
-					ysv_ext1 = ysb + 1;
-					zsv_ext1 = zsb - 1;
-				}
-			}
-		} else { /* One point on (0,0,0) side, one point on (1,1,1) side */
-			if (aIsFurtherSide) {
-				c1 = aPoint;
-				c2 = bPoint;
-			} else {
-				c1 = bPoint;
-				c2 = aPoint;
-			}
-
-			/* One contribution is a permutation of (1,1,-1) */
-			if ((c1 & 0x01) == 0) {
-				dx_ext0 = dx0 + 1 - SQUISH_CONSTANT_3D;
-				dy_ext0 = dy0 - 1 - SQUISH_CONSTANT_3D;
-				dz_ext0 = dz0 - 1 - SQUISH_CONSTANT_3D;
-				xsv_ext0 = xsb - 1;
-				ysv_ext0 = ysb + 1;
-				zsv_ext0 = zsb + 1;
-			} else if ((c1 & 0x02) == 0) {
-				dx_ext0 = dx0 - 1 - SQUISH_CONSTANT_3D;
-				dy_ext0 = dy0 + 1 - SQUISH_CONSTANT_3D;
-				dz_ext0 = dz0 - 1 - SQUISH_CONSTANT_3D;
-				xsv_ext0 = xsb + 1;
-				ysv_ext0 = ysb - 1;
-				zsv_ext0 = zsb + 1;
-			} else {
-				dx_ext0 = dx0 - 1 - SQUISH_CONSTANT_3D;
-				dy_ext0 = dy0 - 1 - SQUISH_CONSTANT_3D;
-				dz_ext0 = dz0 + 1 - SQUISH_CONSTANT_3D;
-				xsv_ext0 = xsb + 1;
-				ysv_ext0 = ysb + 1;
-				zsv_ext0 = zsb - 1;
-			}
-
-			/* One contribution is a permutation of (0,0,2) */
-			dx_ext1 = dx0 - 2 * SQUISH_CONSTANT_3D;
-			dy_ext1 = dy0 - 2 * SQUISH_CONSTANT_3D;
-			dz_ext1 = dz0 - 2 * SQUISH_CONSTANT_3D;
-			xsv_ext1 = xsb;
-			ysv_ext1 = ysb;
-			zsv_ext1 = zsb;
-			if ((c2 & 0x01) != 0) {
-				dx_ext1 -= 2;
-				xsv_ext1 += 2;
-			} else if ((c2 & 0x02) != 0) {
-				dy_ext1 -= 2;
-				ysv_ext1 += 2;
-			} else {
-				dz_ext1 -= 2;
-				zsv_ext1 += 2;
-			}
-		}
-
-		/* Contribution (1,0,0) */
-		dx1 = dx0 - 1 - SQUISH_CONSTANT_3D;
-		dy1 = dy0 - 0 - SQUISH_CONSTANT_3D;
-		dz1 = dz0 - 0 - SQUISH_CONSTANT_3D;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate3(ctx, xsb + 1, ysb + 0, zsb + 0, dx1, dy1, dz1);
-		}
-
-		/* Contribution (0,1,0) */
-		dx2 = dx0 - 0 - SQUISH_CONSTANT_3D;
-		dy2 = dy0 - 1 - SQUISH_CONSTANT_3D;
-		dz2 = dz1;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate3(ctx, xsb + 0, ysb + 1, zsb + 0, dx2, dy2, dz2);
-		}
-
-		/* Contribution (0,0,1) */
-		dx3 = dx2;
-		dy3 = dy1;
-		dz3 = dz0 - 1 - SQUISH_CONSTANT_3D;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate3(ctx, xsb + 0, ysb + 0, zsb + 1, dx3, dy3, dz3);
-		}
-
-		/* Contribution (1,1,0) */
-		dx4 = dx0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		dy4 = dy0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		dz4 = dz0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4;
-		if (attn4 > 0) {
-			attn4 *= attn4;
-			value += attn4 * attn4 * extrapolate3(ctx, xsb + 1, ysb + 1, zsb + 0, dx4, dy4, dz4);
-		}
-
-		/* Contribution (1,0,1) */
-		dx5 = dx4;
-		dy5 = dy0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		dz5 = dz0 - 1 - 2 * SQUISH_CONSTANT_3D;
-		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5;
-		if (attn5 > 0) {
-			attn5 *= attn5;
-			value += attn5 * attn5 * extrapolate3(ctx, xsb + 1, ysb + 0, zsb + 1, dx5, dy5, dz5);
-		}
-
-		/* Contribution (0,1,1) */
-		dx6 = dx0 - 0 - 2 * SQUISH_CONSTANT_3D;
-		dy6 = dy4;
-		dz6 = dz5;
-		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6;
-		if (attn6 > 0) {
-			attn6 *= attn6;
-			value += attn6 * attn6 * extrapolate3(ctx, xsb + 0, ysb + 1, zsb + 1, dx6, dy6, dz6);
-		}
-	}
-
-	/* First extra vertex */
-	attn_ext0 = 2 - dx_ext0 * dx_ext0 - dy_ext0 * dy_ext0 - dz_ext0 * dz_ext0;
-	if (attn_ext0 > 0)
-	{
-		attn_ext0 *= attn_ext0;
-		value += attn_ext0 * attn_ext0 * extrapolate3(ctx, xsv_ext0, ysv_ext0, zsv_ext0, dx_ext0, dy_ext0, dz_ext0);
-	}
+#if OSN_ISA_LEVEL == 2
+#define OSN_ISA_SUFFIX _avx512
+#elif OSN_ISA_LEVEL == 1
+#define OSN_ISA_SUFFIX _avx2
+#else
+#define OSN_ISA_SUFFIX _scalar
+#endif
+#define OSN_PASTE(a, b) a##b
+#define OSN_ISA_NAME(name, isa) OSN_PASTE(name, isa)
+
+#define OSN_REAL double
+#define OSN_NAME(base, tail) base##tail
+#if OSN_ISA_LEVEL == 2
+#define ROW_LANES 8
+#define vreal __m512d
+#define vint __m256i
+#define vmask __mmask8
+#define vload(p) _mm512_loadu_pd(p)
+#define vstore(p, v) _mm512_storeu_pd((p), (v))
+#define vset1(d) _mm512_set1_pd(d)
+#define vadd(a, b) _mm512_add_pd((a), (b))
+#define vsub(a, b) _mm512_sub_pd((a), (b))
+#define vmul(a, b) _mm512_mul_pd((a), (b))
+#define vdiv(a, b) _mm512_div_pd((a), (b))
+#define vmin(a, b) _mm512_min_pd((a), (b))
+#define vmax(a, b) _mm512_max_pd((a), (b))
+#define vfloor(v) _mm512_cvtpd_epi32(_mm512_roundscale_pd((v), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC))
+#define vrtoi(v) _mm512_cvttpd_epi32(v)
+#define vitor(v) _mm512_cvtepi32_pd(v)
+#define vcmp(a, b, pred) _mm512_cmp_pd_mask((a), (b), (pred))
+#define vblend(m, a, b) _mm512_mask_blend_pd((m), (b), (a))
+#define vmand(a, b) ((vmask) ((a) & (b)))
+#define vmandn(a, b) ((vmask) (~(a) & (b)))
+#define vmor(a, b) ((vmask) ((a) | (b)))
+#define vmany(m) ((m) != 0)
+#define viset1(i) _mm256_set1_epi32(i)
+#define viadd(a, b) _mm256_add_epi32((a), (b))
+#define visub(a, b) _mm256_sub_epi32((a), (b))
+#define viand(a, b) _mm256_and_si256((a), (b))
+#define vimul(a, b) _mm256_mullo_epi32((a), (b))
+#define visll(a, n) _mm256_slli_epi32((a), (n))
+#define visra(a, n) _mm256_srai_epi32((a), (n))
+#define vigather(p, i) _mm256_i32gather_epi32((const int *) (const void *) (p), (i), 1)
+#elif OSN_ISA_LEVEL == 1
+#define ROW_LANES 4
+#define vreal __m256d
+#define vint __m128i
+#define vmask __m256d
+#define vload(p) _mm256_loadu_pd(p)
+#define vstore(p, v) _mm256_storeu_pd((p), (v))
+#define vset1(d) _mm256_set1_pd(d)
+#define vadd(a, b) _mm256_add_pd((a), (b))
+#define vsub(a, b) _mm256_sub_pd((a), (b))
+#define vmul(a, b) _mm256_mul_pd((a), (b))
+#define vdiv(a, b) _mm256_div_pd((a), (b))
+#define vmin(a, b) _mm256_min_pd((a), (b))
+#define vmax(a, b) _mm256_max_pd((a), (b))
+#define vfloor(v) _mm256_cvtpd_epi32(_mm256_floor_pd(v))
+#define vrtoi(v) _mm256_cvttpd_epi32(v)
+#define vitor(v) _mm256_cvtepi32_pd(v)
+#define vcmp(a, b, pred) _mm256_cmp_pd((a), (b), (pred))
+#define vblend(m, a, b) _mm256_blendv_pd((b), (a), (m))
+#define vmand(a, b) _mm256_and_pd((a), (b))
+#define vmandn(a, b) _mm256_andnot_pd((a), (b))
+#define vmor(a, b) _mm256_or_pd((a), (b))
+#define vmany(m) _mm256_movemask_pd(m)
+#define viset1(i) _mm_set1_epi32(i)
+#define viadd(a, b) _mm_add_epi32((a), (b))
+#define visub(a, b) _mm_sub_epi32((a), (b))
+#define viand(a, b) _mm_and_si128((a), (b))
+#define vimul(a, b) _mm_mullo_epi32((a), (b))
+#define visll(a, n) _mm_slli_epi32((a), (n))
+#define visra(a, n) _mm_srai_epi32((a), (n))
+#define vigather(p, i) _mm_i32gather_epi32((const int *) (const void *) (p), (i), 1)
+#else
+#define ROW_LANES 1
+#endif
+#include "open_simplex_noise_impl.h"
+
+#define OSN_REAL float
+#define OSN_NAME(base, tail) base##f##tail
+#if OSN_ISA_LEVEL == 2
+#define ROW_LANES 16
+#define vreal __m512
+#define vint __m512i
+#define vmask __mmask16
+#define vload(p) _mm512_loadu_ps(p)
+#define vstore(p, v) _mm512_storeu_ps((p), (v))
+#define vset1(d) _mm512_set1_ps(d)
+#define vadd(a, b) _mm512_add_ps((a), (b))
+#define vsub(a, b) _mm512_sub_ps((a), (b))
+#define vmul(a, b) _mm512_mul_ps((a), (b))
+#define vdiv(a, b) _mm512_div_ps((a), (b))
+#define vmin(a, b) _mm512_min_ps((a), (b))
+#define vmax(a, b) _mm512_max_ps((a), (b))
+#define vfloor(v) _mm512_cvtps_epi32(_mm512_roundscale_ps((v), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC))
+#define vrtoi(v) _mm512_cvttps_epi32(v)
+#define vitor(v) _mm512_cvtepi32_ps(v)
+#define vcmp(a, b, pred) _mm512_cmp_ps_mask((a), (b), (pred))
+#define vblend(m, a, b) _mm512_mask_blend_ps((m), (b), (a))
+#define vmand(a, b) ((vmask) ((a) & (b)))
+#define vmandn(a, b) ((vmask) (~(a) & (b)))
+#define vmor(a, b) ((vmask) ((a) | (b)))
+#define vmany(m) ((m) != 0)
+#define viset1(i) _mm512_set1_epi32(i)
+#define viadd(a, b) _mm512_add_epi32((a), (b))
+#define visub(a, b) _mm512_sub_epi32((a), (b))
+#define viand(a, b) _mm512_and_si512((a), (b))
+#define vimul(a, b) _mm512_mullo_epi32((a), (b))
+#define visll(a, n) _mm512_slli_epi32((a), (n))
+#define visra(a, n) _mm512_srai_epi32((a), (n))
+#define vigather(p, i) _mm512_i32gather_epi32((i), (const void *) (p), 1)
+#elif OSN_ISA_LEVEL == 1
+#define ROW_LANES 8
+#define vreal __m256
+#define vint __m256i
+#define vmask __m256
+#define vload(p) _mm256_loadu_ps(p)
+#define vstore(p, v) _mm256_storeu_ps((p), (v))
+#define vset1(d) _mm256_set1_ps(d)
+#define vadd(a, b) _mm256_add_ps((a), (b))
+#define vsub(a, b) _mm256_sub_ps((a), (b))
+#define vmul(a, b) _mm256_mul_ps((a), (b))
+#define vdiv(a, b) _mm256_div_ps((a), (b))
+#define vmin(a, b) _mm256_min_ps((a), (b))
+#define vmax(a, b) _mm256_max_ps((a), (b))
+#define vfloor(v) _mm256_cvtps_epi32(_mm256_floor_ps(v))
+#define vrtoi(v) _mm256_cvttps_epi32(v)
+#define vitor(v) _mm256_cvtepi32_ps(v)
+#define vcmp(a, b, pred) _mm256_cmp_ps((a), (b), (pred))
+#define vblend(m, a, b) _mm256_blendv_ps((b), (a), (m))
+#define vmand(a, b) _mm256_and_ps((a), (b))
+#define vmandn(a, b) _mm256_andnot_ps((a), (b))
+#define vmor(a, b) _mm256_or_ps((a), (b))
+#define vmany(m) _mm256_movemask_ps(m)
+#define viset1(i) _mm256_set1_epi32(i)
+#define viadd(a, b) _mm256_add_epi32((a), (b))
+#define visub(a, b) _mm256_sub_epi32((a), (b))
+#define viand(a, b) _mm256_and_si256((a), (b))
+#define vimul(a, b) _mm256_mullo_epi32((a), (b))
+#define visll(a, n) _mm256_slli_epi32((a), (n))
+#define visra(a, n) _mm256_srai_epi32((a), (n))
+#define vigather(p, i) _mm256_i32gather_epi32((const int *) (const void *) (p), (i), 1)
+#else
+#define ROW_LANES 1
+#endif
+#include "open_simplex_noise_impl.h"
+
+const struct osn_row_kernels OSN_ISA_NAME(osn_row_kernels, OSN_ISA_SUFFIX) = {
+	isa_noise3_row,
+	isa_noise4_row,
+	isa_noise3f_row,
+	isa_noise4f_row,
+	isa_noise4_slice_row,
+	isa_noise4f_slice_row,
+};
 
-	/* Second extra vertex */
-	attn_ext1 = 2 - dx_ext1 * dx_ext1 - dy_ext1 * dy_ext1 - dz_ext1 * dz_ext1;
-	if (attn_ext1 > 0)
-	{
-		attn_ext1 *= attn_ext1;
-		value += attn_ext1 * attn_ext1 * extrapolate3(ctx, xsv_ext1, ysv_ext1, zsv_ext1, dx_ext1, dy_ext1, dz_ext1);
-	}
-	
-	return value / NORM_CONSTANT_3D;
-}
-	
-/* 
- * 4D OpenSimplex (Simplectic) Noise.
- */
-double open_simplex_noise4(struct osn_context *ctx, double x, double y, double z, double w)
+#if OSN_ISA_LEVEL == 0
+void open_simplex_noise3_row(const struct osn_context *ctx, const double *x, int n, double y, double z, double *out)
 {
-	double uins;
-	double dx1, dy1, dz1, dw1;
-	double dx2, dy2, dz2, dw2;
-	double dx3, dy3, dz3, dw3;
-	double dx4, dy4, dz4, dw4;
-	double dx5, dy5, dz5, dw5;
-	double dx6, dy6, dz6, dw6;
-	double dx7, dy7, dz7, dw7;
-	double dx8, dy8, dz8, dw8;
-	double dx9, dy9, dz9, dw9;
-	double dx10, dy10, dz10, dw10;
-	double attn0, attn1, attn2, attn3, attn4;
-	double attn5, attn6, attn7, attn8, attn9, attn10;
-	double attn_ext0, attn_ext1, attn_ext2;
-	int8_t c, c1, c2;
-	int8_t aPoint, bPoint;
-	double aScore, bScore;
-	int aIsBiggerSide;
-	int bIsBiggerSide;
-	double p1, p2, p3, p4;
-	double score;
-
-	/* Place input coordinates on simplectic honeycomb. */
-	double stretchOffset = (x + y + z + w) * STRETCH_CONSTANT_4D;
-	double xs = x + stretchOffset;
-	double ys = y + stretchOffset;
-	double zs = z + stretchOffset;
-	double ws = w + stretchOffset;
-	
-	/* Floor to get simplectic honeycomb coordinates of rhombo-hypercube super-cell origin. */
-	int xsb = fastFloor(xs);
-	int ysb = fastFloor(ys);
-	int zsb = fastFloor(zs);
-	int wsb = fastFloor(ws);
-	
-	/* Skew out to get actual coordinates of stretched rhombo-hypercube origin. We'll need these later. */
-	double squishOffset = (xsb + ysb + zsb + wsb) * SQUISH_CONSTANT_4D;
-	double xb = xsb + squishOffset;
-	double yb = ysb + squishOffset;
-	double zb = zsb + squishOffset;
-	double wb = wsb + squishOffset;
-	
-	/* Compute simplectic honeycomb coordinates relative to rhombo-hypercube origin. */
-	double xins = xs - xsb;
-	double yins = ys - ysb;
-	double zins = zs - zsb;
-	double wins = ws - wsb;
-	
-	/* Sum those together to get a value that determines which region we're in. */
-	double inSum = xins + yins + zins + wins;
-
-	/* Positions relative to origin point. */
-	double dx0 = x - xb;
-	double dy0 = y - yb;
-	double dz0 = z - zb;
-	double dw0 = w - wb;
-	
-	/* We'll be defining these inside the next block and using them afterwards. */
-	double dx_ext0, dy_ext0, dz_ext0, dw_ext0;
-	double dx_ext1, dy_ext1, dz_ext1, dw_ext1;
-	double dx_ext2, dy_ext2, dz_ext2, dw_ext2;
-	int xsv_ext0, ysv_ext0, zsv_ext0, wsv_ext0;
-	int xsv_ext1, ysv_ext1, zsv_ext1, wsv_ext1;
-	int xsv_ext2, ysv_ext2, zsv_ext2, wsv_ext2;
-	
-	double value = 0;
-	if (inSum <= 1) { /* We're inside the pentachoron (4-Simplex) at (0,0,0,0) */
-
-		/* Determine which two of (0,0,0,1), (0,0,1,0), (0,1,0,0), (1,0,0,0) are closest. */
-		aPoint = 0x01;
-		aScore = xins;
-		bPoint = 0x02;
-		bScore = yins;
-		if (aScore >= bScore && zins > bScore) {
-			bScore = zins;
-			bPoint = 0x04;
-		} else if (aScore < bScore && zins > aScore) {
-			aScore = zins;
-			aPoint = 0x04;
-		}
-		if (aScore >= bScore && wins > bScore) {
-			bScore = wins;
-			bPoint = 0x08;
-		} else if (aScore < bScore && wins > aScore) {
-			aScore = wins;
-			aPoint = 0x08;
-		}
-		
-		/* Now we determine the three lattice points not part of the pentachoron that may contribute.
-		   This depends on the closest two pentachoron vertices, including (0,0,0,0) */
-		uins = 1 - inSum;
-		if (uins > aScore || uins > bScore) { /* (0,0,0,0) is one of the closest two pentachoron vertices. */
-			c = (bScore > aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
-			if ((c & 0x01) == 0) {
-				xsv_ext0 = xsb - 1;
-				xsv_ext1 = xsv_ext2 = xsb;
-				dx_ext0 = dx0 + 1;
-				dx_ext1 = dx_ext2 = dx0;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb + 1;
-				dx_ext0 = dx_ext1 = dx_ext2 = dx0 - 1;
-			}
-
-			if ((c & 0x02) == 0) {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
-				dy_ext0 = dy_ext1 = dy_ext2 = dy0;
-				if ((c & 0x01) == 0x01) {
-					ysv_ext0 -= 1;
-					dy_ext0 += 1;
-				} else {
-					ysv_ext1 -= 1;
-					dy_ext1 += 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 1;
-			}
-			
-			if ((c & 0x04) == 0) {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
-				dz_ext0 = dz_ext1 = dz_ext2 = dz0;
-				if ((c & 0x03) != 0) {
-					if ((c & 0x03) == 0x03) {
-						zsv_ext0 -= 1;
-						dz_ext0 += 1;
-					} else {
-						zsv_ext1 -= 1;
-						dz_ext1 += 1;
-					}
-				} else {
-					zsv_ext2 -= 1;
-					dz_ext2 += 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
-				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 1;
-			}
-			
-			if ((c & 0x08) == 0) {
-				wsv_ext0 = wsv_ext1 = wsb;
-				wsv_ext2 = wsb - 1;
-				dw_ext0 = dw_ext1 = dw0;
-				dw_ext2 = dw0 + 1;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb + 1;
-				dw_ext0 = dw_ext1 = dw_ext2 = dw0 - 1;
-			}
-		} else { /* (0,0,0,0) is not one of the closest two pentachoron vertices. */
-			c = (int8_t)(aPoint | bPoint); /* Our three extra vertices are determined by the closest two. */
-			
-			if ((c & 0x01) == 0) {
-				xsv_ext0 = xsv_ext2 = xsb;
-				xsv_ext1 = xsb - 1;
-				dx_ext0 = dx0 - 2 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx0 + 1 - SQUISH_CONSTANT_4D;
-				dx_ext2 = dx0 - SQUISH_CONSTANT_4D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb + 1;
-				dx_ext0 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx_ext2 = dx0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x02) == 0) {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
-				dy_ext0 = dy0 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext1 = dy_ext2 = dy0 - SQUISH_CONSTANT_4D;
-				if ((c & 0x01) == 0x01) {
-					ysv_ext1 -= 1;
-					dy_ext1 += 1;
-				} else {
-					ysv_ext2 -= 1;
-					dy_ext2 += 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
-				dy_ext0 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext1 = dy_ext2 = dy0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x04) == 0) {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
-				dz_ext0 = dz0 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext1 = dz_ext2 = dz0 - SQUISH_CONSTANT_4D;
-				if ((c & 0x03) == 0x03) {
-					zsv_ext1 -= 1;
-					dz_ext1 += 1;
-				} else {
-					zsv_ext2 -= 1;
-					dz_ext2 += 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
-				dz_ext0 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext1 = dz_ext2 = dz0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x08) == 0) {
-				wsv_ext0 = wsv_ext1 = wsb;
-				wsv_ext2 = wsb - 1;
-				dw_ext0 = dw0 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw0 - SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 + 1 - SQUISH_CONSTANT_4D;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb + 1;
-				dw_ext0 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw_ext2 = dw0 - 1 - SQUISH_CONSTANT_4D;
-			}
-		}
-
-		/* Contribution (0,0,0,0) */
-		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0 - dw0 * dw0;
-		if (attn0 > 0) {
-			attn0 *= attn0;
-			value += attn0 * attn0 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 0, wsb + 0, dx0, dy0, dz0, dw0);
-		}
-
-		/* Contribution (1,0,0,0) */
-		dx1 = dx0 - 1 - SQUISH_CONSTANT_4D;
-		dy1 = dy0 - 0 - SQUISH_CONSTANT_4D;
-		dz1 = dz0 - 0 - SQUISH_CONSTANT_4D;
-		dw1 = dw0 - 0 - SQUISH_CONSTANT_4D;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 0, wsb + 0, dx1, dy1, dz1, dw1);
-		}
-
-		/* Contribution (0,1,0,0) */
-		dx2 = dx0 - 0 - SQUISH_CONSTANT_4D;
-		dy2 = dy0 - 1 - SQUISH_CONSTANT_4D;
-		dz2 = dz1;
-		dw2 = dw1;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 0, wsb + 0, dx2, dy2, dz2, dw2);
-		}
-
-		/* Contribution (0,0,1,0) */
-		dx3 = dx2;
-		dy3 = dy1;
-		dz3 = dz0 - 1 - SQUISH_CONSTANT_4D;
-		dw3 = dw1;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 1, wsb + 0, dx3, dy3, dz3, dw3);
-		}
-
-		/* Contribution (0,0,0,1) */
-		dx4 = dx2;
-		dy4 = dy1;
-		dz4 = dz1;
-		dw4 = dw0 - 1 - SQUISH_CONSTANT_4D;
-		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
-		if (attn4 > 0) {
-			attn4 *= attn4;
-			value += attn4 * attn4 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 0, wsb + 1, dx4, dy4, dz4, dw4);
-		}
-	} else if (inSum >= 3) { /* We're inside the pentachoron (4-Simplex) at (1,1,1,1)
-		Determine which two of (1,1,1,0), (1,1,0,1), (1,0,1,1), (0,1,1,1) are closest. */
-		aPoint = 0x0E;
-		aScore = xins;
-		bPoint = 0x0D;
-		bScore = yins;
-		if (aScore <= bScore && zins < bScore) {
-			bScore = zins;
-			bPoint = 0x0B;
-		} else if (aScore > bScore && zins < aScore) {
-			aScore = zins;
-			aPoint = 0x0B;
-		}
-		if (aScore <= bScore && wins < bScore) {
-			bScore = wins;
-			bPoint = 0x07;
-		} else if (aScore > bScore && wins < aScore) {
-			aScore = wins;
-			aPoint = 0x07;
-		}
-		
-		/* Now we determine the three lattice points not part of the pentachoron that may contribute.
-		   This depends on the closest two pentachoron vertices, including (0,0,0,0) */
-		uins = 4 - inSum;
-		if (uins < aScore || uins < bScore) { /* (1,1,1,1) is one of the closest two pentachoron vertices. */
-			c = (bScore < aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
-			
-			if ((c & 0x01) != 0) {
-				xsv_ext0 = xsb + 2;
-				xsv_ext1 = xsv_ext2 = xsb + 1;
-				dx_ext0 = dx0 - 2 - 4 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx_ext2 = dx0 - 1 - 4 * SQUISH_CONSTANT_4D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb;
-				dx_ext0 = dx_ext1 = dx_ext2 = dx0 - 4 * SQUISH_CONSTANT_4D;
-			}
-
-			if ((c & 0x02) != 0) {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				if ((c & 0x01) != 0) {
-					ysv_ext1 += 1;
-					dy_ext1 -= 1;
-				} else {
-					ysv_ext0 += 1;
-					dy_ext0 -= 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
-				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 4 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x04) != 0) {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
-				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				if ((c & 0x03) != 0x03) {
-					if ((c & 0x03) == 0) {
-						zsv_ext0 += 1;
-						dz_ext0 -= 1;
-					} else {
-						zsv_ext1 += 1;
-						dz_ext1 -= 1;
-					}
-				} else {
-					zsv_ext2 += 1;
-					dz_ext2 -= 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
-				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 4 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x08) != 0) {
-				wsv_ext0 = wsv_ext1 = wsb + 1;
-				wsv_ext2 = wsb + 2;
-				dw_ext0 = dw_ext1 = dw0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 - 2 - 4 * SQUISH_CONSTANT_4D;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb;
-				dw_ext0 = dw_ext1 = dw_ext2 = dw0 - 4 * SQUISH_CONSTANT_4D;
-			}
-		} else { /* (1,1,1,1) is not one of the closest two pentachoron vertices. */
-			c = (int8_t)(aPoint & bPoint); /* Our three extra vertices are determined by the closest two. */
-			
-			if ((c & 0x01) != 0) {
-				xsv_ext0 = xsv_ext2 = xsb + 1;
-				xsv_ext1 = xsb + 2;
-				dx_ext0 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx0 - 2 - 3 * SQUISH_CONSTANT_4D;
-				dx_ext2 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb;
-				dx_ext0 = dx0 - 2 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx_ext2 = dx0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x02) != 0) {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
-				dy_ext0 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext1 = dy_ext2 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				if ((c & 0x01) != 0) {
-					ysv_ext2 += 1;
-					dy_ext2 -= 1;
-				} else {
-					ysv_ext1 += 1;
-					dy_ext1 -= 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
-				dy_ext0 = dy0 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext1 = dy_ext2 = dy0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x04) != 0) {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
-				dz_ext0 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext1 = dz_ext2 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				if ((c & 0x03) != 0) {
-					zsv_ext2 += 1;
-					dz_ext2 -= 1;
-				} else {
-					zsv_ext1 += 1;
-					dz_ext1 -= 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
-				dz_ext0 = dz0 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext1 = dz_ext2 = dz0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c & 0x08) != 0) {
-				wsv_ext0 = wsv_ext1 = wsb + 1;
-				wsv_ext2 = wsb + 2;
-				dw_ext0 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 - 2 - 3 * SQUISH_CONSTANT_4D;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb;
-				dw_ext0 = dw0 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw_ext2 = dw0 - 3 * SQUISH_CONSTANT_4D;
-			}
-		}
-
-		/* Contribution (1,1,1,0) */
-		dx4 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dy4 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dz4 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dw4 = dw0 - 3 * SQUISH_CONSTANT_4D;
-		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
-		if (attn4 > 0) {
-			attn4 *= attn4;
-			value += attn4 * attn4 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 1, wsb + 0, dx4, dy4, dz4, dw4);
-		}
-
-		/* Contribution (1,1,0,1) */
-		dx3 = dx4;
-		dy3 = dy4;
-		dz3 = dz0 - 3 * SQUISH_CONSTANT_4D;
-		dw3 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 0, wsb + 1, dx3, dy3, dz3, dw3);
-		}
-
-		/* Contribution (1,0,1,1) */
-		dx2 = dx4;
-		dy2 = dy0 - 3 * SQUISH_CONSTANT_4D;
-		dz2 = dz4;
-		dw2 = dw3;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 1, wsb + 1, dx2, dy2, dz2, dw2);
-		}
-
-		/* Contribution (0,1,1,1) */
-		dx1 = dx0 - 3 * SQUISH_CONSTANT_4D;
-		dz1 = dz4;
-		dy1 = dy4;
-		dw1 = dw3;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 1, wsb + 1, dx1, dy1, dz1, dw1);
-		}
-
-		/* Contribution (1,1,1,1) */
-		dx0 = dx0 - 1 - 4 * SQUISH_CONSTANT_4D;
-		dy0 = dy0 - 1 - 4 * SQUISH_CONSTANT_4D;
-		dz0 = dz0 - 1 - 4 * SQUISH_CONSTANT_4D;
-		dw0 = dw0 - 1 - 4 * SQUISH_CONSTANT_4D;
-		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0 - dw0 * dw0;
-		if (attn0 > 0) {
-			attn0 *= attn0;
-			value += attn0 * attn0 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 1, wsb + 1, dx0, dy0, dz0, dw0);
-		}
-	} else if (inSum <= 2) { /* We're inside the first dispentachoron (Rectified 4-Simplex) */
-		aIsBiggerSide = 1;
-		bIsBiggerSide = 1;
-		
-		/* Decide between (1,1,0,0) and (0,0,1,1) */
-		if (xins + yins > zins + wins) {
-			aScore = xins + yins;
-			aPoint = 0x03;
-		} else {
-			aScore = zins + wins;
-			aPoint = 0x0C;
-		}
-		
-		/* Decide between (1,0,1,0) and (0,1,0,1) */
-		if (xins + zins > yins + wins) {
-			bScore = xins + zins;
-			bPoint = 0x05;
-		} else {
-			bScore = yins + wins;
-			bPoint = 0x0A;
-		}
-		
-		/* Closer between (1,0,0,1) and (0,1,1,0) will replace the further of a and b, if closer. */
-		if (xins + wins > yins + zins) {
-			score = xins + wins;
-			if (aScore >= bScore && score > bScore) {
-				bScore = score;
-				bPoint = 0x09;
-			} else if (aScore < bScore && score > aScore) {
-				aScore = score;
-				aPoint = 0x09;
-			}
-		} else {
-			score = yins + zins;
-			if (aScore >= bScore && score > bScore) {
-				bScore = score;
-				bPoint = 0x06;
-			} else if (aScore < bScore && score > aScore) {
-				aScore = score;
-				aPoint = 0x06;
-			}
-		}
-		
-		/* Decide if (1,0,0,0) is closer. */
-		p1 = 2 - inSum + xins;
-		if (aScore >= bScore && p1 > bScore) {
-			bScore = p1;
-			bPoint = 0x01;
-			bIsBiggerSide = 0;
-		} else if (aScore < bScore && p1 > aScore) {
-			aScore = p1;
-			aPoint = 0x01;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (0,1,0,0) is closer. */
-		p2 = 2 - inSum + yins;
-		if (aScore >= bScore && p2 > bScore) {
-			bScore = p2;
-			bPoint = 0x02;
-			bIsBiggerSide = 0;
-		} else if (aScore < bScore && p2 > aScore) {
-			aScore = p2;
-			aPoint = 0x02;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (0,0,1,0) is closer. */
-		p3 = 2 - inSum + zins;
-		if (aScore >= bScore && p3 > bScore) {
-			bScore = p3;
-			bPoint = 0x04;
-			bIsBiggerSide = 0;
-		} else if (aScore < bScore && p3 > aScore) {
-			aScore = p3;
-			aPoint = 0x04;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (0,0,0,1) is closer. */
-		p4 = 2 - inSum + wins;
-		if (aScore >= bScore && p4 > bScore) {
-			bScore = p4;
-			bPoint = 0x08;
-			bIsBiggerSide = 0;
-		} else if (aScore < bScore && p4 > aScore) {
-			aScore = p4;
-			aPoint = 0x08;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Where each of the two closest points are determines how the extra three vertices are calculated. */
-		if (aIsBiggerSide == bIsBiggerSide) {
-			if (aIsBiggerSide) { /* Both closest points on the bigger side */
-				c1 = (int8_t)(aPoint | bPoint);
-				c2 = (int8_t)(aPoint & bPoint);
-				if ((c1 & 0x01) == 0) {
-					xsv_ext0 = xsb;
-					xsv_ext1 = xsb - 1;
-					dx_ext0 = dx0 - 3 * SQUISH_CONSTANT_4D;
-					dx_ext1 = dx0 + 1 - 2 * SQUISH_CONSTANT_4D;
-				} else {
-					xsv_ext0 = xsv_ext1 = xsb + 1;
-					dx_ext0 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					dx_ext1 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c1 & 0x02) == 0) {
-					ysv_ext0 = ysb;
-					ysv_ext1 = ysb - 1;
-					dy_ext0 = dy0 - 3 * SQUISH_CONSTANT_4D;
-					dy_ext1 = dy0 + 1 - 2 * SQUISH_CONSTANT_4D;
-				} else {
-					ysv_ext0 = ysv_ext1 = ysb + 1;
-					dy_ext0 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					dy_ext1 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c1 & 0x04) == 0) {
-					zsv_ext0 = zsb;
-					zsv_ext1 = zsb - 1;
-					dz_ext0 = dz0 - 3 * SQUISH_CONSTANT_4D;
-					dz_ext1 = dz0 + 1 - 2 * SQUISH_CONSTANT_4D;
-				} else {
-					zsv_ext0 = zsv_ext1 = zsb + 1;
-					dz_ext0 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					dz_ext1 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c1 & 0x08) == 0) {
-					wsv_ext0 = wsb;
-					wsv_ext1 = wsb - 1;
-					dw_ext0 = dw0 - 3 * SQUISH_CONSTANT_4D;
-					dw_ext1 = dw0 + 1 - 2 * SQUISH_CONSTANT_4D;
-				} else {
-					wsv_ext0 = wsv_ext1 = wsb + 1;
-					dw_ext0 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					dw_ext1 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				}
-				
-				/* One combination is a permutation of (0,0,0,2) based on c2 */
-				xsv_ext2 = xsb;
-				ysv_ext2 = ysb;
-				zsv_ext2 = zsb;
-				wsv_ext2 = wsb;
-				dx_ext2 = dx0 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext2 = dy0 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext2 = dz0 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 - 2 * SQUISH_CONSTANT_4D;
-				if ((c2 & 0x01) != 0) {
-					xsv_ext2 += 2;
-					dx_ext2 -= 2;
-				} else if ((c2 & 0x02) != 0) {
-					ysv_ext2 += 2;
-					dy_ext2 -= 2;
-				} else if ((c2 & 0x04) != 0) {
-					zsv_ext2 += 2;
-					dz_ext2 -= 2;
-				} else {
-					wsv_ext2 += 2;
-					dw_ext2 -= 2;
-				}
-				
-			} else { /* Both closest points on the smaller side */
-				/* One of the two extra points is (0,0,0,0) */
-				xsv_ext2 = xsb;
-				ysv_ext2 = ysb;
-				zsv_ext2 = zsb;
-				wsv_ext2 = wsb;
-				dx_ext2 = dx0;
-				dy_ext2 = dy0;
-				dz_ext2 = dz0;
-				dw_ext2 = dw0;
-				
-				/* Other two points are based on the omitted axes. */
-				c = (int8_t)(aPoint | bPoint);
-				
-				if ((c & 0x01) == 0) {
-					xsv_ext0 = xsb - 1;
-					xsv_ext1 = xsb;
-					dx_ext0 = dx0 + 1 - SQUISH_CONSTANT_4D;
-					dx_ext1 = dx0 - SQUISH_CONSTANT_4D;
-				} else {
-					xsv_ext0 = xsv_ext1 = xsb + 1;
-					dx_ext0 = dx_ext1 = dx0 - 1 - SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x02) == 0) {
-					ysv_ext0 = ysv_ext1 = ysb;
-					dy_ext0 = dy_ext1 = dy0 - SQUISH_CONSTANT_4D;
-					if ((c & 0x01) == 0x01)
-					{
-						ysv_ext0 -= 1;
-						dy_ext0 += 1;
-					} else {
-						ysv_ext1 -= 1;
-						dy_ext1 += 1;
-					}
-				} else {
-					ysv_ext0 = ysv_ext1 = ysb + 1;
-					dy_ext0 = dy_ext1 = dy0 - 1 - SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x04) == 0) {
-					zsv_ext0 = zsv_ext1 = zsb;
-					dz_ext0 = dz_ext1 = dz0 - SQUISH_CONSTANT_4D;
-					if ((c & 0x03) == 0x03)
-					{
-						zsv_ext0 -= 1;
-						dz_ext0 += 1;
-					} else {
-						zsv_ext1 -= 1;
-						dz_ext1 += 1;
-					}
-				} else {
-					zsv_ext0 = zsv_ext1 = zsb + 1;
-					dz_ext0 = dz_ext1 = dz0 - 1 - SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x08) == 0)
-				{
-					wsv_ext0 = wsb;
-					wsv_ext1 = wsb - 1;
-					dw_ext0 = dw0 - SQUISH_CONSTANT_4D;
-					dw_ext1 = dw0 + 1 - SQUISH_CONSTANT_4D;
-				} else {
-					wsv_ext0 = wsv_ext1 = wsb + 1;
-					dw_ext0 = dw_ext1 = dw0 - 1 - SQUISH_CONSTANT_4D;
-				}
-				
-			}
-		} else { /* One point on each "side" */
-			if (aIsBiggerSide) {
-				c1 = aPoint;
-				c2 = bPoint;
-			} else {
-				c1 = bPoint;
-				c2 = aPoint;
-			}
-			
-			/* Two contributions are the bigger-sided point with each 0 replaced with -1. */
-			if ((c1 & 0x01) == 0) {
-				xsv_ext0 = xsb - 1;
-				xsv_ext1 = xsb;
-				dx_ext0 = dx0 + 1 - SQUISH_CONSTANT_4D;
-				dx_ext1 = dx0 - SQUISH_CONSTANT_4D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb + 1;
-				dx_ext0 = dx_ext1 = dx0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x02) == 0) {
-				ysv_ext0 = ysv_ext1 = ysb;
-				dy_ext0 = dy_ext1 = dy0 - SQUISH_CONSTANT_4D;
-				if ((c1 & 0x01) == 0x01) {
-					ysv_ext0 -= 1;
-					dy_ext0 += 1;
-				} else {
-					ysv_ext1 -= 1;
-					dy_ext1 += 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x04) == 0) {
-				zsv_ext0 = zsv_ext1 = zsb;
-				dz_ext0 = dz_ext1 = dz0 - SQUISH_CONSTANT_4D;
-				if ((c1 & 0x03) == 0x03) {
-					zsv_ext0 -= 1;
-					dz_ext0 += 1;
-				} else {
-					zsv_ext1 -= 1;
-					dz_ext1 += 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb + 1;
-				dz_ext0 = dz_ext1 = dz0 - 1 - SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x08) == 0) {
-				wsv_ext0 = wsb;
-				wsv_ext1 = wsb - 1;
-				dw_ext0 = dw0 - SQUISH_CONSTANT_4D;
-				dw_ext1 = dw0 + 1 - SQUISH_CONSTANT_4D;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsb + 1;
-				dw_ext0 = dw_ext1 = dw0 - 1 - SQUISH_CONSTANT_4D;
-			}
-
-			/* One contribution is a permutation of (0,0,0,2) based on the smaller-sided point */
-			xsv_ext2 = xsb;
-			ysv_ext2 = ysb;
-			zsv_ext2 = zsb;
-			wsv_ext2 = wsb;
-			dx_ext2 = dx0 - 2 * SQUISH_CONSTANT_4D;
-			dy_ext2 = dy0 - 2 * SQUISH_CONSTANT_4D;
-			dz_ext2 = dz0 - 2 * SQUISH_CONSTANT_4D;
-			dw_ext2 = dw0 - 2 * SQUISH_CONSTANT_4D;
-			if ((c2 & 0x01) != 0) {
-				xsv_ext2 += 2;
-				dx_ext2 -= 2;
-			} else if ((c2 & 0x02) != 0) {
-				ysv_ext2 += 2;
-				dy_ext2 -= 2;
-			} else if ((c2 & 0x04) != 0) {
-				zsv_ext2 += 2;
-				dz_ext2 -= 2;
-			} else {
-				wsv_ext2 += 2;
-				dw_ext2 -= 2;
-			}
-		}
-		
-		/* Contribution (1,0,0,0) */
-		dx1 = dx0 - 1 - SQUISH_CONSTANT_4D;
-		dy1 = dy0 - 0 - SQUISH_CONSTANT_4D;
-		dz1 = dz0 - 0 - SQUISH_CONSTANT_4D;
-		dw1 = dw0 - 0 - SQUISH_CONSTANT_4D;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 0, wsb + 0, dx1, dy1, dz1, dw1);
-		}
-
-		/* Contribution (0,1,0,0) */
-		dx2 = dx0 - 0 - SQUISH_CONSTANT_4D;
-		dy2 = dy0 - 1 - SQUISH_CONSTANT_4D;
-		dz2 = dz1;
-		dw2 = dw1;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 0, wsb + 0, dx2, dy2, dz2, dw2);
-		}
-
-		/* Contribution (0,0,1,0) */
-		dx3 = dx2;
-		dy3 = dy1;
-		dz3 = dz0 - 1 - SQUISH_CONSTANT_4D;
-		dw3 = dw1;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 1, wsb + 0, dx3, dy3, dz3, dw3);
-		}
-
-		/* Contribution (0,0,0,1) */
-		dx4 = dx2;
-		dy4 = dy1;
-		dz4 = dz1;
-		dw4 = dw0 - 1 - SQUISH_CONSTANT_4D;
-		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
-		if (attn4 > 0) {
-			attn4 *= attn4;
-			value += attn4 * attn4 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 0, wsb + 1, dx4, dy4, dz4, dw4);
-		}
-		
-		/* Contribution (1,1,0,0) */
-		dx5 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy5 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz5 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw5 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5 - dw5 * dw5;
-		if (attn5 > 0) {
-			attn5 *= attn5;
-			value += attn5 * attn5 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 0, wsb + 0, dx5, dy5, dz5, dw5);
-		}
-		
-		/* Contribution (1,0,1,0) */
-		dx6 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy6 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz6 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw6 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6 - dw6 * dw6;
-		if (attn6 > 0) {
-			attn6 *= attn6;
-			value += attn6 * attn6 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 1, wsb + 0, dx6, dy6, dz6, dw6);
-		}
-
-		/* Contribution (1,0,0,1) */
-		dx7 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy7 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz7 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw7 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn7 = 2 - dx7 * dx7 - dy7 * dy7 - dz7 * dz7 - dw7 * dw7;
-		if (attn7 > 0) {
-			attn7 *= attn7;
-			value += attn7 * attn7 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 0, wsb + 1, dx7, dy7, dz7, dw7);
-		}
-		
-		/* Contribution (0,1,1,0) */
-		dx8 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy8 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz8 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw8 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn8 = 2 - dx8 * dx8 - dy8 * dy8 - dz8 * dz8 - dw8 * dw8;
-		if (attn8 > 0) {
-			attn8 *= attn8;
-			value += attn8 * attn8 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 1, wsb + 0, dx8, dy8, dz8, dw8);
-		}
-		
-		/* Contribution (0,1,0,1) */
-		dx9 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy9 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz9 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw9 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn9 = 2 - dx9 * dx9 - dy9 * dy9 - dz9 * dz9 - dw9 * dw9;
-		if (attn9 > 0) {
-			attn9 *= attn9;
-			value += attn9 * attn9 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 0, wsb + 1, dx9, dy9, dz9, dw9);
-		}
-		
-		/* Contribution (0,0,1,1) */
-		dx10 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy10 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz10 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw10 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn10 = 2 - dx10 * dx10 - dy10 * dy10 - dz10 * dz10 - dw10 * dw10;
-		if (attn10 > 0) {
-			attn10 *= attn10;
-			value += attn10 * attn10 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 1, wsb + 1, dx10, dy10, dz10, dw10);
-		}
-	} else { /* We're inside the second dispentachoron (Rectified 4-Simplex) */
-		aIsBiggerSide = 1;
-		bIsBiggerSide = 1;
-		
-		/* Decide between (0,0,1,1) and (1,1,0,0) */
-		if (xins + yins < zins + wins) {
-			aScore = xins + yins;
-			aPoint = 0x0C;
-		} else {
-			aScore = zins + wins;
-			aPoint = 0x03;
-		}
-		
-		/* Decide between (0,1,0,1) and (1,0,1,0) */
-		if (xins + zins < yins + wins) {
-			bScore = xins + zins;
-			bPoint = 0x0A;
-		} else {
-			bScore = yins + wins;
-			bPoint = 0x05;
-		}
-		
-		/* Closer between (0,1,1,0) and (1,0,0,1) will replace the further of a and b, if closer. */
-		if (xins + wins < yins + zins) {
-			score = xins + wins;
-			if (aScore <= bScore && score < bScore) {
-				bScore = score;
-				bPoint = 0x06;
-			} else if (aScore > bScore && score < aScore) {
-				aScore = score;
-				aPoint = 0x06;
-			}
-		} else {
-			score = yins + zins;
-			if (aScore <= bScore && score < bScore) {
-				bScore = score;
-				bPoint = 0x09;
-			} else if (aScore > bScore && score < aScore) {
-				aScore = score;
-				aPoint = 0x09;
-			}
-		}
-		
-		/* Decide if (0,1,1,1) is closer. */
-		p1 = 3 - inSum + xins;
-		if (aScore <= bScore && p1 < bScore) {
-			bScore = p1;
-			bPoint = 0x0E;
-			bIsBiggerSide = 0;
-		} else if (aScore > bScore && p1 < aScore) {
-			aScore = p1;
-			aPoint = 0x0E;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (1,0,1,1) is closer. */
-		p2 = 3 - inSum + yins;
-		if (aScore <= bScore && p2 < bScore) {
-			bScore = p2;
-			bPoint = 0x0D;
-			bIsBiggerSide = 0;
-		} else if (aScore > bScore && p2 < aScore) {
-			aScore = p2;
-			aPoint = 0x0D;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (1,1,0,1) is closer. */
-		p3 = 3 - inSum + zins;
-		if (aScore <= bScore && p3 < bScore) {
-			bScore = p3;
-			bPoint = 0x0B;
-			bIsBiggerSide = 0;
-		} else if (aScore > bScore && p3 < aScore) {
-			aScore = p3;
-			aPoint = 0x0B;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Decide if (1,1,1,0) is closer. */
-		p4 = 3 - inSum + wins;
-		if (aScore <= bScore && p4 < bScore) {
-			bScore = p4;
-			bPoint = 0x07;
-			bIsBiggerSide = 0;
-		} else if (aScore > bScore && p4 < aScore) {
-			aScore = p4;
-			aPoint = 0x07;
-			aIsBiggerSide = 0;
-		}
-		
-		/* Where each of the two closest points are determines how the extra three vertices are calculated. */
-		if (aIsBiggerSide == bIsBiggerSide) {
-			if (aIsBiggerSide) { /* Both closest points on the bigger side */
-				c1 = (int8_t)(aPoint & bPoint);
-				c2 = (int8_t)(aPoint | bPoint);
-				
-				/* Two contributions are permutations of (0,0,0,1) and (0,0,0,2) based on c1 */
-				xsv_ext0 = xsv_ext1 = xsb;
-				ysv_ext0 = ysv_ext1 = ysb;
-				zsv_ext0 = zsv_ext1 = zsb;
-				wsv_ext0 = wsv_ext1 = wsb;
-				dx_ext0 = dx0 - SQUISH_CONSTANT_4D;
-				dy_ext0 = dy0 - SQUISH_CONSTANT_4D;
-				dz_ext0 = dz0 - SQUISH_CONSTANT_4D;
-				dw_ext0 = dw0 - SQUISH_CONSTANT_4D;
-				dx_ext1 = dx0 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext1 = dy0 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext1 = dz0 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw0 - 2 * SQUISH_CONSTANT_4D;
-				if ((c1 & 0x01) != 0) {
-					xsv_ext0 += 1;
-					dx_ext0 -= 1;
-					xsv_ext1 += 2;
-					dx_ext1 -= 2;
-				} else if ((c1 & 0x02) != 0) {
-					ysv_ext0 += 1;
-					dy_ext0 -= 1;
-					ysv_ext1 += 2;
-					dy_ext1 -= 2;
-				} else if ((c1 & 0x04) != 0) {
-					zsv_ext0 += 1;
-					dz_ext0 -= 1;
-					zsv_ext1 += 2;
-					dz_ext1 -= 2;
-				} else {
-					wsv_ext0 += 1;
-					dw_ext0 -= 1;
-					wsv_ext1 += 2;
-					dw_ext1 -= 2;
-				}
-				
-				/* One contribution is a permutation of (1,1,1,-1) based on c2 */
-				xsv_ext2 = xsb + 1;
-				ysv_ext2 = ysb + 1;
-				zsv_ext2 = zsb + 1;
-				wsv_ext2 = wsb + 1;
-				dx_ext2 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dy_ext2 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dz_ext2 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-				if ((c2 & 0x01) == 0) {
-					xsv_ext2 -= 2;
-					dx_ext2 += 2;
-				} else if ((c2 & 0x02) == 0) {
-					ysv_ext2 -= 2;
-					dy_ext2 += 2;
-				} else if ((c2 & 0x04) == 0) {
-					zsv_ext2 -= 2;
-					dz_ext2 += 2;
-				} else {
-					wsv_ext2 -= 2;
-					dw_ext2 += 2;
-				}
-			} else { /* Both closest points on the smaller side */
-				/* One of the two extra points is (1,1,1,1) */
-				xsv_ext2 = xsb + 1;
-				ysv_ext2 = ysb + 1;
-				zsv_ext2 = zsb + 1;
-				wsv_ext2 = wsb + 1;
-				dx_ext2 = dx0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				dy_ext2 = dy0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				dz_ext2 = dz0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				dw_ext2 = dw0 - 1 - 4 * SQUISH_CONSTANT_4D;
-				
-				/* Other two points are based on the shared axes. */
-				c = (int8_t)(aPoint & bPoint);
-				
-				if ((c & 0x01) != 0) {
-					xsv_ext0 = xsb + 2;
-					xsv_ext1 = xsb + 1;
-					dx_ext0 = dx0 - 2 - 3 * SQUISH_CONSTANT_4D;
-					dx_ext1 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				} else {
-					xsv_ext0 = xsv_ext1 = xsb;
-					dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x02) != 0) {
-					ysv_ext0 = ysv_ext1 = ysb + 1;
-					dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					if ((c & 0x01) == 0)
-					{
-						ysv_ext0 += 1;
-						dy_ext0 -= 1;
-					} else {
-						ysv_ext1 += 1;
-						dy_ext1 -= 1;
-					}
-				} else {
-					ysv_ext0 = ysv_ext1 = ysb;
-					dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x04) != 0) {
-					zsv_ext0 = zsv_ext1 = zsb + 1;
-					dz_ext0 = dz_ext1 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					if ((c & 0x03) == 0)
-					{
-						zsv_ext0 += 1;
-						dz_ext0 -= 1;
-					} else {
-						zsv_ext1 += 1;
-						dz_ext1 -= 1;
-					}
-				} else {
-					zsv_ext0 = zsv_ext1 = zsb;
-					dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_CONSTANT_4D;
-				}
-				
-				if ((c & 0x08) != 0)
-				{
-					wsv_ext0 = wsb + 1;
-					wsv_ext1 = wsb + 2;
-					dw_ext0 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-					dw_ext1 = dw0 - 2 - 3 * SQUISH_CONSTANT_4D;
-				} else {
-					wsv_ext0 = wsv_ext1 = wsb;
-					dw_ext0 = dw_ext1 = dw0 - 3 * SQUISH_CONSTANT_4D;
-				}
-			}
-		} else { /* One point on each "side" */
-			if (aIsBiggerSide) {
-				c1 = aPoint;
-				c2 = bPoint;
-			} else {
-				c1 = bPoint;
-				c2 = aPoint;
-			}
-			
-			/* Two contributions are the bigger-sided point with each 1 replaced with 2. */
-			if ((c1 & 0x01) != 0) {
-				xsv_ext0 = xsb + 2;
-				xsv_ext1 = xsb + 1;
-				dx_ext0 = dx0 - 2 - 3 * SQUISH_CONSTANT_4D;
-				dx_ext1 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-			} else {
-				xsv_ext0 = xsv_ext1 = xsb;
-				dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x02) != 0) {
-				ysv_ext0 = ysv_ext1 = ysb + 1;
-				dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				if ((c1 & 0x01) == 0) {
-					ysv_ext0 += 1;
-					dy_ext0 -= 1;
-				} else {
-					ysv_ext1 += 1;
-					dy_ext1 -= 1;
-				}
-			} else {
-				ysv_ext0 = ysv_ext1 = ysb;
-				dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x04) != 0) {
-				zsv_ext0 = zsv_ext1 = zsb + 1;
-				dz_ext0 = dz_ext1 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				if ((c1 & 0x03) == 0) {
-					zsv_ext0 += 1;
-					dz_ext0 -= 1;
-				} else {
-					zsv_ext1 += 1;
-					dz_ext1 -= 1;
-				}
-			} else {
-				zsv_ext0 = zsv_ext1 = zsb;
-				dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_CONSTANT_4D;
-			}
-			
-			if ((c1 & 0x08) != 0) {
-				wsv_ext0 = wsb + 1;
-				wsv_ext1 = wsb + 2;
-				dw_ext0 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-				dw_ext1 = dw0 - 2 - 3 * SQUISH_CONSTANT_4D;
-			} else {
-				wsv_ext0 = wsv_ext1 = wsb;
-				dw_ext0 = dw_ext1 = dw0 - 3 * SQUISH_CONSTANT_4D;
-			}
-
-			/* One contribution is a permutation of (1,1,1,-1) based on the smaller-sided point */
-			xsv_ext2 = xsb + 1;
-			ysv_ext2 = ysb + 1;
-			zsv_ext2 = zsb + 1;
-			wsv_ext2 = wsb + 1;
-			dx_ext2 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-			dy_ext2 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-			dz_ext2 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-			dw_ext2 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-			if ((c2 & 0x01) == 0) {
-				xsv_ext2 -= 2;
-				dx_ext2 += 2;
-			} else if ((c2 & 0x02) == 0) {
-				ysv_ext2 -= 2;
-				dy_ext2 += 2;
-			} else if ((c2 & 0x04) == 0) {
-				zsv_ext2 -= 2;
-				dz_ext2 += 2;
-			} else {
-				wsv_ext2 -= 2;
-				dw_ext2 += 2;
-			}
-		}
-		
-		/* Contribution (1,1,1,0) */
-		dx4 = dx0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dy4 = dy0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dz4 = dz0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		dw4 = dw0 - 3 * SQUISH_CONSTANT_4D;
-		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
-		if (attn4 > 0) {
-			attn4 *= attn4;
-			value += attn4 * attn4 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 1, wsb + 0, dx4, dy4, dz4, dw4);
-		}
-
-		/* Contribution (1,1,0,1) */
-		dx3 = dx4;
-		dy3 = dy4;
-		dz3 = dz0 - 3 * SQUISH_CONSTANT_4D;
-		dw3 = dw0 - 1 - 3 * SQUISH_CONSTANT_4D;
-		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
-		if (attn3 > 0) {
-			attn3 *= attn3;
-			value += attn3 * attn3 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 0, wsb + 1, dx3, dy3, dz3, dw3);
-		}
-
-		/* Contribution (1,0,1,1) */
-		dx2 = dx4;
-		dy2 = dy0 - 3 * SQUISH_CONSTANT_4D;
-		dz2 = dz4;
-		dw2 = dw3;
-		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
-		if (attn2 > 0) {
-			attn2 *= attn2;
-			value += attn2 * attn2 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 1, wsb + 1, dx2, dy2, dz2, dw2);
-		}
-
-		/* Contribution (0,1,1,1) */
-		dx1 = dx0 - 3 * SQUISH_CONSTANT_4D;
-		dz1 = dz4;
-		dy1 = dy4;
-		dw1 = dw3;
-		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
-		if (attn1 > 0) {
-			attn1 *= attn1;
-			value += attn1 * attn1 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 1, wsb + 1, dx1, dy1, dz1, dw1);
-		}
-		
-		/* Contribution (1,1,0,0) */
-		dx5 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy5 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz5 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw5 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5 - dw5 * dw5;
-		if (attn5 > 0) {
-			attn5 *= attn5;
-			value += attn5 * attn5 * extrapolate4(ctx, xsb + 1, ysb + 1, zsb + 0, wsb + 0, dx5, dy5, dz5, dw5);
-		}
-		
-		/* Contribution (1,0,1,0) */
-		dx6 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy6 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz6 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw6 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6 - dw6 * dw6;
-		if (attn6 > 0) {
-			attn6 *= attn6;
-			value += attn6 * attn6 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 1, wsb + 0, dx6, dy6, dz6, dw6);
-		}
-
-		/* Contribution (1,0,0,1) */
-		dx7 = dx0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dy7 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz7 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw7 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn7 = 2 - dx7 * dx7 - dy7 * dy7 - dz7 * dz7 - dw7 * dw7;
-		if (attn7 > 0) {
-			attn7 *= attn7;
-			value += attn7 * attn7 * extrapolate4(ctx, xsb + 1, ysb + 0, zsb + 0, wsb + 1, dx7, dy7, dz7, dw7);
-		}
-		
-		/* Contribution (0,1,1,0) */
-		dx8 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy8 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz8 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw8 = dw0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		attn8 = 2 - dx8 * dx8 - dy8 * dy8 - dz8 * dz8 - dw8 * dw8;
-		if (attn8 > 0) {
-			attn8 *= attn8;
-			value += attn8 * attn8 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 1, wsb + 0, dx8, dy8, dz8, dw8);
-		}
-		
-		/* Contribution (0,1,0,1) */
-		dx9 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy9 = dy0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dz9 = dz0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dw9 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn9 = 2 - dx9 * dx9 - dy9 * dy9 - dz9 * dz9 - dw9 * dw9;
-		if (attn9 > 0) {
-			attn9 *= attn9;
-			value += attn9 * attn9 * extrapolate4(ctx, xsb + 0, ysb + 1, zsb + 0, wsb + 1, dx9, dy9, dz9, dw9);
-		}
-		
-		/* Contribution (0,0,1,1) */
-		dx10 = dx0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dy10 = dy0 - 0 - 2 * SQUISH_CONSTANT_4D;
-		dz10 = dz0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		dw10 = dw0 - 1 - 2 * SQUISH_CONSTANT_4D;
-		attn10 = 2 - dx10 * dx10 - dy10 * dy10 - dz10 * dz10 - dw10 * dw10;
-		if (attn10 > 0) {
-			attn10 *= attn10;
-			value += attn10 * attn10 * extrapolate4(ctx, xsb + 0, ysb + 0, zsb + 1, wsb + 1, dx10, dy10, dz10, dw10);
-		}
-	}
+	row_kernels->noise3_row(ctx, x, n, y, z, out);
+}
 
-	/* First extra vertex */
-	attn_ext0 = 2 - dx_ext0 * dx_ext0 - dy_ext0 * dy_ext0 - dz_ext0 * dz_ext0 - dw_ext0 * dw_ext0;
-	if (attn_ext0 > 0)
-	{
-		attn_ext0 *= attn_ext0;
-		value += attn_ext0 * attn_ext0 * extrapolate4(ctx, xsv_ext0, ysv_ext0, zsv_ext0, wsv_ext0, dx_ext0, dy_ext0, dz_ext0, dw_ext0);
-	}
+void open_simplex_noise4_row(const struct osn_context *ctx, const double *x, int n, double y, double z, double w, double *out)
+{
+	row_kernels->noise4_row(ctx, x, n, y, z, w, out);
+}
 
-	/* Second extra vertex */
-	attn_ext1 = 2 - dx_ext1 * dx_ext1 - dy_ext1 * dy_ext1 - dz_ext1 * dz_ext1 - dw_ext1 * dw_ext1;
-	if (attn_ext1 > 0)
-	{
-		attn_ext1 *= attn_ext1;
-		value += attn_ext1 * attn_ext1 * extrapolate4(ctx, xsv_ext1, ysv_ext1, zsv_ext1, wsv_ext1, dx_ext1, dy_ext1, dz_ext1, dw_ext1);
-	}
+void open_simplex_noise3f_row(const struct osn_context *ctx, const float *x, int n, float y, float z, float *out)
+{
+	row_kernels->noise3f_row(ctx, x, n, y, z, out);
+}
 
-	/* Third extra vertex */
-	attn_ext2 = 2 - dx_ext2 * dx_ext2 - dy_ext2 * dy_ext2 - dz_ext2 * dz_ext2 - dw_ext2 * dw_ext2;
-	if (attn_ext2 > 0)
-	{
-		attn_ext2 *= attn_ext2;
-		value += attn_ext2 * attn_ext2 * extrapolate4(ctx, xsv_ext2, ysv_ext2, zsv_ext2, wsv_ext2, dx_ext2, dy_ext2, dz_ext2, dw_ext2);
-	}
+void open_simplex_noise4f_row(const struct osn_context *ctx, const float *x, int n, float y, float z, float w, float *out)
+{
+	row_kernels->noise4f_row(ctx, x, n, y, z, w, out);
+}
 
-	return value / NORM_CONSTANT_4D;
+void open_simplex_noise4_slice_row(const struct osn_slice *slice, const double *x, int n, double y, double z, double *out)
+{
+	row_kernels->noise4_slice_row(slice, x, n, y, z, out);
 }
-	
 
+void open_simplex_noise4f_slice_row(const struct osn_slice *slice, const float *x, int n, float y, float z, float *out)
+{
+	row_kernels->noise4f_slice_row(slice, x, n, y, z, out);
+}
+#endif
@@ -36,13 +36,105 @@
 #endif
 
 struct osn_context;
+struct osn_slice;
 
+/*
+ * A context holds the permutation and gradient index tables of one seed in
+ * a single cache-aligned block.  Evaluation only reads it, so once set up
+ * (including open_simplex_noise4_select) one context can be shared by any
+ * number of threads; open_simplex_noise_init_perm and
+ * open_simplex_noise4_select must not run while it is in use.
+ */
 int open_simplex_noise(int64_t seed, struct osn_context **ctx);
 void open_simplex_noise_free(struct osn_context *ctx);
 int open_simplex_noise_init_perm(struct osn_context *ctx, int16_t p[], int nelements);
-double open_simplex_noise2(struct osn_context *ctx, double x, double y);
-double open_simplex_noise3(struct osn_context *ctx, double x, double y, double z);
-double open_simplex_noise4(struct osn_context *ctx, double x, double y, double z, double w);
+double open_simplex_noise2(const struct osn_context *ctx, double x, double y);
+double open_simplex_noise3(const struct osn_context *ctx, double x, double y, double z);
+double open_simplex_noise4(const struct osn_context *ctx, double x, double y, double z, double w);
+
+/*
+ * How 4D noise selects the lattice vertices that contribute to a point.
+ * Both give bit-identical results for every 4D entry point of the context;
+ * the table form replaces the nested region branches with a branchless key
+ * into precomputed vertex tables.  The selection applies to the per-point
+ * and gradient forms and to the scalar rows, where the branches are the
+ * faster of the two; the vector rows always evaluate the table form, in
+ * lanes (see open_simplex_noise_set_isa).  New contexts use
+ * OSN_SELECT_BRANCH.
+ */
+enum osn_select {
+	OSN_SELECT_BRANCH,
+	OSN_SELECT_TABLE
+};
+void open_simplex_noise4_select(struct osn_context *ctx, enum osn_select select);
+
+/*
+ * Gradient forms: the same value as open_simplex_noise3/4, plus its partial
+ * derivatives with respect to each input coordinate in grad, from the same
+ * evaluation.
+ */
+double open_simplex_noise3_grad(const struct osn_context *ctx, double x, double y, double z, double grad[3]);
+double open_simplex_noise4_grad(const struct osn_context *ctx, double x, double y, double z, double w, double grad[4]);
+
+/*
+ * Row forms: evaluate n points that share y, z (and w) and differ only in x,
+ * writing out[i] for x[i].  Results are bit-identical to the per-point calls.
+ */
+void open_simplex_noise3_row(const struct osn_context *ctx, const double *x, int n, double y, double z, double *out);
+void open_simplex_noise4_row(const struct osn_context *ctx, const double *x, int n, double y, double z, double w, double *out);
+
+/*
+ * w = const slices of 4D noise, for evaluating a whole lattice at one time
+ * step.  The slice fuses the z and w stages of the hash for every lattice w
+ * its points can reach, so the vector rows gather each vertex's gradient
+ * straight from the chain through y.  sum_min and sum_max bound x + y + z
+ * over the points; the bound only sizes the tables (a KB per lattice w), and
+ * points outside it still evaluate correctly.  Results are bit-identical to
+ * open_simplex_noise4[f] at the slice's w (converted to float for the float
+ * form).  The slice refers to ctx, which must outlive it; like the context
+ * it can be shared by any number of threads.
+ */
+int open_simplex_noise4_slice(const struct osn_context *ctx, double w, double sum_min, double sum_max, struct osn_slice **slice);
+void open_simplex_noise4_slice_free(struct osn_slice *slice);
+void open_simplex_noise4_slice_row(const struct osn_slice *slice, const double *x, int n, double y, double z, double *out);
+
+/*
+ * Instruction set of the row forms of both precisions.  The library
+ * carries a scalar version and, where the build enables them
+ * (OSN_HAVE_AVX2, OSN_HAVE_AVX512), AVX2 and AVX-512 versions, which
+ * evaluate whole blocks of points in vector lanes (4 or 8 doubles, 8 or 16
+ * floats); all give bit-identical results.  The first context created
+ * selects the best one the CPU supports.  open_simplex_noise_set_isa overrides the
+ * choice, or returns -EINVAL if isa is not supported; like
+ * open_simplex_noise4_select, it must not run while rows are evaluated.
+ */
+enum osn_isa {
+	OSN_ISA_SCALAR,
+	OSN_ISA_AVX2,
+	OSN_ISA_AVX512
+};
+int open_simplex_noise_isa_supported(enum osn_isa isa);
+enum osn_isa open_simplex_noise_best_isa(void);
+int open_simplex_noise_set_isa(enum osn_isa isa);
+enum osn_isa open_simplex_noise_get_isa(void);
+const char *open_simplex_noise_isa_name(enum osn_isa isa);
+
+/*
+ * Single precision family.  Same lattice and gradients, float arithmetic
+ * throughout; the row forms are bit-identical to the float per-point calls.
+ * Choose it for the rows on the AVX2 and AVX-512 kernels: with twice the
+ * lanes they take about 0.6 the time per point of the double rows on the
+ * 51-point rows of the default grid, and 0.75 on rows of 21 (see
+ * --report=precision).  The per-point calls, the scalar kernels and rows of
+ * a few points gain nothing over double.
+ */
+float open_simplex_noise3f(const struct osn_context *ctx, float x, float y, float z);
+float open_simplex_noise4f(const struct osn_context *ctx, float x, float y, float z, float w);
+float open_simplex_noise3f_grad(const struct osn_context *ctx, float x, float y, float z, float grad[3]);
+float open_simplex_noise4f_grad(const struct osn_context *ctx, float x, float y, float z, float w, float grad[4]);
+void open_simplex_noise3f_row(const struct osn_context *ctx, const float *x, int n, float y, float z, float *out);
+void open_simplex_noise4f_row(const struct osn_context *ctx, const float *x, int n, float y, float z, float w, float *out);
+void open_simplex_noise4f_slice_row(const struct osn_slice *slice, const float *x, int n, float y, float z, float *out);
 
 #ifdef __cplusplus
 	}
@@ -0,0 +1,676 @@
+#ifndef OPEN_SIMPLEX_NOISE4_TABLES_H__
+#define OPEN_SIMPLEX_NOISE4_TABLES_H__
+
+/*
+ * Lattice vertex tables for the table-driven 4D noise evaluation in
+ * open_simplex_noise_impl.h.  Included once by open_simplex_noise.c.
+ *
+ * The vertices that contribute to a point are fixed by which of the four
+ * regions of the super-cell it lies in (lattice4) plus three extra vertices
+ * that depend on the closest points found by the region's score comparisons
+ * (lattice4_ext).  The two pentachoron regions have five fixed vertices and
+ * are padded to ten with vertices far outside the attenuation radius, so
+ * every point walks the same thirteen entries.  The comparisons are packed
+ * into a 12-bit key.  For the two pentachoron regions it is
+ *
+ *	region << 10 | origin << 9 | c << 4
+ *
+ * with origin set when (0,0,0,0) is one of the closest two vertices and c
+ * the point (or union of points) the extras are derived from.  For the two
+ * dispentachoron regions it is
+ *
+ *	region << 10 | first << 5 | second
+ *
+ * with first and second the closest two points as side << 4 | point, the
+ * larger first, since the extras do not depend on which of the two the
+ * search found first.  Points are taken before the mirroring of regions 1
+ * and 3, so both halves of the super-cell share one key layout.
+ *
+ * Each vertex stores its lattice offset and the exact sequence of operations
+ * the branching code uses to reach its displacement,
+ *
+ *	d = ((d0 - a) - k * SQUISH_4D) + b
+ *
+ * per axis, so both evaluations round identically.  The tables were traced
+ * from the branching noise4 code, driving its extra-vertex selection through
+ * every possible pair of closest points; unused keys map to entry 0.
+ *
+ * The lane evaluation of the rows takes the fixed vertices straight from the
+ * corners of the super-cell and only reads lattice4_ext, with 32-bit
+ * gathers.  Every extra vertex has sv = a - b and k the sum of sv, so it
+ * fetches only a and b, a word each.
+ */
+
+struct osn_vertex4 {
+	int8_t sv[4];	/* lattice offset from the super-cell origin */
+	int8_t a[4];	/* subtracted before the squish offset */
+	int8_t b[4];	/* added after the squish offset */
+	int8_t k;	/* squish multiple, the same on every axis */
+};
+
+static const struct osn_vertex4 lattice4[4][10] = {
+	{
+		{ { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 },
+		{ { 1, 0, 0, 0}, {1,0,0,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 1, 0, 0}, {0,1,0,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 0, 1, 0}, {0,0,1,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 0, 0, 1}, {0,0,0,1}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+	},
+	{
+		{ { 1, 1, 1, 0}, {1,1,1,0}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 1, 0, 1}, {1,1,0,1}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 0, 1, 1}, {1,0,1,1}, { 0, 0, 0, 0}, 3 },
+		{ { 0, 1, 1, 1}, {0,1,1,1}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+		{ { 0, 0, 0, 0}, {8,8,8,8}, { 0, 0, 0, 0}, 0 },
+	},
+	{
+		{ { 1, 0, 0, 0}, {1,0,0,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 1, 0, 0}, {0,1,0,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 0, 1, 0}, {0,0,1,0}, { 0, 0, 0, 0}, 1 },
+		{ { 0, 0, 0, 1}, {0,0,0,1}, { 0, 0, 0, 0}, 1 },
+		{ { 1, 1, 0, 0}, {1,1,0,0}, { 0, 0, 0, 0}, 2 },
+		{ { 1, 0, 1, 0}, {1,0,1,0}, { 0, 0, 0, 0}, 2 },
+		{ { 1, 0, 0, 1}, {1,0,0,1}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 1, 1, 0}, {0,1,1,0}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 1, 0, 1}, {0,1,0,1}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 0, 1, 1}, {0,0,1,1}, { 0, 0, 0, 0}, 2 },
+	},
+	{
+		{ { 1, 1, 1, 0}, {1,1,1,0}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 1, 0, 1}, {1,1,0,1}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 0, 1, 1}, {1,0,1,1}, { 0, 0, 0, 0}, 3 },
+		{ { 0, 1, 1, 1}, {0,1,1,1}, { 0, 0, 0, 0}, 3 },
+		{ { 1, 1, 0, 0}, {1,1,0,0}, { 0, 0, 0, 0}, 2 },
+		{ { 1, 0, 1, 0}, {1,0,1,0}, { 0, 0, 0, 0}, 2 },
+		{ { 1, 0, 0, 1}, {1,0,0,1}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 1, 1, 0}, {0,1,1,0}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 1, 0, 1}, {0,1,0,1}, { 0, 0, 0, 0}, 2 },
+		{ { 0, 0, 1, 1}, {0,0,1,1}, { 0, 0, 0, 0}, 2 },
+	},
+};
+
+static const struct osn_vertex4 lattice4_ext[104][3] = {
+	{ { { 1, 1, 0, 0}, {1,1,0,0}, { 0, 0, 0, 0}, 2 },
+	  { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 } },
+	{ { { 1, 0, 1, 0}, {1,0,1,0}, { 0, 0, 0, 0}, 2 },
+	  { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 } },
+	{ { { 0, 1, 1, 0}, {0,1,1,0}, { 0, 0, 0, 0}, 2 },
+	  { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 } },
+	{ { { 1, 0, 0, 1}, {1,0,0,1}, { 0, 0, 0, 0}, 2 },
+	  { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 } },
+	{ { { 0, 1, 0, 1}, {0,1,0,1}, { 0, 0, 0, 0}, 2 },
+	  { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 } },
+	{ { { 0, 0, 1, 1}, {0,0,1,1}, { 0, 0, 0, 0}, 2 },
+	  { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 } },
+	{ { { 1,-1, 0, 0}, {1,-1,0,0}, { 0, 0, 0, 0}, 0 },
+	  { { 1, 0,-1, 0}, {1,0,-1,0}, { 0, 0, 0, 0}, 0 },
+	  { { 1, 0, 0,-1}, {1,0,0,-1}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 1, 0, 0}, {-1,1,0,0}, { 0, 0, 0, 0}, 0 },
+	  { { 0, 1,-1, 0}, {0,1,-1,0}, { 0, 0, 0, 0}, 0 },
+	  { { 0, 1, 0,-1}, {0,1,0,-1}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 0, 1, 0}, {-1,0,1,0}, { 0, 0, 0, 0}, 0 },
+	  { { 0,-1, 1, 0}, {0,-1,1,0}, { 0, 0, 0, 0}, 0 },
+	  { { 0, 0, 1,-1}, {0,0,1,-1}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 0, 0, 1}, {-1,0,0,1}, { 0, 0, 0, 0}, 0 },
+	  { { 0,-1, 0, 1}, {0,-1,0,1}, { 0, 0, 0, 0}, 0 },
+	  { { 0, 0,-1, 1}, {0,0,-1,1}, { 0, 0, 0, 0}, 0 } },
+	{ { { 0, 0, 1, 1}, {0,0,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 } },
+	{ { { 0, 1, 0, 1}, {0,1,0,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 } },
+	{ { { 1, 0, 0, 1}, {1,0,0,1}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 } },
+	{ { { 0, 1, 1, 0}, {0,1,1,0}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 } },
+	{ { { 1, 0, 1, 0}, {1,0,1,0}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 } },
+	{ { { 1, 1, 0, 0}, {1,1,0,0}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 } },
+	{ { { 0, 2, 1, 1}, {0,1,1,1}, { 0,-1, 0, 0}, 4 },
+	  { { 0, 1, 2, 1}, {0,1,1,1}, { 0, 0,-1, 0}, 4 },
+	  { { 0, 1, 1, 2}, {0,1,1,2}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 0, 1, 1}, {2,0,1,1}, { 0, 0, 0, 0}, 4 },
+	  { { 1, 0, 2, 1}, {1,0,1,1}, { 0, 0,-1, 0}, 4 },
+	  { { 1, 0, 1, 2}, {1,0,1,2}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 1, 0, 1}, {2,1,0,1}, { 0, 0, 0, 0}, 4 },
+	  { { 1, 2, 0, 1}, {1,1,0,1}, { 0,-1, 0, 0}, 4 },
+	  { { 1, 1, 0, 2}, {1,1,0,2}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 1, 1, 0}, {2,1,1,0}, { 0, 0, 0, 0}, 4 },
+	  { { 1, 2, 1, 0}, {1,1,1,0}, { 0,-1, 0, 0}, 4 },
+	  { { 1, 1, 2, 0}, {1,1,1,0}, { 0, 0,-1, 0}, 4 } },
+	{ { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 },
+	  { { 0, 0, 0, 0}, {0,0,0,0}, { 0, 0, 0, 0}, 0 } },
+	{ { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 1, 1,-1, 0}, {1,1,0,0}, { 0, 0, 1, 0}, 1 },
+	  { { 1, 1, 0,-1}, {1,1,0,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 1,-1, 1, 0}, {1,0,1,0}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0, 1,-1}, {1,0,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1, 1, 1, 0}, {1,1,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,-1}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { {-1, 1, 1, 0}, {-1,1,1,0}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1, 1,-1}, {0,1,1,-1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1, 1, 1, 0}, {1,1,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,-1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 1, 1, 1, 0}, {1,1,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,-1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 1,-1, 0, 1}, {1,0,0,1}, { 0, 1, 0, 0}, 1 },
+	  { { 1, 0,-1, 1}, {1,0,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1, 1, 0, 1}, {1,1,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,-1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { { 1, 0, 1, 1}, {1,0,1,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,-1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { {-1, 1, 0, 1}, {-1,1,0,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0, 1,-1, 1}, {0,1,0,1}, { 0, 0, 1, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1, 1, 0, 1}, {1,1,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,-1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 0, 1, 1, 1}, {0,1,1,1}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {-1,1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { { 1, 1, 0, 1}, {1,1,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,-1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 } },
+	{ { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 } },
+	{ { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { {-1, 0, 1, 1}, {-1,0,1,1}, { 0, 0, 0, 0}, 1 },
+	  { { 0,-1, 1, 1}, {0,0,1,1}, { 0, 1, 0, 0}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 1, 0, 1, 1}, {1,0,1,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,-1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 0, 1, 1, 1}, {0,1,1,1}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {-1,1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 } },
+	{ { { 1, 0, 1, 1}, {1,0,1,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,-1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 0, 1, 1, 1}, {0,1,1,1}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {-1,1,1,1}, { 0, 0, 0, 0}, 2 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 } },
+	{ { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 },
+	  { { 1, 1, 1, 1}, {1,1,1,1}, { 0, 0, 0, 0}, 4 } },
+	{ { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 0, 0, 2, 1}, {0,0,1,1}, { 0, 0,-1, 0}, 3 },
+	  { { 0, 0, 1, 2}, {0,0,1,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 0, 2, 0, 1}, {0,1,0,1}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 0, 2}, {0,1,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 0, 0, 1}, {0,0,0,0}, { 0, 0, 0,-1}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 2, 0, 0, 1}, {2,0,0,1}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 0, 2}, {1,0,0,2}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 0, 0, 1}, {0,0,0,0}, { 0, 0, 0,-1}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 0, 0, 0, 1}, {0,0,0,0}, { 0, 0, 0,-1}, 1 },
+	  { { 0, 0, 0, 2}, {0,0,0,0}, { 0, 0, 0,-2}, 2 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 0, 2, 1, 0}, {0,1,1,0}, { 0,-1, 0, 0}, 3 },
+	  { { 0, 1, 2, 0}, {0,1,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 0, 1, 0}, {0,0,0,0}, { 0, 0,-1, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 0, 1, 0, 0}, {0,0,0,0}, { 0,-1, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 2, 0, 1, 0}, {2,0,1,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 0, 2, 0}, {1,0,1,0}, { 0, 0,-1, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 0, 1, 0}, {0,0,0,0}, { 0, 0,-1, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 1, 0, 0, 0}, {0,0,0,0}, {-1, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 0, 0, 1, 0}, {0,0,0,0}, { 0, 0,-1, 0}, 1 },
+	  { { 0, 0, 2, 0}, {0,0,0,0}, { 0, 0,-2, 0}, 2 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 },
+	  { {-1, 1, 1, 1}, {1,1,1,1}, { 2, 0, 0, 0}, 2 } },
+	{ { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 },
+	  { { 1,-1, 1, 1}, {1,1,1,1}, { 0, 2, 0, 0}, 2 } },
+	{ { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 2, 1, 0, 0}, {2,1,0,0}, { 0, 0, 0, 0}, 3 },
+	  { { 1, 2, 0, 0}, {1,1,0,0}, { 0,-1, 0, 0}, 3 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 0, 1, 0, 0}, {0,0,0,0}, { 0,-1, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 1, 0, 0, 0}, {0,0,0,0}, {-1, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 },
+	  { { 1, 1,-1, 1}, {1,1,1,1}, { 0, 0, 2, 0}, 2 } },
+	{ { { 0, 1, 0, 0}, {0,0,0,0}, { 0,-1, 0, 0}, 1 },
+	  { { 0, 2, 0, 0}, {0,0,0,0}, { 0,-2, 0, 0}, 2 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+	{ { { 1, 0, 0, 0}, {0,0,0,0}, {-1, 0, 0, 0}, 1 },
+	  { { 2, 0, 0, 0}, {0,0,0,0}, {-2, 0, 0, 0}, 2 },
+	  { { 1, 1, 1,-1}, {1,1,1,1}, { 0, 0, 0, 2}, 2 } },
+};
+
+static const uint8_t lattice4_ext_index[4096] = {
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 20,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 21, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 23, 24,  0, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 26, 27,  0, 28,  0,  0,  0, 29,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 30, 31,  0, 32,  0,  0,  0, 33,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 34,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 35, 36,  0, 37,  0,  0,  0, 38,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 39,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 41, 42,  0, 43,  0,  0,  0, 44,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 45,  0, 46,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 47, 48,  0, 49,  0,  0,  0, 50,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 51,  0,  0, 52,  0,  0, 53,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 54, 55,  0, 56,  0,  0,  0, 57,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0, 58, 59,  0,  0, 60, 61,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 62,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 63, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 65, 66,  0, 67,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 68, 69,  0, 70,  0,  0,  0, 71,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 72, 73,  0, 74,  0,  0,  0, 75,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 76,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 77, 78,  0, 79,  0,  0,  0, 80,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 81,  0, 82,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 83, 84,  0, 85,  0,  0,  0, 86,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 87,  0, 88,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 89, 90,  0, 91,  0,  0,  0, 92,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0, 93,  0,  0, 94,  0,  0, 95,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 96, 97,  0, 98,  0,  0,  0, 99,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0, 100, 101,  0,  0, 102, 103,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+#endif
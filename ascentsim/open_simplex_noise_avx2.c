@@ -0,0 +1,9 @@
+/*
+ * AVX2 row kernels of the noise library, see open_simplex_noise.c.  Must be
+ * built with -mavx2 and -ffp-contract=off.
+ */
+#if !defined(__AVX2__)
+#error "open_simplex_noise_avx2.c must be built with -mavx2"
+#endif
+#define OSN_ISA_LEVEL 1
+#include "open_simplex_noise.c"
@@ -0,0 +1,9 @@
+/*
+ * AVX-512 row kernels of the noise library, see open_simplex_noise.c.  Must
+ * be built with -mavx512f and -ffp-contract=off.
+ */
+#if !defined(__AVX512F__)
+#error "open_simplex_noise_avx512.c must be built with -mavx512f"
+#endif
+#define OSN_ISA_LEVEL 2
+#include "open_simplex_noise.c"
@@ -0,0 +1,73 @@
+#ifndef OPEN_SIMPLEX_NOISE_GRADIENTS_H__
+#define OPEN_SIMPLEX_NOISE_GRADIENTS_H__
+
+/*
+ * Gradient sets of OpenSimplex noise, one definition for the C library
+ * (open_simplex_noise.c) and the C++ front end (noise_kernel.h), to which
+ * they are constexpr.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define OSN_GRADIENTS static constexpr
+#else
+#define OSN_GRADIENTS static const
+#endif
+
+/* 
+ * Gradients for 2D. They approximate the directions to the
+ * vertices of an octagon from the center.
+ */
+OSN_GRADIENTS int8_t gradients2D[] = {
+	 5,  2,    2,  5,
+	-5,  2,   -2,  5,
+	 5, -2,    2, -5,
+	-5, -2,   -2, -5,
+};
+
+/*	
+ * Gradients for 3D. They approximate the directions to the
+ * vertices of a rhombicuboctahedron from the center, skewed so
+ * that the triangular and square facets can be inscribed inside
+ * circles of the same radius.
+ */
+OSN_GRADIENTS signed char gradients3D[] = {
+	-11,  4,  4,     -4,  11,  4,    -4,  4,  11,
+	 11,  4,  4,      4,  11,  4,     4,  4,  11,
+	-11, -4,  4,     -4, -11,  4,    -4, -4,  11,
+	 11, -4,  4,      4, -11,  4,     4, -4,  11,
+	-11,  4, -4,     -4,  11, -4,    -4,  4, -11,
+	 11,  4, -4,      4,  11, -4,     4,  4, -11,
+	-11, -4, -4,     -4, -11, -4,    -4, -4, -11,
+	 11, -4, -4,      4, -11, -4,     4, -4, -11,
+};
+
+/*	
+ * Gradients for 4D. They approximate the directions to the
+ * vertices of a disprismatotesseractihexadecachoron from the center,
+ * skewed so that the tetrahedral and cubic facets can be inscribed inside
+ * spheres of the same radius.
+ */
+OSN_GRADIENTS signed char gradients4D[] = {
+	 3,  1,  1,  1,      1,  3,  1,  1,      1,  1,  3,  1,      1,  1,  1,  3,
+	-3,  1,  1,  1,     -1,  3,  1,  1,     -1,  1,  3,  1,     -1,  1,  1,  3,
+	 3, -1,  1,  1,      1, -3,  1,  1,      1, -1,  3,  1,      1, -1,  1,  3,
+	-3, -1,  1,  1,     -1, -3,  1,  1,     -1, -1,  3,  1,     -1, -1,  1,  3,
+	 3,  1, -1,  1,      1,  3, -1,  1,      1,  1, -3,  1,      1,  1, -1,  3,
+	-3,  1, -1,  1,     -1,  3, -1,  1,     -1,  1, -3,  1,     -1,  1, -1,  3,
+	 3, -1, -1,  1,      1, -3, -1,  1,      1, -1, -3,  1,      1, -1, -1,  3,
+	-3, -1, -1,  1,     -1, -3, -1,  1,     -1, -1, -3,  1,     -1, -1, -1,  3,
+	 3,  1,  1, -1,      1,  3,  1, -1,      1,  1,  3, -1,      1,  1,  1, -3,
+	-3,  1,  1, -1,     -1,  3,  1, -1,     -1,  1,  3, -1,     -1,  1,  1, -3,
+	 3, -1,  1, -1,      1, -3,  1, -1,      1, -1,  3, -1,      1, -1,  1, -3,
+	-3, -1,  1, -1,     -1, -3,  1, -1,     -1, -1,  3, -1,     -1, -1,  1, -3,
+	 3,  1, -1, -1,      1,  3, -1, -1,      1,  1, -3, -1,      1,  1, -1, -3,
+	-3,  1, -1, -1,     -1,  3, -1, -1,     -1,  1, -3, -1,     -1,  1, -1, -3,
+	 3, -1, -1, -1,      1, -3, -1, -1,      1, -1, -3, -1,      1, -1, -1, -3,
+	-3, -1, -1, -1,     -1, -3, -1, -1,     -1, -1, -3, -1,     -1, -1, -1, -3,
+};
+
+#undef OSN_GRADIENTS
+
+#endif
@@ -0,0 +1,2766 @@
+/*
+ * 3D and 4D OpenSimplex noise, written once for both precisions.
+ *
+ * open_simplex_noise.c includes this file twice, with OSN_REAL set to double
+ * for the open_simplex_noise3/4 family and to float for the
+ * open_simplex_noise3f/4f family.  Before each inclusion it defines
+ *
+ *   OSN_REAL              the arithmetic type used throughout
+ *   OSN_NAME(base, tail)  the exported name, base##tail or base##f##tail
+ *   ROW_LANES             vector width of the row evaluation, 1 for scalar
+ *   vreal, vint, vmask,   vector operations on ROW_LANES values, their
+ *   v...(), vi...()       lattice coordinates and lane masks
+ *
+ * and everything is undefined again at the end of this file.  The point and
+ * gradient functions are only defined by the scalar build (OSN_ISA_LEVEL 0);
+ * the row forms are static isa_noise* functions, which the including file
+ * collects into its struct osn_row_kernels.
+ */
+
+#define STRETCH_3D ((OSN_REAL)STRETCH_CONSTANT_3D)
+#define SQUISH_3D  ((OSN_REAL)SQUISH_CONSTANT_3D)
+#define STRETCH_4D ((OSN_REAL)STRETCH_CONSTANT_4D)
+#define SQUISH_4D  ((OSN_REAL)SQUISH_CONSTANT_4D)
+#define NORM_3D    ((OSN_REAL)NORM_CONSTANT_3D)
+#define NORM_4D    ((OSN_REAL)NORM_CONSTANT_4D)
+
+#define contribute3 OSN_NAME(contribute3, )
+#define contribute4 OSN_NAME(contribute4, )
+#define noise3_eval OSN_NAME(noise3_eval, )
+#define noise4_eval OSN_NAME(noise4_eval, )
+#define noise4_branch OSN_NAME(noise4_branch, )
+#define noise4_table OSN_NAME(noise4_table, )
+#define closer4 OSN_NAME(closer4, )
+#define region4_key OSN_NAME(region4_key, )
+#define vertex4 OSN_NAME(vertex4, )
+#define squish4 OSN_NAME(squish4, )
+#define noise3_point OSN_NAME(noise3_point, )
+#define noise4_point OSN_NAME(noise4_point, )
+#define lattice_lanes OSN_NAME(lattice_lanes, )
+#define lattice3_lanes OSN_NAME(lattice3_lanes, )
+#define lattice4_lanes OSN_NAME(lattice4_lanes, )
+#define lookup_lanes OSN_NAME(lookup_lanes, )
+#define hash_lanes OSN_NAME(hash_lanes, )
+#define byte_lanes OSN_NAME(byte_lanes, )
+#define gradient_lanes OSN_NAME(gradient_lanes, )
+#define stage4_lanes OSN_NAME(stage4_lanes, )
+#define gradient4_lanes OSN_NAME(gradient4_lanes, )
+#define closer_lanes OSN_NAME(closer_lanes, )
+#define pair_lanes OSN_NAME(pair_lanes, )
+#define contribute3_lanes OSN_NAME(contribute3_lanes, )
+#define contribute4_lanes OSN_NAME(contribute4_lanes, )
+#define region3_lanes OSN_NAME(region3_lanes, )
+#define region4_lanes OSN_NAME(region4_lanes, )
+#define corner3_lanes OSN_NAME(corner3_lanes, )
+#define corner4_lanes OSN_NAME(corner4_lanes, )
+#define ext3_lanes OSN_NAME(ext3_lanes, )
+#define ext4_lanes OSN_NAME(ext4_lanes, )
+#define noise3_lanes OSN_NAME(noise3_lanes, )
+#define noise4_lanes OSN_NAME(noise4_lanes, )
+#define noise4_rows OSN_NAME(noise4_rows, )
+
+/*
+ * Contribution of one lattice vertex: attn^4 times the gradient extrapolated
+ * to the point, where attn is the (positive) falloff 2 - |d|^2.  With grad,
+ * also adds the partial derivatives of the contribution with respect to the
+ * input point, -8 attn^3 (g . d) d + attn^4 g, since d moves with the point.
+ */
+static FORCE_INLINE OSN_REAL contribute3(const struct osn_context *ctx, OSN_REAL *grad, OSN_REAL attn,
+	int xsb, int ysb, int zsb, OSN_REAL dx, OSN_REAL dy, OSN_REAL dz)
+{
+	int index = grad_index3(ctx, xsb, ysb, zsb);
+	OSN_REAL attn2 = attn * attn;
+	OSN_REAL ext = gradients3D[index] * dx
+		+ gradients3D[index + 1] * dy
+		+ gradients3D[index + 2] * dz;
+	if (grad) {
+		OSN_REAL attn4 = attn2 * attn2;
+		OSN_REAL dfall = -8 * attn * attn2 * ext;
+		grad[0] += dfall * dx + attn4 * gradients3D[index];
+		grad[1] += dfall * dy + attn4 * gradients3D[index + 1];
+		grad[2] += dfall * dz + attn4 * gradients3D[index + 2];
+	}
+	return attn2 * attn2 * ext;
+}
+
+static FORCE_INLINE OSN_REAL contribute4(const struct osn_context *ctx, OSN_REAL *grad, OSN_REAL attn,
+	int xsb, int ysb, int zsb, int wsb, OSN_REAL dx, OSN_REAL dy, OSN_REAL dz, OSN_REAL dw)
+{
+	int index = grad_index4(ctx, xsb, ysb, zsb, wsb);
+	OSN_REAL attn2 = attn * attn;
+	OSN_REAL ext = gradients4D[index] * dx
+		+ gradients4D[index + 1] * dy
+		+ gradients4D[index + 2] * dz
+		+ gradients4D[index + 3] * dw;
+	if (grad) {
+		OSN_REAL attn4 = attn2 * attn2;
+		OSN_REAL dfall = -8 * attn * attn2 * ext;
+		grad[0] += dfall * dx + attn4 * gradients4D[index];
+		grad[1] += dfall * dy + attn4 * gradients4D[index + 1];
+		grad[2] += dfall * dz + attn4 * gradients4D[index + 2];
+		grad[3] += dfall * dw + attn4 * gradients4D[index + 3];
+	}
+	return attn2 * attn2 * ext;
+}
+
+/*
+ * Region selection and lattice vertex contributions for 3D noise, given the
+ * super-cell origin and the input point's position relative to it.  With
+ * grad, the partial derivatives of the result are written to grad[0..2]
+ * (3D) or grad[0..3] (4D).
+ */
+static OSN_REAL noise3_eval(const struct osn_context *ctx, OSN_REAL *grad, int xsb, int ysb, int zsb,
+	OSN_REAL xins, OSN_REAL yins, OSN_REAL zins, OSN_REAL dx0, OSN_REAL dy0, OSN_REAL dz0)
+{
+	/* Sum those together to get a value that determines which region we're in. */
+	OSN_REAL inSum = xins + yins + zins;
+
+	if (grad)
+		grad[0] = grad[1] = grad[2] = 0;
+
+	/* We'll be defining these inside the next block and using them afterwards. */
+	OSN_REAL dx_ext0, dy_ext0, dz_ext0;
+	OSN_REAL dx_ext1, dy_ext1, dz_ext1;
+	int xsv_ext0, ysv_ext0, zsv_ext0;
+	int xsv_ext1, ysv_ext1, zsv_ext1;
+
+	OSN_REAL wins;
+	int8_t c, c1, c2;
+	int8_t aPoint, bPoint;
+	OSN_REAL aScore, bScore;
+	int aIsFurtherSide;
+	int bIsFurtherSide;
+	OSN_REAL p1, p2, p3;
+	OSN_REAL score;
+	OSN_REAL attn0, attn1, attn2, attn3, attn4, attn5, attn6;
+	OSN_REAL dx1, dy1, dz1;
+	OSN_REAL dx2, dy2, dz2;
+	OSN_REAL dx3, dy3, dz3;
+	OSN_REAL dx4, dy4, dz4;
+	OSN_REAL dx5, dy5, dz5;
+	OSN_REAL dx6, dy6, dz6;
+	OSN_REAL attn_ext0, attn_ext1;
+	
+	OSN_REAL value = 0;
+	if (inSum <= 1) { /* We're inside the tetrahedron (3-Simplex) at (0,0,0) */
+		
+		/* Determine which two of (0,0,1), (0,1,0), (1,0,0) are closest. */
+		aPoint = 0x01;
+		aScore = xins;
+		bPoint = 0x02;
+		bScore = yins;
+		if (aScore >= bScore && zins > bScore) {
+			bScore = zins;
+			bPoint = 0x04;
+		} else if (aScore < bScore && zins > aScore) {
+			aScore = zins;
+			aPoint = 0x04;
+		}
+		
+		/* Now we determine the two lattice points not part of the tetrahedron that may contribute.
+		   This depends on the closest two tetrahedral vertices, including (0,0,0) */
+		wins = 1 - inSum;
+		if (wins > aScore || wins > bScore) { /* (0,0,0) is one of the closest two tetrahedral vertices. */
+			c = (bScore > aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
+			
+			if ((c & 0x01) == 0) {
+				xsv_ext0 = xsb - 1;
+				xsv_ext1 = xsb;
+				dx_ext0 = dx0 + 1;
+				dx_ext1 = dx0;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb + 1;
+				dx_ext0 = dx_ext1 = dx0 - 1;
+			}
+
+			if ((c & 0x02) == 0) {
+				ysv_ext0 = ysv_ext1 = ysb;
+				dy_ext0 = dy_ext1 = dy0;
+				if ((c & 0x01) == 0) {
+					ysv_ext1 -= 1;
+					dy_ext1 += 1;
+				} else {
+					ysv_ext0 -= 1;
+					dy_ext0 += 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy0 - 1;
+			}
+
+			if ((c & 0x04) == 0) {
+				zsv_ext0 = zsb;
+				zsv_ext1 = zsb - 1;
+				dz_ext0 = dz0;
+				dz_ext1 = dz0 + 1;
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb + 1;
+				dz_ext0 = dz_ext1 = dz0 - 1;
+			}
+		} else { /* (0,0,0) is not one of the closest two tetrahedral vertices. */
+			c = (int8_t)(aPoint | bPoint); /* Our two extra vertices are determined by the closest two. */
+			
+			if ((c & 0x01) == 0) {
+				xsv_ext0 = xsb;
+				xsv_ext1 = xsb - 1;
+				dx_ext0 = dx0 - 2 * SQUISH_3D;
+				dx_ext1 = dx0 + 1 - SQUISH_3D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb + 1;
+				dx_ext0 = dx0 - 1 - 2 * SQUISH_3D;
+				dx_ext1 = dx0 - 1 - SQUISH_3D;
+			}
+
+			if ((c & 0x02) == 0) {
+				ysv_ext0 = ysb;
+				ysv_ext1 = ysb - 1;
+				dy_ext0 = dy0 - 2 * SQUISH_3D;
+				dy_ext1 = dy0 + 1 - SQUISH_3D;
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb + 1;
+				dy_ext0 = dy0 - 1 - 2 * SQUISH_3D;
+				dy_ext1 = dy0 - 1 - SQUISH_3D;
+			}
+
+			if ((c & 0x04) == 0) {
+				zsv_ext0 = zsb;
+				zsv_ext1 = zsb - 1;
+				dz_ext0 = dz0 - 2 * SQUISH_3D;
+				dz_ext1 = dz0 + 1 - SQUISH_3D;
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb + 1;
+				dz_ext0 = dz0 - 1 - 2 * SQUISH_3D;
+				dz_ext1 = dz0 - 1 - SQUISH_3D;
+			}
+		}
+
+		/* Contribution (0,0,0) */
+		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0;
+		if (attn0 > 0) {
+			value += contribute3(ctx, grad, attn0, xsb + 0, ysb + 0, zsb + 0, dx0, dy0, dz0);
+		}
+
+		/* Contribution (1,0,0) */
+		dx1 = dx0 - 1 - SQUISH_3D;
+		dy1 = dy0 - 0 - SQUISH_3D;
+		dz1 = dz0 - 0 - SQUISH_3D;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
+		if (attn1 > 0) {
+			value += contribute3(ctx, grad, attn1, xsb + 1, ysb + 0, zsb + 0, dx1, dy1, dz1);
+		}
+
+		/* Contribution (0,1,0) */
+		dx2 = dx0 - 0 - SQUISH_3D;
+		dy2 = dy0 - 1 - SQUISH_3D;
+		dz2 = dz1;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
+		if (attn2 > 0) {
+			value += contribute3(ctx, grad, attn2, xsb + 0, ysb + 1, zsb + 0, dx2, dy2, dz2);
+		}
+
+		/* Contribution (0,0,1) */
+		dx3 = dx2;
+		dy3 = dy1;
+		dz3 = dz0 - 1 - SQUISH_3D;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
+		if (attn3 > 0) {
+			value += contribute3(ctx, grad, attn3, xsb + 0, ysb + 0, zsb + 1, dx3, dy3, dz3);
+		}
+	} else if (inSum >= 2) { /* We're inside the tetrahedron (3-Simplex) at (1,1,1) */
+	
+		/* Determine which two tetrahedral vertices are the closest, out of (1,1,0), (1,0,1), (0,1,1) but not (1,1,1). */
+		aPoint = 0x06;
+		aScore = xins;
+		bPoint = 0x05;
+		bScore = yins;
+		if (aScore <= bScore && zins < bScore) {
+			bScore = zins;
+			bPoint = 0x03;
+		} else if (aScore > bScore && zins < aScore) {
+			aScore = zins;
+			aPoint = 0x03;
+		}
+		
+		/* Now we determine the two lattice points not part of the tetrahedron that may contribute.
+		   This depends on the closest two tetrahedral vertices, including (1,1,1) */
+		wins = 3 - inSum;
+		if (wins < aScore || wins < bScore) { /* (1,1,1) is one of the closest two tetrahedral vertices. */
+			c = (bScore < aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
+			
+			if ((c & 0x01) != 0) {
+				xsv_ext0 = xsb + 2;
+				xsv_ext1 = xsb + 1;
+				dx_ext0 = dx0 - 2 - 3 * SQUISH_3D;
+				dx_ext1 = dx0 - 1 - 3 * SQUISH_3D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb;
+				dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_3D;
+			}
+
+			if ((c & 0x02) != 0) {
+				ysv_ext0 = ysv_ext1 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_3D;
+				if ((c & 0x01) != 0) {
+					ysv_ext1 += 1;
+					dy_ext1 -= 1;
+				} else {
+					ysv_ext0 += 1;
+					dy_ext0 -= 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb;
+				dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_3D;
+			}
+
+			if ((c & 0x04) != 0) {
+				zsv_ext0 = zsb + 1;
+				zsv_ext1 = zsb + 2;
+				dz_ext0 = dz0 - 1 - 3 * SQUISH_3D;
+				dz_ext1 = dz0 - 2 - 3 * SQUISH_3D;
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb;
+				dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_3D;
+			}
+		} else { /* (1,1,1) is not one of the closest two tetrahedral vertices. */
+			c = (int8_t)(aPoint & bPoint); /* Our two extra vertices are determined by the closest two. */
+			
+			if ((c & 0x01) != 0) {
+				xsv_ext0 = xsb + 1;
+				xsv_ext1 = xsb + 2;
+				dx_ext0 = dx0 - 1 - SQUISH_3D;
+				dx_ext1 = dx0 - 2 - 2 * SQUISH_3D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb;
+				dx_ext0 = dx0 - SQUISH_3D;
+				dx_ext1 = dx0 - 2 * SQUISH_3D;
+			}
+
+			if ((c & 0x02) != 0) {
+				ysv_ext0 = ysb + 1;
+				ysv_ext1 = ysb + 2;
+				dy_ext0 = dy0 - 1 - SQUISH_3D;
+				dy_ext1 = dy0 - 2 - 2 * SQUISH_3D;
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb;
+				dy_ext0 = dy0 - SQUISH_3D;
+				dy_ext1 = dy0 - 2 * SQUISH_3D;
+			}
+
+			if ((c & 0x04) != 0) {
+				zsv_ext0 = zsb + 1;
+				zsv_ext1 = zsb + 2;
+				dz_ext0 = dz0 - 1 - SQUISH_3D;
+				dz_ext1 = dz0 - 2 - 2 * SQUISH_3D;
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb;
+				dz_ext0 = dz0 - SQUISH_3D;
+				dz_ext1 = dz0 - 2 * SQUISH_3D;
+			}
+		}
+		
+		/* Contribution (1,1,0) */
+		dx3 = dx0 - 1 - 2 * SQUISH_3D;
+		dy3 = dy0 - 1 - 2 * SQUISH_3D;
+		dz3 = dz0 - 0 - 2 * SQUISH_3D;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
+		if (attn3 > 0) {
+			value += contribute3(ctx, grad, attn3, xsb + 1, ysb + 1, zsb + 0, dx3, dy3, dz3);
+		}
+
+		/* Contribution (1,0,1) */
+		dx2 = dx3;
+		dy2 = dy0 - 0 - 2 * SQUISH_3D;
+		dz2 = dz0 - 1 - 2 * SQUISH_3D;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
+		if (attn2 > 0) {
+			value += contribute3(ctx, grad, attn2, xsb + 1, ysb + 0, zsb + 1, dx2, dy2, dz2);
+		}
+
+		/* Contribution (0,1,1) */
+		dx1 = dx0 - 0 - 2 * SQUISH_3D;
+		dy1 = dy3;
+		dz1 = dz2;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
+		if (attn1 > 0) {
+			value += contribute3(ctx, grad, attn1, xsb + 0, ysb + 1, zsb + 1, dx1, dy1, dz1);
+		}
+
+		/* Contribution (1,1,1) */
+		dx0 = dx0 - 1 - 3 * SQUISH_3D;
+		dy0 = dy0 - 1 - 3 * SQUISH_3D;
+		dz0 = dz0 - 1 - 3 * SQUISH_3D;
+		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0;
+		if (attn0 > 0) {
+			value += contribute3(ctx, grad, attn0, xsb + 1, ysb + 1, zsb + 1, dx0, dy0, dz0);
+		}
+	} else { /* We're inside the octahedron (Rectified 3-Simplex) in between.
+		        Decide between point (0,0,1) and (1,1,0) as closest */
+		p1 = xins + yins;
+		if (p1 > 1) {
+			aScore = p1 - 1;
+			aPoint = 0x03;
+			aIsFurtherSide = 1;
+		} else {
+			aScore = 1 - p1;
+			aPoint = 0x04;
+			aIsFurtherSide = 0;
+		}
+
+		/* Decide between point (0,1,0) and (1,0,1) as closest */
+		p2 = xins + zins;
+		if (p2 > 1) {
+			bScore = p2 - 1;
+			bPoint = 0x05;
+			bIsFurtherSide = 1;
+		} else {
+			bScore = 1 - p2;
+			bPoint = 0x02;
+			bIsFurtherSide = 0;
+		}
+		
+		/* The closest out of the two (1,0,0) and (0,1,1) will replace the furthest out of the two decided above, if closer. */
+		p3 = yins + zins;
+		if (p3 > 1) {
+			score = p3 - 1;
+			if (aScore <= bScore && aScore < score) {
+				aScore = score;
+				aPoint = 0x06;
+				aIsFurtherSide = 1;
+			} else if (aScore > bScore && bScore < score) {
+				bScore = score;
+				bPoint = 0x06;
+				bIsFurtherSide = 1;
+			}
+		} else {
+			score = 1 - p3;
+			if (aScore <= bScore && aScore < score) {
+				aScore = score;
+				aPoint = 0x01;
+				aIsFurtherSide = 0;
+			} else if (aScore > bScore && bScore < score) {
+				bScore = score;
+				bPoint = 0x01;
+				bIsFurtherSide = 0;
+			}
+		}
+		
+		/* Where each of the two closest points are determines how the extra two vertices are calculated. */
+		if (aIsFurtherSide == bIsFurtherSide) {
+			if (aIsFurtherSide) { /* Both closest points on (1,1,1) side */
+
+				/* One of the two extra points is (1,1,1) */
+				dx_ext0 = dx0 - 1 - 3 * SQUISH_3D;
+				dy_ext0 = dy0 - 1 - 3 * SQUISH_3D;
+				dz_ext0 = dz0 - 1 - 3 * SQUISH_3D;
+				xsv_ext0 = xsb + 1;
+				ysv_ext0 = ysb + 1;
+				zsv_ext0 = zsb + 1;
+
+				/* Other extra point is based on the shared axis. */
+				c = (int8_t)(aPoint & bPoint);
+				if ((c & 0x01) != 0) {
+					dx_ext1 = dx0 - 2 - 2 * SQUISH_3D;
+					dy_ext1 = dy0 - 2 * SQUISH_3D;
+					dz_ext1 = dz0 - 2 * SQUISH_3D;
+					xsv_ext1 = xsb + 2;
+					ysv_ext1 = ysb;
+					zsv_ext1 = zsb;
+				} else if ((c & 0x02) != 0) {
+					dx_ext1 = dx0 - 2 * SQUISH_3D;
+					dy_ext1 = dy0 - 2 - 2 * SQUISH_3D;
+					dz_ext1 = dz0 - 2 * SQUISH_3D;
+					xsv_ext1 = xsb;
+					ysv_ext1 = ysb + 2;
+					zsv_ext1 = zsb;
+				} else {
+					dx_ext1 = dx0 - 2 * SQUISH_3D;
+					dy_ext1 = dy0 - 2 * SQUISH_3D;
+					dz_ext1 = dz0 - 2 - 2 * SQUISH_3D;
+					xsv_ext1 = xsb;
+					ysv_ext1 = ysb;
+					zsv_ext1 = zsb + 2;
+				}
+			} else { /* Both closest points on (0,0,0) side */
+
+				/* One of the two extra points is (0,0,0) */
+				dx_ext0 = dx0;
+				dy_ext0 = dy0;
+				dz_ext0 = dz0;
+				xsv_ext0 = xsb;
+				ysv_ext0 = ysb;
+				zsv_ext0 = zsb;
+
+				/* Other extra point is based on the omitted axis. */
+				c = (int8_t)(aPoint | bPoint);
+				if ((c & 0x01) == 0) {
+					dx_ext1 = dx0 + 1 - SQUISH_3D;
+					dy_ext1 = dy0 - 1 - SQUISH_3D;
+					dz_ext1 = dz0 - 1 - SQUISH_3D;
+					xsv_ext1 = xsb - 1;
+					ysv_ext1 = ysb + 1;
+					zsv_ext1 = zsb + 1;
+				} else if ((c & 0x02) == 0) {
+					dx_ext1 = dx0 - 1 - SQUISH_3D;
+					dy_ext1 = dy0 + 1 - SQUISH_3D;
+					dz_ext1 = dz0 - 1 - SQUISH_3D;
+					xsv_ext1 = xsb + 1;
+					ysv_ext1 = ysb - 1;
+					zsv_ext1 = zsb + 1;
+				} else {
+					dx_ext1 = dx0 - 1 - SQUISH_3D;
+					dy_ext1 = dy0 - 1 - SQUISH_3D;
+					dz_ext1 = dz0 + 1 - SQUISH_3D;
+					xsv_ext1 = xsb + 1;
+					ysv_ext1 = ysb + 1;
+					zsv_ext1 = zsb - 1;
+				}
+			}
+		} else { /* One point on (0,0,0) side, one point on (1,1,1) side */
+			if (aIsFurtherSide) {
+				c1 = aPoint;
+				c2 = bPoint;
+			} else {
+				c1 = bPoint;
+				c2 = aPoint;
+			}
+
+			/* One contribution is a permutation of (1,1,-1) */
+			if ((c1 & 0x01) == 0) {
+				dx_ext0 = dx0 + 1 - SQUISH_3D;
+				dy_ext0 = dy0 - 1 - SQUISH_3D;
+				dz_ext0 = dz0 - 1 - SQUISH_3D;
+				xsv_ext0 = xsb - 1;
+				ysv_ext0 = ysb + 1;
+				zsv_ext0 = zsb + 1;
+			} else if ((c1 & 0x02) == 0) {
+				dx_ext0 = dx0 - 1 - SQUISH_3D;
+				dy_ext0 = dy0 + 1 - SQUISH_3D;
+				dz_ext0 = dz0 - 1 - SQUISH_3D;
+				xsv_ext0 = xsb + 1;
+				ysv_ext0 = ysb - 1;
+				zsv_ext0 = zsb + 1;
+			} else {
+				dx_ext0 = dx0 - 1 - SQUISH_3D;
+				dy_ext0 = dy0 - 1 - SQUISH_3D;
+				dz_ext0 = dz0 + 1 - SQUISH_3D;
+				xsv_ext0 = xsb + 1;
+				ysv_ext0 = ysb + 1;
+				zsv_ext0 = zsb - 1;
+			}
+
+			/* One contribution is a permutation of (0,0,2) */
+			dx_ext1 = dx0 - 2 * SQUISH_3D;
+			dy_ext1 = dy0 - 2 * SQUISH_3D;
+			dz_ext1 = dz0 - 2 * SQUISH_3D;
+			xsv_ext1 = xsb;
+			ysv_ext1 = ysb;
+			zsv_ext1 = zsb;
+			if ((c2 & 0x01) != 0) {
+				dx_ext1 -= 2;
+				xsv_ext1 += 2;
+			} else if ((c2 & 0x02) != 0) {
+				dy_ext1 -= 2;
+				ysv_ext1 += 2;
+			} else {
+				dz_ext1 -= 2;
+				zsv_ext1 += 2;
+			}
+		}
+
+		/* Contribution (1,0,0) */
+		dx1 = dx0 - 1 - SQUISH_3D;
+		dy1 = dy0 - 0 - SQUISH_3D;
+		dz1 = dz0 - 0 - SQUISH_3D;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1;
+		if (attn1 > 0) {
+			value += contribute3(ctx, grad, attn1, xsb + 1, ysb + 0, zsb + 0, dx1, dy1, dz1);
+		}
+
+		/* Contribution (0,1,0) */
+		dx2 = dx0 - 0 - SQUISH_3D;
+		dy2 = dy0 - 1 - SQUISH_3D;
+		dz2 = dz1;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2;
+		if (attn2 > 0) {
+			value += contribute3(ctx, grad, attn2, xsb + 0, ysb + 1, zsb + 0, dx2, dy2, dz2);
+		}
+
+		/* Contribution (0,0,1) */
+		dx3 = dx2;
+		dy3 = dy1;
+		dz3 = dz0 - 1 - SQUISH_3D;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3;
+		if (attn3 > 0) {
+			value += contribute3(ctx, grad, attn3, xsb + 0, ysb + 0, zsb + 1, dx3, dy3, dz3);
+		}
+
+		/* Contribution (1,1,0) */
+		dx4 = dx0 - 1 - 2 * SQUISH_3D;
+		dy4 = dy0 - 1 - 2 * SQUISH_3D;
+		dz4 = dz0 - 0 - 2 * SQUISH_3D;
+		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4;
+		if (attn4 > 0) {
+			value += contribute3(ctx, grad, attn4, xsb + 1, ysb + 1, zsb + 0, dx4, dy4, dz4);
+		}
+
+		/* Contribution (1,0,1) */
+		dx5 = dx4;
+		dy5 = dy0 - 0 - 2 * SQUISH_3D;
+		dz5 = dz0 - 1 - 2 * SQUISH_3D;
+		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5;
+		if (attn5 > 0) {
+			value += contribute3(ctx, grad, attn5, xsb + 1, ysb + 0, zsb + 1, dx5, dy5, dz5);
+		}
+
+		/* Contribution (0,1,1) */
+		dx6 = dx0 - 0 - 2 * SQUISH_3D;
+		dy6 = dy4;
+		dz6 = dz5;
+		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6;
+		if (attn6 > 0) {
+			value += contribute3(ctx, grad, attn6, xsb + 0, ysb + 1, zsb + 1, dx6, dy6, dz6);
+		}
+	}
+
+	/* First extra vertex */
+	attn_ext0 = 2 - dx_ext0 * dx_ext0 - dy_ext0 * dy_ext0 - dz_ext0 * dz_ext0;
+	if (attn_ext0 > 0)
+	{
+		value += contribute3(ctx, grad, attn_ext0, xsv_ext0, ysv_ext0, zsv_ext0, dx_ext0, dy_ext0, dz_ext0);
+	}
+
+	/* Second extra vertex */
+	attn_ext1 = 2 - dx_ext1 * dx_ext1 - dy_ext1 * dy_ext1 - dz_ext1 * dz_ext1;
+	if (attn_ext1 > 0)
+	{
+		value += contribute3(ctx, grad, attn_ext1, xsv_ext1, ysv_ext1, zsv_ext1, dx_ext1, dy_ext1, dz_ext1);
+	}
+	
+	if (grad) {
+		grad[0] /= NORM_3D;
+		grad[1] /= NORM_3D;
+		grad[2] /= NORM_3D;
+	}
+	return value / NORM_3D;
+}
+	
+/*
+ * 3D OpenSimplex (Simplectic) Noise
+ */
+static OSN_REAL noise3_point(const struct osn_context *ctx, OSN_REAL *grad, OSN_REAL x, OSN_REAL y, OSN_REAL z)
+{
+
+	/* Place input coordinates on simplectic honeycomb. */
+	OSN_REAL stretchOffset = (x + y + z) * STRETCH_3D;
+	OSN_REAL xs = x + stretchOffset;
+	OSN_REAL ys = y + stretchOffset;
+	OSN_REAL zs = z + stretchOffset;
+	
+	/* Floor to get simplectic honeycomb coordinates of rhombohedron (stretched cube) super-cell origin. */
+	int xsb = fastFloor(xs);
+	int ysb = fastFloor(ys);
+	int zsb = fastFloor(zs);
+	
+	/* Skew out to get actual coordinates of rhombohedron origin. We'll need these later. */
+	OSN_REAL squishOffset = (xsb + ysb + zsb) * SQUISH_3D;
+	OSN_REAL xb = xsb + squishOffset;
+	OSN_REAL yb = ysb + squishOffset;
+	OSN_REAL zb = zsb + squishOffset;
+	
+	/* Compute simplectic honeycomb coordinates relative to rhombohedral origin. */
+	OSN_REAL xins = xs - xsb;
+	OSN_REAL yins = ys - ysb;
+	OSN_REAL zins = zs - zsb;
+	
+	/* Positions relative to origin point. */
+	OSN_REAL dx0 = x - xb;
+	OSN_REAL dy0 = y - yb;
+	OSN_REAL dz0 = z - zb;
+	
+	return noise3_eval(ctx, grad, xsb, ysb, zsb, xins, yins, zins, dx0, dy0, dz0);
+}
+
+#if OSN_ISA_LEVEL == 0
+OSN_REAL OSN_NAME(open_simplex_noise3, )(const struct osn_context *ctx, OSN_REAL x, OSN_REAL y, OSN_REAL z)
+{
+	return noise3_point(ctx, NULL, x, y, z);
+}
+
+OSN_REAL OSN_NAME(open_simplex_noise3, _grad)(const struct osn_context *ctx, OSN_REAL x, OSN_REAL y, OSN_REAL z, OSN_REAL grad[3])
+{
+	return noise3_point(ctx, grad, x, y, z);
+}
+#endif
+	
+/*
+ * Region selection and lattice vertex contributions for 4D noise, given the
+ * super-cell origin and the input point's position relative to it.  With
+ * grad, the partial derivatives of the result are written to grad[0..2]
+ * (3D) or grad[0..3] (4D).
+ */
+static OSN_REAL noise4_branch(const struct osn_context *ctx, OSN_REAL *grad, int xsb, int ysb, int zsb, int wsb,
+	OSN_REAL xins, OSN_REAL yins, OSN_REAL zins, OSN_REAL wins,
+	OSN_REAL dx0, OSN_REAL dy0, OSN_REAL dz0, OSN_REAL dw0)
+{
+	OSN_REAL uins;
+	OSN_REAL dx1, dy1, dz1, dw1;
+	OSN_REAL dx2, dy2, dz2, dw2;
+	OSN_REAL dx3, dy3, dz3, dw3;
+	OSN_REAL dx4, dy4, dz4, dw4;
+	OSN_REAL dx5, dy5, dz5, dw5;
+	OSN_REAL dx6, dy6, dz6, dw6;
+	OSN_REAL dx7, dy7, dz7, dw7;
+	OSN_REAL dx8, dy8, dz8, dw8;
+	OSN_REAL dx9, dy9, dz9, dw9;
+	OSN_REAL dx10, dy10, dz10, dw10;
+	OSN_REAL attn0, attn1, attn2, attn3, attn4;
+	OSN_REAL attn5, attn6, attn7, attn8, attn9, attn10;
+	OSN_REAL attn_ext0, attn_ext1, attn_ext2;
+	int8_t c, c1, c2;
+	int8_t aPoint, bPoint;
+	OSN_REAL aScore, bScore;
+	int aIsBiggerSide;
+	int bIsBiggerSide;
+	OSN_REAL p1, p2, p3, p4;
+	OSN_REAL score;
+
+	/* Sum those together to get a value that determines which region we're in. */
+	OSN_REAL inSum = xins + yins + zins + wins;
+
+	if (grad)
+		grad[0] = grad[1] = grad[2] = grad[3] = 0;
+
+	/* We'll be defining these inside the next block and using them afterwards. */
+	OSN_REAL dx_ext0, dy_ext0, dz_ext0, dw_ext0;
+	OSN_REAL dx_ext1, dy_ext1, dz_ext1, dw_ext1;
+	OSN_REAL dx_ext2, dy_ext2, dz_ext2, dw_ext2;
+	int xsv_ext0, ysv_ext0, zsv_ext0, wsv_ext0;
+	int xsv_ext1, ysv_ext1, zsv_ext1, wsv_ext1;
+	int xsv_ext2, ysv_ext2, zsv_ext2, wsv_ext2;
+	
+	OSN_REAL value = 0;
+	if (inSum <= 1) { /* We're inside the pentachoron (4-Simplex) at (0,0,0,0) */
+
+		/* Determine which two of (0,0,0,1), (0,0,1,0), (0,1,0,0), (1,0,0,0) are closest. */
+		aPoint = 0x01;
+		aScore = xins;
+		bPoint = 0x02;
+		bScore = yins;
+		if (aScore >= bScore && zins > bScore) {
+			bScore = zins;
+			bPoint = 0x04;
+		} else if (aScore < bScore && zins > aScore) {
+			aScore = zins;
+			aPoint = 0x04;
+		}
+		if (aScore >= bScore && wins > bScore) {
+			bScore = wins;
+			bPoint = 0x08;
+		} else if (aScore < bScore && wins > aScore) {
+			aScore = wins;
+			aPoint = 0x08;
+		}
+		
+		/* Now we determine the three lattice points not part of the pentachoron that may contribute.
+		   This depends on the closest two pentachoron vertices, including (0,0,0,0) */
+		uins = 1 - inSum;
+		if (uins > aScore || uins > bScore) { /* (0,0,0,0) is one of the closest two pentachoron vertices. */
+			c = (bScore > aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
+			if ((c & 0x01) == 0) {
+				xsv_ext0 = xsb - 1;
+				xsv_ext1 = xsv_ext2 = xsb;
+				dx_ext0 = dx0 + 1;
+				dx_ext1 = dx_ext2 = dx0;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb + 1;
+				dx_ext0 = dx_ext1 = dx_ext2 = dx0 - 1;
+			}
+
+			if ((c & 0x02) == 0) {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
+				dy_ext0 = dy_ext1 = dy_ext2 = dy0;
+				if ((c & 0x01) == 0x01) {
+					ysv_ext0 -= 1;
+					dy_ext0 += 1;
+				} else {
+					ysv_ext1 -= 1;
+					dy_ext1 += 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 1;
+			}
+			
+			if ((c & 0x04) == 0) {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
+				dz_ext0 = dz_ext1 = dz_ext2 = dz0;
+				if ((c & 0x03) != 0) {
+					if ((c & 0x03) == 0x03) {
+						zsv_ext0 -= 1;
+						dz_ext0 += 1;
+					} else {
+						zsv_ext1 -= 1;
+						dz_ext1 += 1;
+					}
+				} else {
+					zsv_ext2 -= 1;
+					dz_ext2 += 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
+				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 1;
+			}
+			
+			if ((c & 0x08) == 0) {
+				wsv_ext0 = wsv_ext1 = wsb;
+				wsv_ext2 = wsb - 1;
+				dw_ext0 = dw_ext1 = dw0;
+				dw_ext2 = dw0 + 1;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb + 1;
+				dw_ext0 = dw_ext1 = dw_ext2 = dw0 - 1;
+			}
+		} else { /* (0,0,0,0) is not one of the closest two pentachoron vertices. */
+			c = (int8_t)(aPoint | bPoint); /* Our three extra vertices are determined by the closest two. */
+			
+			if ((c & 0x01) == 0) {
+				xsv_ext0 = xsv_ext2 = xsb;
+				xsv_ext1 = xsb - 1;
+				dx_ext0 = dx0 - 2 * SQUISH_4D;
+				dx_ext1 = dx0 + 1 - SQUISH_4D;
+				dx_ext2 = dx0 - SQUISH_4D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb + 1;
+				dx_ext0 = dx0 - 1 - 2 * SQUISH_4D;
+				dx_ext1 = dx_ext2 = dx0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c & 0x02) == 0) {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
+				dy_ext0 = dy0 - 2 * SQUISH_4D;
+				dy_ext1 = dy_ext2 = dy0 - SQUISH_4D;
+				if ((c & 0x01) == 0x01) {
+					ysv_ext1 -= 1;
+					dy_ext1 += 1;
+				} else {
+					ysv_ext2 -= 1;
+					dy_ext2 += 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
+				dy_ext0 = dy0 - 1 - 2 * SQUISH_4D;
+				dy_ext1 = dy_ext2 = dy0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c & 0x04) == 0) {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
+				dz_ext0 = dz0 - 2 * SQUISH_4D;
+				dz_ext1 = dz_ext2 = dz0 - SQUISH_4D;
+				if ((c & 0x03) == 0x03) {
+					zsv_ext1 -= 1;
+					dz_ext1 += 1;
+				} else {
+					zsv_ext2 -= 1;
+					dz_ext2 += 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
+				dz_ext0 = dz0 - 1 - 2 * SQUISH_4D;
+				dz_ext1 = dz_ext2 = dz0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c & 0x08) == 0) {
+				wsv_ext0 = wsv_ext1 = wsb;
+				wsv_ext2 = wsb - 1;
+				dw_ext0 = dw0 - 2 * SQUISH_4D;
+				dw_ext1 = dw0 - SQUISH_4D;
+				dw_ext2 = dw0 + 1 - SQUISH_4D;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb + 1;
+				dw_ext0 = dw0 - 1 - 2 * SQUISH_4D;
+				dw_ext1 = dw_ext2 = dw0 - 1 - SQUISH_4D;
+			}
+		}
+
+		/* Contribution (0,0,0,0) */
+		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0 - dw0 * dw0;
+		if (attn0 > 0) {
+			value += contribute4(ctx, grad, attn0, xsb + 0, ysb + 0, zsb + 0, wsb + 0, dx0, dy0, dz0, dw0);
+		}
+
+		/* Contribution (1,0,0,0) */
+		dx1 = dx0 - 1 - SQUISH_4D;
+		dy1 = dy0 - 0 - SQUISH_4D;
+		dz1 = dz0 - 0 - SQUISH_4D;
+		dw1 = dw0 - 0 - SQUISH_4D;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
+		if (attn1 > 0) {
+			value += contribute4(ctx, grad, attn1, xsb + 1, ysb + 0, zsb + 0, wsb + 0, dx1, dy1, dz1, dw1);
+		}
+
+		/* Contribution (0,1,0,0) */
+		dx2 = dx0 - 0 - SQUISH_4D;
+		dy2 = dy0 - 1 - SQUISH_4D;
+		dz2 = dz1;
+		dw2 = dw1;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
+		if (attn2 > 0) {
+			value += contribute4(ctx, grad, attn2, xsb + 0, ysb + 1, zsb + 0, wsb + 0, dx2, dy2, dz2, dw2);
+		}
+
+		/* Contribution (0,0,1,0) */
+		dx3 = dx2;
+		dy3 = dy1;
+		dz3 = dz0 - 1 - SQUISH_4D;
+		dw3 = dw1;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
+		if (attn3 > 0) {
+			value += contribute4(ctx, grad, attn3, xsb + 0, ysb + 0, zsb + 1, wsb + 0, dx3, dy3, dz3, dw3);
+		}
+
+		/* Contribution (0,0,0,1) */
+		dx4 = dx2;
+		dy4 = dy1;
+		dz4 = dz1;
+		dw4 = dw0 - 1 - SQUISH_4D;
+		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
+		if (attn4 > 0) {
+			value += contribute4(ctx, grad, attn4, xsb + 0, ysb + 0, zsb + 0, wsb + 1, dx4, dy4, dz4, dw4);
+		}
+	} else if (inSum >= 3) { /* We're inside the pentachoron (4-Simplex) at (1,1,1,1)
+		Determine which two of (1,1,1,0), (1,1,0,1), (1,0,1,1), (0,1,1,1) are closest. */
+		aPoint = 0x0E;
+		aScore = xins;
+		bPoint = 0x0D;
+		bScore = yins;
+		if (aScore <= bScore && zins < bScore) {
+			bScore = zins;
+			bPoint = 0x0B;
+		} else if (aScore > bScore && zins < aScore) {
+			aScore = zins;
+			aPoint = 0x0B;
+		}
+		if (aScore <= bScore && wins < bScore) {
+			bScore = wins;
+			bPoint = 0x07;
+		} else if (aScore > bScore && wins < aScore) {
+			aScore = wins;
+			aPoint = 0x07;
+		}
+		
+		/* Now we determine the three lattice points not part of the pentachoron that may contribute.
+		   This depends on the closest two pentachoron vertices, including (0,0,0,0) */
+		uins = 4 - inSum;
+		if (uins < aScore || uins < bScore) { /* (1,1,1,1) is one of the closest two pentachoron vertices. */
+			c = (bScore < aScore ? bPoint : aPoint); /* Our other closest vertex is the closest out of a and b. */
+			
+			if ((c & 0x01) != 0) {
+				xsv_ext0 = xsb + 2;
+				xsv_ext1 = xsv_ext2 = xsb + 1;
+				dx_ext0 = dx0 - 2 - 4 * SQUISH_4D;
+				dx_ext1 = dx_ext2 = dx0 - 1 - 4 * SQUISH_4D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb;
+				dx_ext0 = dx_ext1 = dx_ext2 = dx0 - 4 * SQUISH_4D;
+			}
+
+			if ((c & 0x02) != 0) {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 1 - 4 * SQUISH_4D;
+				if ((c & 0x01) != 0) {
+					ysv_ext1 += 1;
+					dy_ext1 -= 1;
+				} else {
+					ysv_ext0 += 1;
+					dy_ext0 -= 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
+				dy_ext0 = dy_ext1 = dy_ext2 = dy0 - 4 * SQUISH_4D;
+			}
+			
+			if ((c & 0x04) != 0) {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
+				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 1 - 4 * SQUISH_4D;
+				if ((c & 0x03) != 0x03) {
+					if ((c & 0x03) == 0) {
+						zsv_ext0 += 1;
+						dz_ext0 -= 1;
+					} else {
+						zsv_ext1 += 1;
+						dz_ext1 -= 1;
+					}
+				} else {
+					zsv_ext2 += 1;
+					dz_ext2 -= 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
+				dz_ext0 = dz_ext1 = dz_ext2 = dz0 - 4 * SQUISH_4D;
+			}
+			
+			if ((c & 0x08) != 0) {
+				wsv_ext0 = wsv_ext1 = wsb + 1;
+				wsv_ext2 = wsb + 2;
+				dw_ext0 = dw_ext1 = dw0 - 1 - 4 * SQUISH_4D;
+				dw_ext2 = dw0 - 2 - 4 * SQUISH_4D;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb;
+				dw_ext0 = dw_ext1 = dw_ext2 = dw0 - 4 * SQUISH_4D;
+			}
+		} else { /* (1,1,1,1) is not one of the closest two pentachoron vertices. */
+			c = (int8_t)(aPoint & bPoint); /* Our three extra vertices are determined by the closest two. */
+			
+			if ((c & 0x01) != 0) {
+				xsv_ext0 = xsv_ext2 = xsb + 1;
+				xsv_ext1 = xsb + 2;
+				dx_ext0 = dx0 - 1 - 2 * SQUISH_4D;
+				dx_ext1 = dx0 - 2 - 3 * SQUISH_4D;
+				dx_ext2 = dx0 - 1 - 3 * SQUISH_4D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsv_ext2 = xsb;
+				dx_ext0 = dx0 - 2 * SQUISH_4D;
+				dx_ext1 = dx_ext2 = dx0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c & 0x02) != 0) {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb + 1;
+				dy_ext0 = dy0 - 1 - 2 * SQUISH_4D;
+				dy_ext1 = dy_ext2 = dy0 - 1 - 3 * SQUISH_4D;
+				if ((c & 0x01) != 0) {
+					ysv_ext2 += 1;
+					dy_ext2 -= 1;
+				} else {
+					ysv_ext1 += 1;
+					dy_ext1 -= 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysv_ext2 = ysb;
+				dy_ext0 = dy0 - 2 * SQUISH_4D;
+				dy_ext1 = dy_ext2 = dy0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c & 0x04) != 0) {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb + 1;
+				dz_ext0 = dz0 - 1 - 2 * SQUISH_4D;
+				dz_ext1 = dz_ext2 = dz0 - 1 - 3 * SQUISH_4D;
+				if ((c & 0x03) != 0) {
+					zsv_ext2 += 1;
+					dz_ext2 -= 1;
+				} else {
+					zsv_ext1 += 1;
+					dz_ext1 -= 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsv_ext2 = zsb;
+				dz_ext0 = dz0 - 2 * SQUISH_4D;
+				dz_ext1 = dz_ext2 = dz0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c & 0x08) != 0) {
+				wsv_ext0 = wsv_ext1 = wsb + 1;
+				wsv_ext2 = wsb + 2;
+				dw_ext0 = dw0 - 1 - 2 * SQUISH_4D;
+				dw_ext1 = dw0 - 1 - 3 * SQUISH_4D;
+				dw_ext2 = dw0 - 2 - 3 * SQUISH_4D;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsv_ext2 = wsb;
+				dw_ext0 = dw0 - 2 * SQUISH_4D;
+				dw_ext1 = dw_ext2 = dw0 - 3 * SQUISH_4D;
+			}
+		}
+
+		/* Contribution (1,1,1,0) */
+		dx4 = dx0 - 1 - 3 * SQUISH_4D;
+		dy4 = dy0 - 1 - 3 * SQUISH_4D;
+		dz4 = dz0 - 1 - 3 * SQUISH_4D;
+		dw4 = dw0 - 3 * SQUISH_4D;
+		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
+		if (attn4 > 0) {
+			value += contribute4(ctx, grad, attn4, xsb + 1, ysb + 1, zsb + 1, wsb + 0, dx4, dy4, dz4, dw4);
+		}
+
+		/* Contribution (1,1,0,1) */
+		dx3 = dx4;
+		dy3 = dy4;
+		dz3 = dz0 - 3 * SQUISH_4D;
+		dw3 = dw0 - 1 - 3 * SQUISH_4D;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
+		if (attn3 > 0) {
+			value += contribute4(ctx, grad, attn3, xsb + 1, ysb + 1, zsb + 0, wsb + 1, dx3, dy3, dz3, dw3);
+		}
+
+		/* Contribution (1,0,1,1) */
+		dx2 = dx4;
+		dy2 = dy0 - 3 * SQUISH_4D;
+		dz2 = dz4;
+		dw2 = dw3;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
+		if (attn2 > 0) {
+			value += contribute4(ctx, grad, attn2, xsb + 1, ysb + 0, zsb + 1, wsb + 1, dx2, dy2, dz2, dw2);
+		}
+
+		/* Contribution (0,1,1,1) */
+		dx1 = dx0 - 3 * SQUISH_4D;
+		dz1 = dz4;
+		dy1 = dy4;
+		dw1 = dw3;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
+		if (attn1 > 0) {
+			value += contribute4(ctx, grad, attn1, xsb + 0, ysb + 1, zsb + 1, wsb + 1, dx1, dy1, dz1, dw1);
+		}
+
+		/* Contribution (1,1,1,1) */
+		dx0 = dx0 - 1 - 4 * SQUISH_4D;
+		dy0 = dy0 - 1 - 4 * SQUISH_4D;
+		dz0 = dz0 - 1 - 4 * SQUISH_4D;
+		dw0 = dw0 - 1 - 4 * SQUISH_4D;
+		attn0 = 2 - dx0 * dx0 - dy0 * dy0 - dz0 * dz0 - dw0 * dw0;
+		if (attn0 > 0) {
+			value += contribute4(ctx, grad, attn0, xsb + 1, ysb + 1, zsb + 1, wsb + 1, dx0, dy0, dz0, dw0);
+		}
+	} else if (inSum <= 2) { /* We're inside the first dispentachoron (Rectified 4-Simplex) */
+		aIsBiggerSide = 1;
+		bIsBiggerSide = 1;
+		
+		/* Decide between (1,1,0,0) and (0,0,1,1) */
+		if (xins + yins > zins + wins) {
+			aScore = xins + yins;
+			aPoint = 0x03;
+		} else {
+			aScore = zins + wins;
+			aPoint = 0x0C;
+		}
+		
+		/* Decide between (1,0,1,0) and (0,1,0,1) */
+		if (xins + zins > yins + wins) {
+			bScore = xins + zins;
+			bPoint = 0x05;
+		} else {
+			bScore = yins + wins;
+			bPoint = 0x0A;
+		}
+		
+		/* Closer between (1,0,0,1) and (0,1,1,0) will replace the further of a and b, if closer. */
+		if (xins + wins > yins + zins) {
+			score = xins + wins;
+			if (aScore >= bScore && score > bScore) {
+				bScore = score;
+				bPoint = 0x09;
+			} else if (aScore < bScore && score > aScore) {
+				aScore = score;
+				aPoint = 0x09;
+			}
+		} else {
+			score = yins + zins;
+			if (aScore >= bScore && score > bScore) {
+				bScore = score;
+				bPoint = 0x06;
+			} else if (aScore < bScore && score > aScore) {
+				aScore = score;
+				aPoint = 0x06;
+			}
+		}
+		
+		/* Decide if (1,0,0,0) is closer. */
+		p1 = 2 - inSum + xins;
+		if (aScore >= bScore && p1 > bScore) {
+			bScore = p1;
+			bPoint = 0x01;
+			bIsBiggerSide = 0;
+		} else if (aScore < bScore && p1 > aScore) {
+			aScore = p1;
+			aPoint = 0x01;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (0,1,0,0) is closer. */
+		p2 = 2 - inSum + yins;
+		if (aScore >= bScore && p2 > bScore) {
+			bScore = p2;
+			bPoint = 0x02;
+			bIsBiggerSide = 0;
+		} else if (aScore < bScore && p2 > aScore) {
+			aScore = p2;
+			aPoint = 0x02;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (0,0,1,0) is closer. */
+		p3 = 2 - inSum + zins;
+		if (aScore >= bScore && p3 > bScore) {
+			bScore = p3;
+			bPoint = 0x04;
+			bIsBiggerSide = 0;
+		} else if (aScore < bScore && p3 > aScore) {
+			aScore = p3;
+			aPoint = 0x04;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (0,0,0,1) is closer. */
+		p4 = 2 - inSum + wins;
+		if (aScore >= bScore && p4 > bScore) {
+			bScore = p4;
+			bPoint = 0x08;
+			bIsBiggerSide = 0;
+		} else if (aScore < bScore && p4 > aScore) {
+			aScore = p4;
+			aPoint = 0x08;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Where each of the two closest points are determines how the extra three vertices are calculated. */
+		if (aIsBiggerSide == bIsBiggerSide) {
+			if (aIsBiggerSide) { /* Both closest points on the bigger side */
+				c1 = (int8_t)(aPoint | bPoint);
+				c2 = (int8_t)(aPoint & bPoint);
+				if ((c1 & 0x01) == 0) {
+					xsv_ext0 = xsb;
+					xsv_ext1 = xsb - 1;
+					dx_ext0 = dx0 - 3 * SQUISH_4D;
+					dx_ext1 = dx0 + 1 - 2 * SQUISH_4D;
+				} else {
+					xsv_ext0 = xsv_ext1 = xsb + 1;
+					dx_ext0 = dx0 - 1 - 3 * SQUISH_4D;
+					dx_ext1 = dx0 - 1 - 2 * SQUISH_4D;
+				}
+				
+				if ((c1 & 0x02) == 0) {
+					ysv_ext0 = ysb;
+					ysv_ext1 = ysb - 1;
+					dy_ext0 = dy0 - 3 * SQUISH_4D;
+					dy_ext1 = dy0 + 1 - 2 * SQUISH_4D;
+				} else {
+					ysv_ext0 = ysv_ext1 = ysb + 1;
+					dy_ext0 = dy0 - 1 - 3 * SQUISH_4D;
+					dy_ext1 = dy0 - 1 - 2 * SQUISH_4D;
+				}
+				
+				if ((c1 & 0x04) == 0) {
+					zsv_ext0 = zsb;
+					zsv_ext1 = zsb - 1;
+					dz_ext0 = dz0 - 3 * SQUISH_4D;
+					dz_ext1 = dz0 + 1 - 2 * SQUISH_4D;
+				} else {
+					zsv_ext0 = zsv_ext1 = zsb + 1;
+					dz_ext0 = dz0 - 1 - 3 * SQUISH_4D;
+					dz_ext1 = dz0 - 1 - 2 * SQUISH_4D;
+				}
+				
+				if ((c1 & 0x08) == 0) {
+					wsv_ext0 = wsb;
+					wsv_ext1 = wsb - 1;
+					dw_ext0 = dw0 - 3 * SQUISH_4D;
+					dw_ext1 = dw0 + 1 - 2 * SQUISH_4D;
+				} else {
+					wsv_ext0 = wsv_ext1 = wsb + 1;
+					dw_ext0 = dw0 - 1 - 3 * SQUISH_4D;
+					dw_ext1 = dw0 - 1 - 2 * SQUISH_4D;
+				}
+				
+				/* One combination is a permutation of (0,0,0,2) based on c2 */
+				xsv_ext2 = xsb;
+				ysv_ext2 = ysb;
+				zsv_ext2 = zsb;
+				wsv_ext2 = wsb;
+				dx_ext2 = dx0 - 2 * SQUISH_4D;
+				dy_ext2 = dy0 - 2 * SQUISH_4D;
+				dz_ext2 = dz0 - 2 * SQUISH_4D;
+				dw_ext2 = dw0 - 2 * SQUISH_4D;
+				if ((c2 & 0x01) != 0) {
+					xsv_ext2 += 2;
+					dx_ext2 -= 2;
+				} else if ((c2 & 0x02) != 0) {
+					ysv_ext2 += 2;
+					dy_ext2 -= 2;
+				} else if ((c2 & 0x04) != 0) {
+					zsv_ext2 += 2;
+					dz_ext2 -= 2;
+				} else {
+					wsv_ext2 += 2;
+					dw_ext2 -= 2;
+				}
+				
+			} else { /* Both closest points on the smaller side */
+				/* One of the two extra points is (0,0,0,0) */
+				xsv_ext2 = xsb;
+				ysv_ext2 = ysb;
+				zsv_ext2 = zsb;
+				wsv_ext2 = wsb;
+				dx_ext2 = dx0;
+				dy_ext2 = dy0;
+				dz_ext2 = dz0;
+				dw_ext2 = dw0;
+				
+				/* Other two points are based on the omitted axes. */
+				c = (int8_t)(aPoint | bPoint);
+				
+				if ((c & 0x01) == 0) {
+					xsv_ext0 = xsb - 1;
+					xsv_ext1 = xsb;
+					dx_ext0 = dx0 + 1 - SQUISH_4D;
+					dx_ext1 = dx0 - SQUISH_4D;
+				} else {
+					xsv_ext0 = xsv_ext1 = xsb + 1;
+					dx_ext0 = dx_ext1 = dx0 - 1 - SQUISH_4D;
+				}
+				
+				if ((c & 0x02) == 0) {
+					ysv_ext0 = ysv_ext1 = ysb;
+					dy_ext0 = dy_ext1 = dy0 - SQUISH_4D;
+					if ((c & 0x01) == 0x01)
+					{
+						ysv_ext0 -= 1;
+						dy_ext0 += 1;
+					} else {
+						ysv_ext1 -= 1;
+						dy_ext1 += 1;
+					}
+				} else {
+					ysv_ext0 = ysv_ext1 = ysb + 1;
+					dy_ext0 = dy_ext1 = dy0 - 1 - SQUISH_4D;
+				}
+				
+				if ((c & 0x04) == 0) {
+					zsv_ext0 = zsv_ext1 = zsb;
+					dz_ext0 = dz_ext1 = dz0 - SQUISH_4D;
+					if ((c & 0x03) == 0x03)
+					{
+						zsv_ext0 -= 1;
+						dz_ext0 += 1;
+					} else {
+						zsv_ext1 -= 1;
+						dz_ext1 += 1;
+					}
+				} else {
+					zsv_ext0 = zsv_ext1 = zsb + 1;
+					dz_ext0 = dz_ext1 = dz0 - 1 - SQUISH_4D;
+				}
+				
+				if ((c & 0x08) == 0)
+				{
+					wsv_ext0 = wsb;
+					wsv_ext1 = wsb - 1;
+					dw_ext0 = dw0 - SQUISH_4D;
+					dw_ext1 = dw0 + 1 - SQUISH_4D;
+				} else {
+					wsv_ext0 = wsv_ext1 = wsb + 1;
+					dw_ext0 = dw_ext1 = dw0 - 1 - SQUISH_4D;
+				}
+				
+			}
+		} else { /* One point on each "side" */
+			if (aIsBiggerSide) {
+				c1 = aPoint;
+				c2 = bPoint;
+			} else {
+				c1 = bPoint;
+				c2 = aPoint;
+			}
+			
+			/* Two contributions are the bigger-sided point with each 0 replaced with -1. */
+			if ((c1 & 0x01) == 0) {
+				xsv_ext0 = xsb - 1;
+				xsv_ext1 = xsb;
+				dx_ext0 = dx0 + 1 - SQUISH_4D;
+				dx_ext1 = dx0 - SQUISH_4D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb + 1;
+				dx_ext0 = dx_ext1 = dx0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c1 & 0x02) == 0) {
+				ysv_ext0 = ysv_ext1 = ysb;
+				dy_ext0 = dy_ext1 = dy0 - SQUISH_4D;
+				if ((c1 & 0x01) == 0x01) {
+					ysv_ext0 -= 1;
+					dy_ext0 += 1;
+				} else {
+					ysv_ext1 -= 1;
+					dy_ext1 += 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c1 & 0x04) == 0) {
+				zsv_ext0 = zsv_ext1 = zsb;
+				dz_ext0 = dz_ext1 = dz0 - SQUISH_4D;
+				if ((c1 & 0x03) == 0x03) {
+					zsv_ext0 -= 1;
+					dz_ext0 += 1;
+				} else {
+					zsv_ext1 -= 1;
+					dz_ext1 += 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb + 1;
+				dz_ext0 = dz_ext1 = dz0 - 1 - SQUISH_4D;
+			}
+			
+			if ((c1 & 0x08) == 0) {
+				wsv_ext0 = wsb;
+				wsv_ext1 = wsb - 1;
+				dw_ext0 = dw0 - SQUISH_4D;
+				dw_ext1 = dw0 + 1 - SQUISH_4D;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsb + 1;
+				dw_ext0 = dw_ext1 = dw0 - 1 - SQUISH_4D;
+			}
+
+			/* One contribution is a permutation of (0,0,0,2) based on the smaller-sided point */
+			xsv_ext2 = xsb;
+			ysv_ext2 = ysb;
+			zsv_ext2 = zsb;
+			wsv_ext2 = wsb;
+			dx_ext2 = dx0 - 2 * SQUISH_4D;
+			dy_ext2 = dy0 - 2 * SQUISH_4D;
+			dz_ext2 = dz0 - 2 * SQUISH_4D;
+			dw_ext2 = dw0 - 2 * SQUISH_4D;
+			if ((c2 & 0x01) != 0) {
+				xsv_ext2 += 2;
+				dx_ext2 -= 2;
+			} else if ((c2 & 0x02) != 0) {
+				ysv_ext2 += 2;
+				dy_ext2 -= 2;
+			} else if ((c2 & 0x04) != 0) {
+				zsv_ext2 += 2;
+				dz_ext2 -= 2;
+			} else {
+				wsv_ext2 += 2;
+				dw_ext2 -= 2;
+			}
+		}
+		
+		/* Contribution (1,0,0,0) */
+		dx1 = dx0 - 1 - SQUISH_4D;
+		dy1 = dy0 - 0 - SQUISH_4D;
+		dz1 = dz0 - 0 - SQUISH_4D;
+		dw1 = dw0 - 0 - SQUISH_4D;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
+		if (attn1 > 0) {
+			value += contribute4(ctx, grad, attn1, xsb + 1, ysb + 0, zsb + 0, wsb + 0, dx1, dy1, dz1, dw1);
+		}
+
+		/* Contribution (0,1,0,0) */
+		dx2 = dx0 - 0 - SQUISH_4D;
+		dy2 = dy0 - 1 - SQUISH_4D;
+		dz2 = dz1;
+		dw2 = dw1;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
+		if (attn2 > 0) {
+			value += contribute4(ctx, grad, attn2, xsb + 0, ysb + 1, zsb + 0, wsb + 0, dx2, dy2, dz2, dw2);
+		}
+
+		/* Contribution (0,0,1,0) */
+		dx3 = dx2;
+		dy3 = dy1;
+		dz3 = dz0 - 1 - SQUISH_4D;
+		dw3 = dw1;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
+		if (attn3 > 0) {
+			value += contribute4(ctx, grad, attn3, xsb + 0, ysb + 0, zsb + 1, wsb + 0, dx3, dy3, dz3, dw3);
+		}
+
+		/* Contribution (0,0,0,1) */
+		dx4 = dx2;
+		dy4 = dy1;
+		dz4 = dz1;
+		dw4 = dw0 - 1 - SQUISH_4D;
+		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
+		if (attn4 > 0) {
+			value += contribute4(ctx, grad, attn4, xsb + 0, ysb + 0, zsb + 0, wsb + 1, dx4, dy4, dz4, dw4);
+		}
+		
+		/* Contribution (1,1,0,0) */
+		dx5 = dx0 - 1 - 2 * SQUISH_4D;
+		dy5 = dy0 - 1 - 2 * SQUISH_4D;
+		dz5 = dz0 - 0 - 2 * SQUISH_4D;
+		dw5 = dw0 - 0 - 2 * SQUISH_4D;
+		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5 - dw5 * dw5;
+		if (attn5 > 0) {
+			value += contribute4(ctx, grad, attn5, xsb + 1, ysb + 1, zsb + 0, wsb + 0, dx5, dy5, dz5, dw5);
+		}
+		
+		/* Contribution (1,0,1,0) */
+		dx6 = dx0 - 1 - 2 * SQUISH_4D;
+		dy6 = dy0 - 0 - 2 * SQUISH_4D;
+		dz6 = dz0 - 1 - 2 * SQUISH_4D;
+		dw6 = dw0 - 0 - 2 * SQUISH_4D;
+		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6 - dw6 * dw6;
+		if (attn6 > 0) {
+			value += contribute4(ctx, grad, attn6, xsb + 1, ysb + 0, zsb + 1, wsb + 0, dx6, dy6, dz6, dw6);
+		}
+
+		/* Contribution (1,0,0,1) */
+		dx7 = dx0 - 1 - 2 * SQUISH_4D;
+		dy7 = dy0 - 0 - 2 * SQUISH_4D;
+		dz7 = dz0 - 0 - 2 * SQUISH_4D;
+		dw7 = dw0 - 1 - 2 * SQUISH_4D;
+		attn7 = 2 - dx7 * dx7 - dy7 * dy7 - dz7 * dz7 - dw7 * dw7;
+		if (attn7 > 0) {
+			value += contribute4(ctx, grad, attn7, xsb + 1, ysb + 0, zsb + 0, wsb + 1, dx7, dy7, dz7, dw7);
+		}
+		
+		/* Contribution (0,1,1,0) */
+		dx8 = dx0 - 0 - 2 * SQUISH_4D;
+		dy8 = dy0 - 1 - 2 * SQUISH_4D;
+		dz8 = dz0 - 1 - 2 * SQUISH_4D;
+		dw8 = dw0 - 0 - 2 * SQUISH_4D;
+		attn8 = 2 - dx8 * dx8 - dy8 * dy8 - dz8 * dz8 - dw8 * dw8;
+		if (attn8 > 0) {
+			value += contribute4(ctx, grad, attn8, xsb + 0, ysb + 1, zsb + 1, wsb + 0, dx8, dy8, dz8, dw8);
+		}
+		
+		/* Contribution (0,1,0,1) */
+		dx9 = dx0 - 0 - 2 * SQUISH_4D;
+		dy9 = dy0 - 1 - 2 * SQUISH_4D;
+		dz9 = dz0 - 0 - 2 * SQUISH_4D;
+		dw9 = dw0 - 1 - 2 * SQUISH_4D;
+		attn9 = 2 - dx9 * dx9 - dy9 * dy9 - dz9 * dz9 - dw9 * dw9;
+		if (attn9 > 0) {
+			value += contribute4(ctx, grad, attn9, xsb + 0, ysb + 1, zsb + 0, wsb + 1, dx9, dy9, dz9, dw9);
+		}
+		
+		/* Contribution (0,0,1,1) */
+		dx10 = dx0 - 0 - 2 * SQUISH_4D;
+		dy10 = dy0 - 0 - 2 * SQUISH_4D;
+		dz10 = dz0 - 1 - 2 * SQUISH_4D;
+		dw10 = dw0 - 1 - 2 * SQUISH_4D;
+		attn10 = 2 - dx10 * dx10 - dy10 * dy10 - dz10 * dz10 - dw10 * dw10;
+		if (attn10 > 0) {
+			value += contribute4(ctx, grad, attn10, xsb + 0, ysb + 0, zsb + 1, wsb + 1, dx10, dy10, dz10, dw10);
+		}
+	} else { /* We're inside the second dispentachoron (Rectified 4-Simplex) */
+		aIsBiggerSide = 1;
+		bIsBiggerSide = 1;
+		
+		/* Decide between (0,0,1,1) and (1,1,0,0) */
+		if (xins + yins < zins + wins) {
+			aScore = xins + yins;
+			aPoint = 0x0C;
+		} else {
+			aScore = zins + wins;
+			aPoint = 0x03;
+		}
+		
+		/* Decide between (0,1,0,1) and (1,0,1,0) */
+		if (xins + zins < yins + wins) {
+			bScore = xins + zins;
+			bPoint = 0x0A;
+		} else {
+			bScore = yins + wins;
+			bPoint = 0x05;
+		}
+		
+		/* Closer between (0,1,1,0) and (1,0,0,1) will replace the further of a and b, if closer. */
+		if (xins + wins < yins + zins) {
+			score = xins + wins;
+			if (aScore <= bScore && score < bScore) {
+				bScore = score;
+				bPoint = 0x06;
+			} else if (aScore > bScore && score < aScore) {
+				aScore = score;
+				aPoint = 0x06;
+			}
+		} else {
+			score = yins + zins;
+			if (aScore <= bScore && score < bScore) {
+				bScore = score;
+				bPoint = 0x09;
+			} else if (aScore > bScore && score < aScore) {
+				aScore = score;
+				aPoint = 0x09;
+			}
+		}
+		
+		/* Decide if (0,1,1,1) is closer. */
+		p1 = 3 - inSum + xins;
+		if (aScore <= bScore && p1 < bScore) {
+			bScore = p1;
+			bPoint = 0x0E;
+			bIsBiggerSide = 0;
+		} else if (aScore > bScore && p1 < aScore) {
+			aScore = p1;
+			aPoint = 0x0E;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (1,0,1,1) is closer. */
+		p2 = 3 - inSum + yins;
+		if (aScore <= bScore && p2 < bScore) {
+			bScore = p2;
+			bPoint = 0x0D;
+			bIsBiggerSide = 0;
+		} else if (aScore > bScore && p2 < aScore) {
+			aScore = p2;
+			aPoint = 0x0D;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (1,1,0,1) is closer. */
+		p3 = 3 - inSum + zins;
+		if (aScore <= bScore && p3 < bScore) {
+			bScore = p3;
+			bPoint = 0x0B;
+			bIsBiggerSide = 0;
+		} else if (aScore > bScore && p3 < aScore) {
+			aScore = p3;
+			aPoint = 0x0B;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Decide if (1,1,1,0) is closer. */
+		p4 = 3 - inSum + wins;
+		if (aScore <= bScore && p4 < bScore) {
+			bScore = p4;
+			bPoint = 0x07;
+			bIsBiggerSide = 0;
+		} else if (aScore > bScore && p4 < aScore) {
+			aScore = p4;
+			aPoint = 0x07;
+			aIsBiggerSide = 0;
+		}
+		
+		/* Where each of the two closest points are determines how the extra three vertices are calculated. */
+		if (aIsBiggerSide == bIsBiggerSide) {
+			if (aIsBiggerSide) { /* Both closest points on the bigger side */
+				c1 = (int8_t)(aPoint & bPoint);
+				c2 = (int8_t)(aPoint | bPoint);
+				
+				/* Two contributions are permutations of (0,0,0,1) and (0,0,0,2) based on c1 */
+				xsv_ext0 = xsv_ext1 = xsb;
+				ysv_ext0 = ysv_ext1 = ysb;
+				zsv_ext0 = zsv_ext1 = zsb;
+				wsv_ext0 = wsv_ext1 = wsb;
+				dx_ext0 = dx0 - SQUISH_4D;
+				dy_ext0 = dy0 - SQUISH_4D;
+				dz_ext0 = dz0 - SQUISH_4D;
+				dw_ext0 = dw0 - SQUISH_4D;
+				dx_ext1 = dx0 - 2 * SQUISH_4D;
+				dy_ext1 = dy0 - 2 * SQUISH_4D;
+				dz_ext1 = dz0 - 2 * SQUISH_4D;
+				dw_ext1 = dw0 - 2 * SQUISH_4D;
+				if ((c1 & 0x01) != 0) {
+					xsv_ext0 += 1;
+					dx_ext0 -= 1;
+					xsv_ext1 += 2;
+					dx_ext1 -= 2;
+				} else if ((c1 & 0x02) != 0) {
+					ysv_ext0 += 1;
+					dy_ext0 -= 1;
+					ysv_ext1 += 2;
+					dy_ext1 -= 2;
+				} else if ((c1 & 0x04) != 0) {
+					zsv_ext0 += 1;
+					dz_ext0 -= 1;
+					zsv_ext1 += 2;
+					dz_ext1 -= 2;
+				} else {
+					wsv_ext0 += 1;
+					dw_ext0 -= 1;
+					wsv_ext1 += 2;
+					dw_ext1 -= 2;
+				}
+				
+				/* One contribution is a permutation of (1,1,1,-1) based on c2 */
+				xsv_ext2 = xsb + 1;
+				ysv_ext2 = ysb + 1;
+				zsv_ext2 = zsb + 1;
+				wsv_ext2 = wsb + 1;
+				dx_ext2 = dx0 - 1 - 2 * SQUISH_4D;
+				dy_ext2 = dy0 - 1 - 2 * SQUISH_4D;
+				dz_ext2 = dz0 - 1 - 2 * SQUISH_4D;
+				dw_ext2 = dw0 - 1 - 2 * SQUISH_4D;
+				if ((c2 & 0x01) == 0) {
+					xsv_ext2 -= 2;
+					dx_ext2 += 2;
+				} else if ((c2 & 0x02) == 0) {
+					ysv_ext2 -= 2;
+					dy_ext2 += 2;
+				} else if ((c2 & 0x04) == 0) {
+					zsv_ext2 -= 2;
+					dz_ext2 += 2;
+				} else {
+					wsv_ext2 -= 2;
+					dw_ext2 += 2;
+				}
+			} else { /* Both closest points on the smaller side */
+				/* One of the two extra points is (1,1,1,1) */
+				xsv_ext2 = xsb + 1;
+				ysv_ext2 = ysb + 1;
+				zsv_ext2 = zsb + 1;
+				wsv_ext2 = wsb + 1;
+				dx_ext2 = dx0 - 1 - 4 * SQUISH_4D;
+				dy_ext2 = dy0 - 1 - 4 * SQUISH_4D;
+				dz_ext2 = dz0 - 1 - 4 * SQUISH_4D;
+				dw_ext2 = dw0 - 1 - 4 * SQUISH_4D;
+				
+				/* Other two points are based on the shared axes. */
+				c = (int8_t)(aPoint & bPoint);
+				
+				if ((c & 0x01) != 0) {
+					xsv_ext0 = xsb + 2;
+					xsv_ext1 = xsb + 1;
+					dx_ext0 = dx0 - 2 - 3 * SQUISH_4D;
+					dx_ext1 = dx0 - 1 - 3 * SQUISH_4D;
+				} else {
+					xsv_ext0 = xsv_ext1 = xsb;
+					dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_4D;
+				}
+				
+				if ((c & 0x02) != 0) {
+					ysv_ext0 = ysv_ext1 = ysb + 1;
+					dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_4D;
+					if ((c & 0x01) == 0)
+					{
+						ysv_ext0 += 1;
+						dy_ext0 -= 1;
+					} else {
+						ysv_ext1 += 1;
+						dy_ext1 -= 1;
+					}
+				} else {
+					ysv_ext0 = ysv_ext1 = ysb;
+					dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_4D;
+				}
+				
+				if ((c & 0x04) != 0) {
+					zsv_ext0 = zsv_ext1 = zsb + 1;
+					dz_ext0 = dz_ext1 = dz0 - 1 - 3 * SQUISH_4D;
+					if ((c & 0x03) == 0)
+					{
+						zsv_ext0 += 1;
+						dz_ext0 -= 1;
+					} else {
+						zsv_ext1 += 1;
+						dz_ext1 -= 1;
+					}
+				} else {
+					zsv_ext0 = zsv_ext1 = zsb;
+					dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_4D;
+				}
+				
+				if ((c & 0x08) != 0)
+				{
+					wsv_ext0 = wsb + 1;
+					wsv_ext1 = wsb + 2;
+					dw_ext0 = dw0 - 1 - 3 * SQUISH_4D;
+					dw_ext1 = dw0 - 2 - 3 * SQUISH_4D;
+				} else {
+					wsv_ext0 = wsv_ext1 = wsb;
+					dw_ext0 = dw_ext1 = dw0 - 3 * SQUISH_4D;
+				}
+			}
+		} else { /* One point on each "side" */
+			if (aIsBiggerSide) {
+				c1 = aPoint;
+				c2 = bPoint;
+			} else {
+				c1 = bPoint;
+				c2 = aPoint;
+			}
+			
+			/* Two contributions are the bigger-sided point with each 1 replaced with 2. */
+			if ((c1 & 0x01) != 0) {
+				xsv_ext0 = xsb + 2;
+				xsv_ext1 = xsb + 1;
+				dx_ext0 = dx0 - 2 - 3 * SQUISH_4D;
+				dx_ext1 = dx0 - 1 - 3 * SQUISH_4D;
+			} else {
+				xsv_ext0 = xsv_ext1 = xsb;
+				dx_ext0 = dx_ext1 = dx0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c1 & 0x02) != 0) {
+				ysv_ext0 = ysv_ext1 = ysb + 1;
+				dy_ext0 = dy_ext1 = dy0 - 1 - 3 * SQUISH_4D;
+				if ((c1 & 0x01) == 0) {
+					ysv_ext0 += 1;
+					dy_ext0 -= 1;
+				} else {
+					ysv_ext1 += 1;
+					dy_ext1 -= 1;
+				}
+			} else {
+				ysv_ext0 = ysv_ext1 = ysb;
+				dy_ext0 = dy_ext1 = dy0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c1 & 0x04) != 0) {
+				zsv_ext0 = zsv_ext1 = zsb + 1;
+				dz_ext0 = dz_ext1 = dz0 - 1 - 3 * SQUISH_4D;
+				if ((c1 & 0x03) == 0) {
+					zsv_ext0 += 1;
+					dz_ext0 -= 1;
+				} else {
+					zsv_ext1 += 1;
+					dz_ext1 -= 1;
+				}
+			} else {
+				zsv_ext0 = zsv_ext1 = zsb;
+				dz_ext0 = dz_ext1 = dz0 - 3 * SQUISH_4D;
+			}
+			
+			if ((c1 & 0x08) != 0) {
+				wsv_ext0 = wsb + 1;
+				wsv_ext1 = wsb + 2;
+				dw_ext0 = dw0 - 1 - 3 * SQUISH_4D;
+				dw_ext1 = dw0 - 2 - 3 * SQUISH_4D;
+			} else {
+				wsv_ext0 = wsv_ext1 = wsb;
+				dw_ext0 = dw_ext1 = dw0 - 3 * SQUISH_4D;
+			}
+
+			/* One contribution is a permutation of (1,1,1,-1) based on the smaller-sided point */
+			xsv_ext2 = xsb + 1;
+			ysv_ext2 = ysb + 1;
+			zsv_ext2 = zsb + 1;
+			wsv_ext2 = wsb + 1;
+			dx_ext2 = dx0 - 1 - 2 * SQUISH_4D;
+			dy_ext2 = dy0 - 1 - 2 * SQUISH_4D;
+			dz_ext2 = dz0 - 1 - 2 * SQUISH_4D;
+			dw_ext2 = dw0 - 1 - 2 * SQUISH_4D;
+			if ((c2 & 0x01) == 0) {
+				xsv_ext2 -= 2;
+				dx_ext2 += 2;
+			} else if ((c2 & 0x02) == 0) {
+				ysv_ext2 -= 2;
+				dy_ext2 += 2;
+			} else if ((c2 & 0x04) == 0) {
+				zsv_ext2 -= 2;
+				dz_ext2 += 2;
+			} else {
+				wsv_ext2 -= 2;
+				dw_ext2 += 2;
+			}
+		}
+		
+		/* Contribution (1,1,1,0) */
+		dx4 = dx0 - 1 - 3 * SQUISH_4D;
+		dy4 = dy0 - 1 - 3 * SQUISH_4D;
+		dz4 = dz0 - 1 - 3 * SQUISH_4D;
+		dw4 = dw0 - 3 * SQUISH_4D;
+		attn4 = 2 - dx4 * dx4 - dy4 * dy4 - dz4 * dz4 - dw4 * dw4;
+		if (attn4 > 0) {
+			value += contribute4(ctx, grad, attn4, xsb + 1, ysb + 1, zsb + 1, wsb + 0, dx4, dy4, dz4, dw4);
+		}
+
+		/* Contribution (1,1,0,1) */
+		dx3 = dx4;
+		dy3 = dy4;
+		dz3 = dz0 - 3 * SQUISH_4D;
+		dw3 = dw0 - 1 - 3 * SQUISH_4D;
+		attn3 = 2 - dx3 * dx3 - dy3 * dy3 - dz3 * dz3 - dw3 * dw3;
+		if (attn3 > 0) {
+			value += contribute4(ctx, grad, attn3, xsb + 1, ysb + 1, zsb + 0, wsb + 1, dx3, dy3, dz3, dw3);
+		}
+
+		/* Contribution (1,0,1,1) */
+		dx2 = dx4;
+		dy2 = dy0 - 3 * SQUISH_4D;
+		dz2 = dz4;
+		dw2 = dw3;
+		attn2 = 2 - dx2 * dx2 - dy2 * dy2 - dz2 * dz2 - dw2 * dw2;
+		if (attn2 > 0) {
+			value += contribute4(ctx, grad, attn2, xsb + 1, ysb + 0, zsb + 1, wsb + 1, dx2, dy2, dz2, dw2);
+		}
+
+		/* Contribution (0,1,1,1) */
+		dx1 = dx0 - 3 * SQUISH_4D;
+		dz1 = dz4;
+		dy1 = dy4;
+		dw1 = dw3;
+		attn1 = 2 - dx1 * dx1 - dy1 * dy1 - dz1 * dz1 - dw1 * dw1;
+		if (attn1 > 0) {
+			value += contribute4(ctx, grad, attn1, xsb + 0, ysb + 1, zsb + 1, wsb + 1, dx1, dy1, dz1, dw1);
+		}
+		
+		/* Contribution (1,1,0,0) */
+		dx5 = dx0 - 1 - 2 * SQUISH_4D;
+		dy5 = dy0 - 1 - 2 * SQUISH_4D;
+		dz5 = dz0 - 0 - 2 * SQUISH_4D;
+		dw5 = dw0 - 0 - 2 * SQUISH_4D;
+		attn5 = 2 - dx5 * dx5 - dy5 * dy5 - dz5 * dz5 - dw5 * dw5;
+		if (attn5 > 0) {
+			value += contribute4(ctx, grad, attn5, xsb + 1, ysb + 1, zsb + 0, wsb + 0, dx5, dy5, dz5, dw5);
+		}
+		
+		/* Contribution (1,0,1,0) */
+		dx6 = dx0 - 1 - 2 * SQUISH_4D;
+		dy6 = dy0 - 0 - 2 * SQUISH_4D;
+		dz6 = dz0 - 1 - 2 * SQUISH_4D;
+		dw6 = dw0 - 0 - 2 * SQUISH_4D;
+		attn6 = 2 - dx6 * dx6 - dy6 * dy6 - dz6 * dz6 - dw6 * dw6;
+		if (attn6 > 0) {
+			value += contribute4(ctx, grad, attn6, xsb + 1, ysb + 0, zsb + 1, wsb + 0, dx6, dy6, dz6, dw6);
+		}
+
+		/* Contribution (1,0,0,1) */
+		dx7 = dx0 - 1 - 2 * SQUISH_4D;
+		dy7 = dy0 - 0 - 2 * SQUISH_4D;
+		dz7 = dz0 - 0 - 2 * SQUISH_4D;
+		dw7 = dw0 - 1 - 2 * SQUISH_4D;
+		attn7 = 2 - dx7 * dx7 - dy7 * dy7 - dz7 * dz7 - dw7 * dw7;
+		if (attn7 > 0) {
+			value += contribute4(ctx, grad, attn7, xsb + 1, ysb + 0, zsb + 0, wsb + 1, dx7, dy7, dz7, dw7);
+		}
+		
+		/* Contribution (0,1,1,0) */
+		dx8 = dx0 - 0 - 2 * SQUISH_4D;
+		dy8 = dy0 - 1 - 2 * SQUISH_4D;
+		dz8 = dz0 - 1 - 2 * SQUISH_4D;
+		dw8 = dw0 - 0 - 2 * SQUISH_4D;
+		attn8 = 2 - dx8 * dx8 - dy8 * dy8 - dz8 * dz8 - dw8 * dw8;
+		if (attn8 > 0) {
+			value += contribute4(ctx, grad, attn8, xsb + 0, ysb + 1, zsb + 1, wsb + 0, dx8, dy8, dz8, dw8);
+		}
+		
+		/* Contribution (0,1,0,1) */
+		dx9 = dx0 - 0 - 2 * SQUISH_4D;
+		dy9 = dy0 - 1 - 2 * SQUISH_4D;
+		dz9 = dz0 - 0 - 2 * SQUISH_4D;
+		dw9 = dw0 - 1 - 2 * SQUISH_4D;
+		attn9 = 2 - dx9 * dx9 - dy9 * dy9 - dz9 * dz9 - dw9 * dw9;
+		if (attn9 > 0) {
+			value += contribute4(ctx, grad, attn9, xsb + 0, ysb + 1, zsb + 0, wsb + 1, dx9, dy9, dz9, dw9);
+		}
+		
+		/* Contribution (0,0,1,1) */
+		dx10 = dx0 - 0 - 2 * SQUISH_4D;
+		dy10 = dy0 - 0 - 2 * SQUISH_4D;
+		dz10 = dz0 - 1 - 2 * SQUISH_4D;
+		dw10 = dw0 - 1 - 2 * SQUISH_4D;
+		attn10 = 2 - dx10 * dx10 - dy10 * dy10 - dz10 * dz10 - dw10 * dw10;
+		if (attn10 > 0) {
+			value += contribute4(ctx, grad, attn10, xsb + 0, ysb + 0, zsb + 1, wsb + 1, dx10, dy10, dz10, dw10);
+		}
+	}
+
+	/* First extra vertex */
+	attn_ext0 = 2 - dx_ext0 * dx_ext0 - dy_ext0 * dy_ext0 - dz_ext0 * dz_ext0 - dw_ext0 * dw_ext0;
+	if (attn_ext0 > 0)
+	{
+		value += contribute4(ctx, grad, attn_ext0, xsv_ext0, ysv_ext0, zsv_ext0, wsv_ext0, dx_ext0, dy_ext0, dz_ext0, dw_ext0);
+	}
+
+	/* Second extra vertex */
+	attn_ext1 = 2 - dx_ext1 * dx_ext1 - dy_ext1 * dy_ext1 - dz_ext1 * dz_ext1 - dw_ext1 * dw_ext1;
+	if (attn_ext1 > 0)
+	{
+		value += contribute4(ctx, grad, attn_ext1, xsv_ext1, ysv_ext1, zsv_ext1, wsv_ext1, dx_ext1, dy_ext1, dz_ext1, dw_ext1);
+	}
+
+	/* Third extra vertex */
+	attn_ext2 = 2 - dx_ext2 * dx_ext2 - dy_ext2 * dy_ext2 - dz_ext2 * dz_ext2 - dw_ext2 * dw_ext2;
+	if (attn_ext2 > 0)
+	{
+		value += contribute4(ctx, grad, attn_ext2, xsv_ext2, ysv_ext2, zsv_ext2, wsv_ext2, dx_ext2, dy_ext2, dz_ext2, dw_ext2);
+	}
+
+	if (grad) {
+		grad[0] /= NORM_4D;
+		grad[1] /= NORM_4D;
+		grad[2] /= NORM_4D;
+		grad[3] /= NORM_4D;
+	}
+	return value / NORM_4D;
+}
+
+/* k * SQUISH_4D, rounded as the branching code rounds it. */
+static const OSN_REAL squish4[5] = { 0, SQUISH_4D, 2 * SQUISH_4D, 3 * SQUISH_4D, 4 * SQUISH_4D };
+
+/*
+ * One step of the closest-two search in noise4_branch: score replaces the
+ * further of a and b if it is closer, taking its point and side along.
+ * Selects instead of branches, with the same comparisons and tie rules.
+ */
+static FORCE_INLINE void closer4(OSN_REAL score, int point, int side, OSN_REAL *aScore, int *aPoint, int *aSide,
+	OSN_REAL *bScore, int *bPoint, int *bSide)
+{
+	int b = (*aScore >= *bScore) & (score > *bScore);
+	int a = !b & (*aScore < *bScore) & (score > *aScore);
+
+	*bScore = b ? score : *bScore;
+	*bPoint = b ? point : *bPoint;
+	*bSide = b ? side : *bSide;
+	*aScore = a ? score : *aScore;
+	*aPoint = a ? point : *aPoint;
+	*aSide = a ? side : *aSide;
+}
+
+/*
+ * Key into the vertex tables of open_simplex_noise4_tables.h.  Both region
+ * searches of noise4_branch run on every point and the region picks one.
+ * The mirrored regions (inSum >= 3 and the second dispentachoron) search
+ * for the smallest scores, which is the same search on negated scores.
+ */
+static FORCE_INLINE int region4_key(OSN_REAL xins, OSN_REAL yins, OSN_REAL zins, OSN_REAL wins)
+{
+	OSN_REAL inSum = xins + yins + zins + wins;
+	int region = inSum <= 1 ? 0 : inSum >= 3 ? 1 : inSum <= 2 ? 2 : 3;
+	OSN_REAL sign = (region & 1) ? -1 : 1;
+	OSN_REAL aScore, bScore, uins, score, base;
+	int aPoint, bPoint, aSide, bSide, c, bigger, first, second, pentachoron, dispentachoron;
+
+	/* Closest two of the four unit vertices, then whether the origin is one of them. */
+	aScore = sign * xins;
+	aPoint = 0x01;
+	bScore = sign * yins;
+	bPoint = 0x02;
+	aSide = bSide = 0;
+	closer4(sign * zins, 0x04, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	closer4(sign * wins, 0x08, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	uins = sign * ((region == 1 ? 4 : 1) - inSum);
+	c = (uins > aScore) | (uins > bScore);
+	pentachoron = c << 9 | (c ? (bScore > aScore ? bPoint : aPoint) : (aPoint | bPoint)) << 4;
+
+	/* Closest two of the pair vertices and the unit vertices across the middle. */
+	bigger = sign * (xins + yins) > sign * (zins + wins);
+	aScore = sign * (bigger ? xins + yins : zins + wins);
+	aPoint = bigger ? 0x03 : 0x0C;
+	bigger = sign * (xins + zins) > sign * (yins + wins);
+	bScore = sign * (bigger ? xins + zins : yins + wins);
+	bPoint = bigger ? 0x05 : 0x0A;
+	aSide = bSide = 1;
+	bigger = sign * (xins + wins) > sign * (yins + zins);
+	score = sign * (bigger ? xins + wins : yins + zins);
+	closer4(score, bigger ? 0x09 : 0x06, 1, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	base = (region == 3 ? 3 : 2) - inSum;
+	closer4(sign * (base + xins), 0x01, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	closer4(sign * (base + yins), 0x02, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	closer4(sign * (base + zins), 0x04, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	closer4(sign * (base + wins), 0x08, 0, &aScore, &aPoint, &aSide, &bScore, &bPoint, &bSide);
+	first = aSide << 4 | aPoint;
+	second = bSide << 4 | bPoint;
+	dispentachoron = first > second ? first << 5 | second : second << 5 | first;
+
+	return region << 10 | (region >= 2 ? dispentachoron : pentachoron);
+}
+
+/* Contribution of one table vertex, displaced and gated as noise4_branch does. */
+static FORCE_INLINE OSN_REAL vertex4(const struct osn_context *ctx, OSN_REAL *grad,
+	const struct osn_vertex4 *v, int xsb, int ysb, int zsb, int wsb,
+	OSN_REAL dx0, OSN_REAL dy0, OSN_REAL dz0, OSN_REAL dw0)
+{
+	OSN_REAL squish = squish4[v->k];
+	OSN_REAL dx = ((dx0 - v->a[0]) - squish) + v->b[0];
+	OSN_REAL dy = ((dy0 - v->a[1]) - squish) + v->b[1];
+	OSN_REAL dz = ((dz0 - v->a[2]) - squish) + v->b[2];
+	OSN_REAL dw = ((dw0 - v->a[3]) - squish) + v->b[3];
+	OSN_REAL attn = 2 - dx * dx - dy * dy - dz * dz - dw * dw;
+
+	if (attn > 0)
+		return contribute4(ctx, grad, attn, xsb + v->sv[0], ysb + v->sv[1], zsb + v->sv[2], wsb + v->sv[3],
+			dx, dy, dz, dw);
+	return 0;
+}
+
+/*
+ * Table-driven form of noise4_branch: the region key picks the region's
+ * fixed vertices and its three extra vertices, which are then evaluated in
+ * the same order, so the sum and the gradient come out bit-identical.
+ */
+static OSN_REAL noise4_table(const struct osn_context *ctx, OSN_REAL *grad, int xsb, int ysb, int zsb, int wsb,
+	OSN_REAL xins, OSN_REAL yins, OSN_REAL zins, OSN_REAL wins,
+	OSN_REAL dx0, OSN_REAL dy0, OSN_REAL dz0, OSN_REAL dw0)
+{
+	int key = region4_key(xins, yins, zins, wins);
+	const struct osn_vertex4 *fixed = lattice4[key >> 10];
+	const struct osn_vertex4 *ext = lattice4_ext[lattice4_ext_index[key]];
+	OSN_REAL value = 0;
+	int i;
+
+	if (grad)
+		grad[0] = grad[1] = grad[2] = grad[3] = 0;
+
+	for (i = 0; i < 10; i++)
+		value += vertex4(ctx, grad, &fixed[i], xsb, ysb, zsb, wsb, dx0, dy0, dz0, dw0);
+	for (i = 0; i < 3; i++)
+		value += vertex4(ctx, grad, &ext[i], xsb, ysb, zsb, wsb, dx0, dy0, dz0, dw0);
+
+	if (grad) {
+		grad[0] /= NORM_4D;
+		grad[1] /= NORM_4D;
+		grad[2] /= NORM_4D;
+		grad[3] /= NORM_4D;
+	}
+	return value / NORM_4D;
+}
+
+/* 4D evaluation by the context's selection, see open_simplex_noise4_select. */
+static FORCE_INLINE OSN_REAL noise4_eval(const struct osn_context *ctx, OSN_REAL *grad, int xsb, int ysb, int zsb, int wsb,
+	OSN_REAL xins, OSN_REAL yins, OSN_REAL zins, OSN_REAL wins,
+	OSN_REAL dx0, OSN_REAL dy0, OSN_REAL dz0, OSN_REAL dw0)
+{
+	if (ctx->select4 == OSN_SELECT_TABLE)
+		return noise4_table(ctx, grad, xsb, ysb, zsb, wsb, xins, yins, zins, wins, dx0, dy0, dz0, dw0);
+	return noise4_branch(ctx, grad, xsb, ysb, zsb, wsb, xins, yins, zins, wins, dx0, dy0, dz0, dw0);
+}
+	
+/* 
+ * 4D OpenSimplex (Simplectic) Noise.
+ */
+static OSN_REAL noise4_point(const struct osn_context *ctx, OSN_REAL *grad, OSN_REAL x, OSN_REAL y, OSN_REAL z, OSN_REAL w)
+{
+	/* Place input coordinates on simplectic honeycomb. */
+	OSN_REAL stretchOffset = (x + y + z + w) * STRETCH_4D;
+	OSN_REAL xs = x + stretchOffset;
+	OSN_REAL ys = y + stretchOffset;
+	OSN_REAL zs = z + stretchOffset;
+	OSN_REAL ws = w + stretchOffset;
+	
+	/* Floor to get simplectic honeycomb coordinates of rhombo-hypercube super-cell origin. */
+	int xsb = fastFloor(xs);
+	int ysb = fastFloor(ys);
+	int zsb = fastFloor(zs);
+	int wsb = fastFloor(ws);
+	
+	/* Skew out to get actual coordinates of stretched rhombo-hypercube origin. We'll need these later. */
+	OSN_REAL squishOffset = (xsb + ysb + zsb + wsb) * SQUISH_4D;
+	OSN_REAL xb = xsb + squishOffset;
+	OSN_REAL yb = ysb + squishOffset;
+	OSN_REAL zb = zsb + squishOffset;
+	OSN_REAL wb = wsb + squishOffset;
+	
+	/* Compute simplectic honeycomb coordinates relative to rhombo-hypercube origin. */
+	OSN_REAL xins = xs - xsb;
+	OSN_REAL yins = ys - ysb;
+	OSN_REAL zins = zs - zsb;
+	OSN_REAL wins = ws - wsb;
+	
+	/* Positions relative to origin point. */
+	OSN_REAL dx0 = x - xb;
+	OSN_REAL dy0 = y - yb;
+	OSN_REAL dz0 = z - zb;
+	OSN_REAL dw0 = w - wb;
+	
+	return noise4_eval(ctx, grad, xsb, ysb, zsb, wsb, xins, yins, zins, wins, dx0, dy0, dz0, dw0);
+}
+
+#if OSN_ISA_LEVEL == 0
+OSN_REAL OSN_NAME(open_simplex_noise4, )(const struct osn_context *ctx, OSN_REAL x, OSN_REAL y, OSN_REAL z, OSN_REAL w)
+{
+	return noise4_point(ctx, NULL, x, y, z, w);
+}
+
+OSN_REAL OSN_NAME(open_simplex_noise4, _grad)(const struct osn_context *ctx, OSN_REAL x, OSN_REAL y, OSN_REAL z, OSN_REAL w, OSN_REAL grad[4])
+{
+	return noise4_point(ctx, grad, x, y, z, w);
+}
+#endif
+
+/*
+ * Row evaluation.
+ *
+ * Each block of ROW_LANES input points is evaluated with vector
+ * instructions (AVX-512 or AVX2, as OSN_ISA_LEVEL selects), one point per
+ * lane, by the table-driven selection: the lanes place their points on the
+ * lattice, compute the region key of noise4_table (or its 3D counterpart) in
+ * OSN_REAL, where every value the key combines is a small exact integer, and
+ * then sum the contributions of the super-cell corners, each gated by a
+ * mask of the lanes whose region has it, and of the extra vertices gathered
+ * from the tables by key.  Corners come in an order that keeps every
+ * region's own, lanes skip the vertices noise*_table skips, hashes are
+ * gathered a byte at a time and gradients as precombined words, so the lanes
+ * do the same IEEE operations in the same order as the per-point functions
+ * and rows are bit-identical to them as long as the file is built without
+ * floating point contraction (-ffp-contract=off).  A remainder of a row
+ * of a quarter block or more is one more block, padded with its last point,
+ * so short rows stay in lanes; shorter ones go point by point.
+ */
+#if ROW_LANES > 1
+/* Lattice placement of ROW_LANES points sharing y, z (and w). */
+struct lattice_lanes {
+	vint xsb, ysb, zsb, wsb;
+	vreal xins, yins, zins, wins;
+	vreal dx0, dy0, dz0, dw0;
+	/* 4D: the table of the last hash stage, and the slice it belongs to if any */
+	const uint32_t *permGrad4D;
+	const struct osn_slice *slice;
+};
+
+static FORCE_INLINE void lattice3_lanes(const OSN_REAL *x, OSN_REAL y, OSN_REAL z, struct lattice_lanes *l)
+{
+	vreal vx = vload(x);
+	vreal vy = vset1(y);
+	vreal vz = vset1(z);
+	vreal stretchOffset = vmul(vadd(vadd(vx, vy), vz), vset1(STRETCH_3D));
+	vreal xs = vadd(vx, stretchOffset);
+	vreal ys = vadd(vy, stretchOffset);
+	vreal zs = vadd(vz, stretchOffset);
+	vint xsb = vfloor(xs);
+	vint ysb = vfloor(ys);
+	vint zsb = vfloor(zs);
+	/* Convert back from int so a -0.0 input floors to +0.0 like the scalar path. */
+	vreal xsbr = vitor(xsb);
+	vreal ysbr = vitor(ysb);
+	vreal zsbr = vitor(zsb);
+	vreal squishOffset = vmul(vitor(viadd(viadd(xsb, ysb), zsb)), vset1(SQUISH_3D));
+
+	l->xsb = xsb;
+	l->ysb = ysb;
+	l->zsb = zsb;
+	l->xins = vsub(xs, xsbr);
+	l->yins = vsub(ys, ysbr);
+	l->zins = vsub(zs, zsbr);
+	l->dx0 = vsub(vx, vadd(xsbr, squishOffset));
+	l->dy0 = vsub(vy, vadd(ysbr, squishOffset));
+	l->dz0 = vsub(vz, vadd(zsbr, squishOffset));
+}
+
+static FORCE_INLINE void lattice4_lanes(const OSN_REAL *x, OSN_REAL y, OSN_REAL z, OSN_REAL w, struct lattice_lanes *l)
+{
+	vreal vx = vload(x);
+	vreal vy = vset1(y);
+	vreal vz = vset1(z);
+	vreal vw = vset1(w);
+	vreal stretchOffset = vmul(vadd(vadd(vadd(vx, vy), vz), vw), vset1(STRETCH_4D));
+	vreal xs = vadd(vx, stretchOffset);
+	vreal ys = vadd(vy, stretchOffset);
+	vreal zs = vadd(vz, stretchOffset);
+	vreal ws = vadd(vw, stretchOffset);
+	vint xsb = vfloor(xs);
+	vint ysb = vfloor(ys);
+	vint zsb = vfloor(zs);
+	vint wsb = vfloor(ws);
+	vreal xsbr = vitor(xsb);
+	vreal ysbr = vitor(ysb);
+	vreal zsbr = vitor(zsb);
+	vreal wsbr = vitor(wsb);
+	vreal squishOffset = vmul(vitor(viadd(viadd(viadd(xsb, ysb), zsb), wsb)), vset1(SQUISH_4D));
+
+	l->xsb = xsb;
+	l->ysb = ysb;
+	l->zsb = zsb;
+	l->wsb = wsb;
+	l->xins = vsub(xs, xsbr);
+	l->yins = vsub(ys, ysbr);
+	l->zins = vsub(zs, zsbr);
+	l->wins = vsub(ws, wsbr);
+	l->dx0 = vsub(vx, vadd(xsbr, squishOffset));
+	l->dy0 = vsub(vy, vadd(ysbr, squishOffset));
+	l->dz0 = vsub(vz, vadd(zsbr, squishOffset));
+	l->dw0 = vsub(vw, vadd(wsbr, squishOffset));
+}
+
+/*
+ * table[i] on every lane, for a byte table.  The gather reads the 32-bit
+ * word at table + i; every table it is used on is followed by at least
+ * three more bytes of its struct or array, or i stays that far from its end.
+ */
+static FORCE_INLINE vint lookup_lanes(const uint8_t *table, vint i)
+{
+	return viand(vigather(table, i), viset1(0xFF));
+}
+
+/* table[i & 0xFF] on every lane: one step of the permutation chain. */
+static FORCE_INLINE vint hash_lanes(const uint8_t *table, vint i)
+{
+	return lookup_lanes(table, viand(i, viset1(0xFF)));
+}
+
+/* Byte n of each lane's 32-bit word, sign extended. */
+static FORCE_INLINE vint byte_lanes(vint word, int n)
+{
+	return visra(visll(word, 24 - 8 * n), 24);
+}
+
+/* The gradient of every lane, a word of bytes from a permGrad table. */
+static FORCE_INLINE vint gradient_lanes(const uint32_t *table, vint i)
+{
+	return vigather(table, visll(viand(i, viset1(0xFF)), 2));
+}
+
+/*
+ * The 4D hash from a lane's chain through y, hash, on to z: one more stage
+ * of the permutation, or through a slice, whose table takes the sum as is.
+ */
+static FORCE_INLINE vint stage4_lanes(const struct osn_context *ctx, const struct lattice_lanes *l, vint hash, vint zsv)
+{
+	vint h = viadd(hash, zsv);
+
+	return l->slice ? h : hash_lanes(ctx->perm, h);
+}
+
+/* The gradient word of every lane's vertex from its stage4_lanes hash and wsv. */
+static FORCE_INLINE vint gradient4_lanes(const struct lattice_lanes *l, vint hash, vint wsv)
+{
+	if (l->slice)
+		return vigather(l->permGrad4D, viadd(visll(viand(hash, viset1(0xFF)), 2),
+			visll(visub(wsv, viset1(l->slice->wsv_min)), 10)));
+	return gradient_lanes(l->permGrad4D, viadd(hash, wsv));
+}
+
+/*
+ * closer4 on every lane, with each point and its side carried as one code,
+ * side * 16 + point.
+ */
+static FORCE_INLINE void closer_lanes(vreal score, vreal code, vreal *aScore, vreal *aCode, vreal *bScore, vreal *bCode)
+{
+	vmask b = vmand(vcmp(*aScore, *bScore, _CMP_GE_OQ), vcmp(score, *bScore, _CMP_GT_OQ));
+	vmask a = vmandn(b, vmand(vcmp(*aScore, *bScore, _CMP_LT_OQ), vcmp(score, *aScore, _CMP_GT_OQ)));
+
+	*bScore = vblend(b, score, *bScore);
+	*bCode = vblend(b, code, *bCode);
+	*aScore = vblend(a, score, *aScore);
+	*aCode = vblend(a, code, *aCode);
+}
+
+/* The key bits of the two closest points, first << 5 | second, the larger first. */
+static FORCE_INLINE vreal pair_lanes(vreal aCode, vreal bCode)
+{
+	return vadd(vmul(vmax(aCode, bCode), vset1(32)), vmin(aCode, bCode));
+}
+
+/*
+ * Gradient extrapolated to the point and scaled by attn^4, as contribute3
+ * and contribute4 compute it, from each lane's gradient as a word of bytes.
+ */
+static FORCE_INLINE vreal contribute3_lanes(vreal attn, vint g, vreal dx, vreal dy, vreal dz)
+{
+	vreal attn2 = vmul(attn, attn);
+	vreal ext = vadd(vadd(vmul(vitor(byte_lanes(g, 0)), dx), vmul(vitor(byte_lanes(g, 1)), dy)),
+		vmul(vitor(byte_lanes(g, 2)), dz));
+
+	return vmul(vmul(attn2, attn2), ext);
+}
+
+static FORCE_INLINE vreal contribute4_lanes(vreal attn, vint g, vreal dx, vreal dy, vreal dz, vreal dw)
+{
+	vreal attn2 = vmul(attn, attn);
+	vreal ext = vadd(vadd(vadd(vmul(vitor(byte_lanes(g, 0)), dx), vmul(vitor(byte_lanes(g, 1)), dy)),
+		vmul(vitor(byte_lanes(g, 2)), dz)), vmul(vitor(byte_lanes(g, 3)), dw));
+
+	return vmul(vmul(attn2, attn2), ext);
+}
+
+/*
+ * Region key of the 3D tables on every lane, from both region searches of
+ * noise3_eval, with the region masks: r[0] and r[1] the tetrahedra at
+ * (0,0,0) and (1,1,1), r[2] the octahedron between them.  Unions of
+ * distinct point bits are taken as sums.
+ */
+static FORCE_INLINE vint region3_lanes(const struct lattice_lanes *l, vmask r[3])
+{
+	vreal one = vset1(1), sixteen = vset1(16);
+	vreal inSum = vadd(vadd(l->xins, l->yins), l->zins);
+	vreal region, sign, aScore, bScore, aCode, bCode, uins, score, p, tetrahedron;
+	vmask c, side, ra, rb;
+
+	r[0] = vcmp(inSum, one, _CMP_LE_OQ);
+	r[1] = vcmp(inSum, vset1(2), _CMP_GE_OQ);
+	r[2] = vmand(vcmp(inSum, one, _CMP_NLE_UQ), vcmp(inSum, vset1(2), _CMP_NGE_UQ));
+	region = vblend(r[1], one, vblend(r[2], vset1(2), vset1(0)));
+	sign = vblend(r[1], vset1(-1), one);
+
+	/* Closest two of the three unit vertices, then whether the origin is one of them. */
+	aScore = vmul(sign, l->xins);
+	aCode = one;
+	bScore = vmul(sign, l->yins);
+	bCode = vset1(2);
+	closer_lanes(vmul(sign, l->zins), vset1(4), &aScore, &aCode, &bScore, &bCode);
+	uins = vmul(sign, vsub(vblend(r[1], vset1(3), one), inSum));
+	c = vmor(vcmp(uins, aScore, _CMP_GT_OQ), vcmp(uins, bScore, _CMP_GT_OQ));
+	tetrahedron = vblend(c, vadd(vset1(512), vmul(sixteen, vblend(vcmp(bScore, aScore, _CMP_GT_OQ), bCode, aCode))),
+		vmul(sixteen, vadd(aCode, bCode)));
+
+	/*
+	 * The octahedron replaces the further of its first two candidates with
+	 * the third if closer, by <= and < rather than the search's rules.
+	 */
+	p = vadd(l->xins, l->yins);
+	side = vcmp(p, one, _CMP_GT_OQ);
+	aScore = vblend(side, vsub(p, one), vsub(one, p));
+	aCode = vblend(side, vset1(16 + 3), vset1(4));
+	p = vadd(l->xins, l->zins);
+	side = vcmp(p, one, _CMP_GT_OQ);
+	bScore = vblend(side, vsub(p, one), vsub(one, p));
+	bCode = vblend(side, vset1(16 + 5), vset1(2));
+	p = vadd(l->yins, l->zins);
+	side = vcmp(p, one, _CMP_GT_OQ);
+	score = vblend(side, vsub(p, one), vsub(one, p));
+	ra = vmand(vcmp(aScore, bScore, _CMP_LE_OQ), vcmp(aScore, score, _CMP_LT_OQ));
+	rb = vmandn(ra, vmand(vcmp(aScore, bScore, _CMP_GT_OQ), vcmp(bScore, score, _CMP_LT_OQ)));
+	aCode = vblend(ra, vblend(side, vset1(16 + 6), one), aCode);
+	bCode = vblend(rb, vblend(side, vset1(16 + 6), one), bCode);
+
+	return vrtoi(vadd(vmul(region, vset1(1024)), vblend(r[2], pair_lanes(aCode, bCode), tetrahedron)));
+}
+
+/* region4_key on every lane, with the region masks r[0..3]; see region3_lanes. */
+static FORCE_INLINE vint region4_lanes(const struct lattice_lanes *l, vmask r[4])
+{
+	vreal one = vset1(1), sixteen = vset1(16);
+	vreal inSum = vadd(vadd(vadd(l->xins, l->yins), l->zins), l->wins);
+	vreal region, sign, aScore, bScore, aCode, bCode, uins, pentachoron, base;
+	vreal xy, zw, xz, yw, xw, yz;
+	vmask c, bigger;
+
+	r[0] = vcmp(inSum, one, _CMP_LE_OQ);
+	r[1] = vcmp(inSum, vset1(3), _CMP_GE_OQ);
+	r[2] = vmandn(r[0], vcmp(inSum, vset1(2), _CMP_LE_OQ));
+	r[3] = vmand(vcmp(inSum, vset1(2), _CMP_NLE_UQ), vcmp(inSum, vset1(3), _CMP_NGE_UQ));
+	region = vblend(r[1], one, vblend(r[2], vset1(2), vblend(r[3], vset1(3), vset1(0))));
+	sign = vblend(vmor(r[1], r[3]), vset1(-1), one);
+
+	/* Closest two of the four unit vertices, then whether the origin is one of them. */
+	aScore = vmul(sign, l->xins);
+	aCode = one;
+	bScore = vmul(sign, l->yins);
+	bCode = vset1(2);
+	closer_lanes(vmul(sign, l->zins), vset1(4), &aScore, &aCode, &bScore, &bCode);
+	closer_lanes(vmul(sign, l->wins), vset1(8), &aScore, &aCode, &bScore, &bCode);
+	uins = vmul(sign, vsub(vblend(r[1], vset1(4), one), inSum));
+	c = vmor(vcmp(uins, aScore, _CMP_GT_OQ), vcmp(uins, bScore, _CMP_GT_OQ));
+	pentachoron = vblend(c, vadd(vset1(512), vmul(sixteen, vblend(vcmp(bScore, aScore, _CMP_GT_OQ), bCode, aCode))),
+		vmul(sixteen, vadd(aCode, bCode)));
+
+	/* Closest two of the pair vertices and the unit vertices across the middle. */
+	xy = vmul(sign, vadd(l->xins, l->yins));
+	zw = vmul(sign, vadd(l->zins, l->wins));
+	bigger = vcmp(xy, zw, _CMP_GT_OQ);
+	aScore = vblend(bigger, xy, zw);
+	aCode = vblend(bigger, vset1(16 + 0x03), vset1(16 + 0x0C));
+	xz = vmul(sign, vadd(l->xins, l->zins));
+	yw = vmul(sign, vadd(l->yins, l->wins));
+	bigger = vcmp(xz, yw, _CMP_GT_OQ);
+	bScore = vblend(bigger, xz, yw);
+	bCode = vblend(bigger, vset1(16 + 0x05), vset1(16 + 0x0A));
+	xw = vmul(sign, vadd(l->xins, l->wins));
+	yz = vmul(sign, vadd(l->yins, l->zins));
+	bigger = vcmp(xw, yz, _CMP_GT_OQ);
+	closer_lanes(vblend(bigger, xw, yz), vblend(bigger, vset1(16 + 0x09), vset1(16 + 0x06)),
+		&aScore, &aCode, &bScore, &bCode);
+	base = vsub(vblend(r[3], vset1(3), vset1(2)), inSum);
+	closer_lanes(vmul(sign, vadd(base, l->xins)), one, &aScore, &aCode, &bScore, &bCode);
+	closer_lanes(vmul(sign, vadd(base, l->yins)), vset1(2), &aScore, &aCode, &bScore, &bCode);
+	closer_lanes(vmul(sign, vadd(base, l->zins)), vset1(4), &aScore, &aCode, &bScore, &bCode);
+	closer_lanes(vmul(sign, vadd(base, l->wins)), vset1(8), &aScore, &aCode, &bScore, &bCode);
+
+	return vrtoi(vadd(vmul(region, vset1(1024)), vblend(vmor(r[2], r[3]), pair_lanes(aCode, bCode), pentachoron)));
+}
+
+/*
+ * Corner (sx, sy, sz) of the super-cell on the lanes in regions, displaced
+ * and gated as the table vertex of that corner is.  hash[sx << 1 | sy] is
+ * the permutation chain through x and y of the lanes' corners.
+ */
+static FORCE_INLINE vreal corner3_lanes(const struct osn_context *ctx, const struct lattice_lanes *l, const vint *hash,
+	vmask regions, int sx, int sy, int sz, vreal value)
+{
+	vreal squish = vset1((sx + sy + sz) * SQUISH_3D);
+	vreal dx = vsub(vsub(l->dx0, vset1(sx)), squish);
+	vreal dy = vsub(vsub(l->dy0, vset1(sy)), squish);
+	vreal dz = vsub(vsub(l->dz0, vset1(sz)), squish);
+	vreal attn = vsub(vsub(vsub(vset1(2), vmul(dx, dx)), vmul(dy, dy)), vmul(dz, dz));
+	vmask m = vmand(regions, vcmp(attn, vset1(0), _CMP_GT_OQ));
+	vint g;
+
+	if (!vmany(m))
+		return value;
+	g = gradient_lanes(ctx->permGrad3D, viadd(hash[sx << 1 | sy], viadd(l->zsb, viset1(sz))));
+	return vblend(m, vadd(value, contribute3_lanes(attn, g, dx, dy, dz)), value);
+}
+
+static FORCE_INLINE vreal corner4_lanes(const struct osn_context *ctx, const struct lattice_lanes *l, const vint *hash,
+	vmask regions, int sx, int sy, int sz, int sw, vreal value)
+{
+	vreal squish = vset1((sx + sy + sz + sw) * SQUISH_4D);
+	vreal dx = vsub(vsub(l->dx0, vset1(sx)), squish);
+	vreal dy = vsub(vsub(l->dy0, vset1(sy)), squish);
+	vreal dz = vsub(vsub(l->dz0, vset1(sz)), squish);
+	vreal dw = vsub(vsub(l->dw0, vset1(sw)), squish);
+	vreal attn = vsub(vsub(vsub(vsub(vset1(2), vmul(dx, dx)), vmul(dy, dy)), vmul(dz, dz)), vmul(dw, dw));
+	vmask m = vmand(regions, vcmp(attn, vset1(0), _CMP_GT_OQ));
+	vint g;
+
+	if (!vmany(m))
+		return value;
+	g = gradient4_lanes(l, hash[sx << 2 | sy << 1 | sz], viadd(l->wsb, viset1(sw)));
+	return vblend(m, vadd(value, contribute4_lanes(attn, g, dx, dy, dz, dw)), value);
+}
+
+/*
+ * Extra vertex of every lane, each lane's at byte offset entry from vertex,
+ * which points into the first row of the extra vertex table.  Only a and b
+ * are fetched: the lattice offset of every extra vertex is a - b and its
+ * squish multiple the sum of the offset.
+ */
+static FORCE_INLINE vreal ext3_lanes(const struct osn_context *ctx, const struct lattice_lanes *l,
+	const struct osn_vertex3 *vertex, vint entry, vreal value)
+{
+	/* a[0..2] b[0] and b[0..2] k */
+	vint a = vigather(vertex->a, entry);
+	vint b = vigather(vertex->b, entry);
+	vint svx = visub(byte_lanes(a, 0), byte_lanes(b, 0));
+	vint svy = visub(byte_lanes(a, 1), byte_lanes(b, 1));
+	vint svz = visub(byte_lanes(a, 2), byte_lanes(b, 2));
+	vreal squish = vmul(vitor(viadd(viadd(svx, svy), svz)), vset1(SQUISH_3D));
+	vreal dx = vadd(vsub(vsub(l->dx0, vitor(byte_lanes(a, 0))), squish), vitor(byte_lanes(b, 0)));
+	vreal dy = vadd(vsub(vsub(l->dy0, vitor(byte_lanes(a, 1))), squish), vitor(byte_lanes(b, 1)));
+	vreal dz = vadd(vsub(vsub(l->dz0, vitor(byte_lanes(a, 2))), squish), vitor(byte_lanes(b, 2)));
+	vreal attn = vsub(vsub(vsub(vset1(2), vmul(dx, dx)), vmul(dy, dy)), vmul(dz, dz));
+	vmask m = vcmp(attn, vset1(0), _CMP_GT_OQ);
+	vint hash, g;
+
+	if (!vmany(m))
+		return value;
+	hash = hash_lanes(ctx->perm, viadd(l->xsb, svx));
+	hash = hash_lanes(ctx->perm, viadd(hash, viadd(l->ysb, svy)));
+	g = gradient_lanes(ctx->permGrad3D, viadd(hash, viadd(l->zsb, svz)));
+	return vblend(m, vadd(value, contribute3_lanes(attn, g, dx, dy, dz)), value);
+}
+
+static FORCE_INLINE vreal ext4_lanes(const struct osn_context *ctx, const struct lattice_lanes *l,
+	const struct osn_vertex4 *vertex, vint entry, vreal value)
+{
+	vint a = vigather(vertex->a, entry);
+	vint b = vigather(vertex->b, entry);
+	vint svx = visub(byte_lanes(a, 0), byte_lanes(b, 0));
+	vint svy = visub(byte_lanes(a, 1), byte_lanes(b, 1));
+	vint svz = visub(byte_lanes(a, 2), byte_lanes(b, 2));
+	vint svw = visub(byte_lanes(a, 3), byte_lanes(b, 3));
+	vreal squish = vmul(vitor(viadd(viadd(viadd(svx, svy), svz), svw)), vset1(SQUISH_4D));
+	vreal dx = vadd(vsub(vsub(l->dx0, vitor(byte_lanes(a, 0))), squish), vitor(byte_lanes(b, 0)));
+	vreal dy = vadd(vsub(vsub(l->dy0, vitor(byte_lanes(a, 1))), squish), vitor(byte_lanes(b, 1)));
+	vreal dz = vadd(vsub(vsub(l->dz0, vitor(byte_lanes(a, 2))), squish), vitor(byte_lanes(b, 2)));
+	vreal dw = vadd(vsub(vsub(l->dw0, vitor(byte_lanes(a, 3))), squish), vitor(byte_lanes(b, 3)));
+	vreal attn = vsub(vsub(vsub(vsub(vset1(2), vmul(dx, dx)), vmul(dy, dy)), vmul(dz, dz)), vmul(dw, dw));
+	vmask m = vcmp(attn, vset1(0), _CMP_GT_OQ);
+	vint hash, g;
+
+	if (!vmany(m))
+		return value;
+	hash = hash_lanes(ctx->perm, viadd(l->xsb, svx));
+	hash = hash_lanes(ctx->perm, viadd(hash, viadd(l->ysb, svy)));
+	hash = stage4_lanes(ctx, l, hash, viadd(l->zsb, svz));
+	g = gradient4_lanes(l, hash, viadd(l->wsb, svw));
+	return vblend(m, vadd(value, contribute4_lanes(attn, g, dx, dy, dz, dw)), value);
+}
+
+/* 3D noise of ROW_LANES points sharing y and z. */
+static FORCE_INLINE vreal noise3_lanes(const struct osn_context *ctx, const OSN_REAL *x, OSN_REAL y, OSN_REAL z)
+{
+	struct lattice_lanes l;
+	vmask r[3], units, pairs;
+	vint key, entry, hash[4];
+	vreal value = vset1(0);
+	int i;
+
+	lattice3_lanes(x, y, z, &l);
+	key = region3_lanes(&l, r);
+	for (i = 0; i < 4; i++)
+		hash[i] = hash_lanes(ctx->perm, viadd(hash_lanes(ctx->perm, viadd(l.xsb, viset1(i >> 1))),
+			viadd(l.ysb, viset1(i & 1))));
+
+	/* The corners in the order of every region's fixed vertices. */
+	units = vmor(r[0], r[2]);
+	pairs = vmor(r[1], r[2]);
+	value = corner3_lanes(ctx, &l, hash, r[0], 0, 0, 0, value);
+	value = corner3_lanes(ctx, &l, hash, units, 1, 0, 0, value);
+	value = corner3_lanes(ctx, &l, hash, units, 0, 1, 0, value);
+	value = corner3_lanes(ctx, &l, hash, units, 0, 0, 1, value);
+	value = corner3_lanes(ctx, &l, hash, pairs, 1, 1, 0, value);
+	value = corner3_lanes(ctx, &l, hash, pairs, 1, 0, 1, value);
+	value = corner3_lanes(ctx, &l, hash, pairs, 0, 1, 1, value);
+	value = corner3_lanes(ctx, &l, hash, r[1], 1, 1, 1, value);
+
+	entry = vimul(lookup_lanes(lattice3_ext_index, key), viset1(sizeof(lattice3_ext[0])));
+	value = ext3_lanes(ctx, &l, &lattice3_ext[0][0], entry, value);
+	value = ext3_lanes(ctx, &l, &lattice3_ext[0][1], entry, value);
+	return vdiv(value, vset1(NORM_3D));
+}
+
+/*
+ * 4D noise of ROW_LANES points sharing y, z and w, through slice if it
+ * is not NULL and every lane's vertices lie within its table.
+ */
+static FORCE_INLINE vreal noise4_lanes(const struct osn_context *ctx, const struct osn_slice *slice,
+	const OSN_REAL *x, OSN_REAL y, OSN_REAL z, OSN_REAL w)
+{
+	struct lattice_lanes l;
+	vmask r[4], units, pairs, triples;
+	vint key, entry, hash[8], hashx[2], hashxy[4];
+	vreal value = vset1(0), wsbr;
+	int i;
+
+	lattice4_lanes(x, y, z, w, &l);
+	l.permGrad4D = ctx->permGrad4D;
+	l.slice = NULL;
+	if (slice) {
+		wsbr = vitor(l.wsb);
+		if (!vmany(vmor(vcmp(wsbr, vset1(slice->wsv_min + 1), _CMP_LT_OQ),
+				vcmp(wsbr, vset1(slice->wsv_min + slice->wsv_count - 3), _CMP_GT_OQ)))) {
+			l.permGrad4D = slice->permGrad4D;
+			l.slice = slice;
+		}
+	}
+	key = region4_lanes(&l, r);
+	for (i = 0; i < 2; i++)
+		hashx[i] = hash_lanes(ctx->perm, viadd(l.xsb, viset1(i)));
+	for (i = 0; i < 4; i++)
+		hashxy[i] = hash_lanes(ctx->perm, viadd(hashx[i >> 1], viadd(l.ysb, viset1(i & 1))));
+	for (i = 0; i < 8; i++)
+		hash[i] = stage4_lanes(ctx, &l, hashxy[i >> 1], viadd(l.zsb, viset1(i & 1)));
+
+	/* The corners in the order of every region's fixed vertices. */
+	units = vmor(r[0], r[2]);
+	pairs = vmor(r[2], r[3]);
+	triples = vmor(r[1], r[3]);
+	value = corner4_lanes(ctx, &l, hash, r[0], 0, 0, 0, 0, value);
+	value = corner4_lanes(ctx, &l, hash, units, 1, 0, 0, 0, value);
+	value = corner4_lanes(ctx, &l, hash, units, 0, 1, 0, 0, value);
+	value = corner4_lanes(ctx, &l, hash, units, 0, 0, 1, 0, value);
+	value = corner4_lanes(ctx, &l, hash, units, 0, 0, 0, 1, value);
+	value = corner4_lanes(ctx, &l, hash, triples, 1, 1, 1, 0, value);
+	value = corner4_lanes(ctx, &l, hash, triples, 1, 1, 0, 1, value);
+	value = corner4_lanes(ctx, &l, hash, triples, 1, 0, 1, 1, value);
+	value = corner4_lanes(ctx, &l, hash, triples, 0, 1, 1, 1, value);
+	value = corner4_lanes(ctx, &l, hash, r[1], 1, 1, 1, 1, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 1, 1, 0, 0, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 1, 0, 1, 0, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 1, 0, 0, 1, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 0, 1, 1, 0, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 0, 1, 0, 1, value);
+	value = corner4_lanes(ctx, &l, hash, pairs, 0, 0, 1, 1, value);
+
+	entry = vimul(lookup_lanes(lattice4_ext_index, key), viset1(sizeof(lattice4_ext[0])));
+	for (i = 0; i < 3; i++)
+		value = ext4_lanes(ctx, &l, &lattice4_ext[0][i], entry, value);
+	return vdiv(value, vset1(NORM_4D));
+}
+#endif
+
+static void OSN_NAME(isa_noise3, _row)(const struct osn_context *ctx, const OSN_REAL *x, int n, OSN_REAL y, OSN_REAL z, OSN_REAL *out)
+{
+	int i = 0;
+#if ROW_LANES > 1
+	OSN_REAL xtail[ROW_LANES], tail[ROW_LANES];
+	int j;
+
+	for (; i + ROW_LANES <= n; i += ROW_LANES)
+		vstore(out + i, noise3_lanes(ctx, x + i, y, z));
+	/* A tail of a quarter block or more as one more block, padded with its last point. */
+	if (n - i >= ROW_LANES / 4 && i < n) {
+		for (j = 0; j < ROW_LANES; j++)
+			xtail[j] = x[j < n - i ? i + j : n - 1];
+		vstore(tail, noise3_lanes(ctx, xtail, y, z));
+		for (j = 0; i < n; i++, j++)
+			out[i] = tail[j];
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = noise3_point(ctx, NULL, x[i], y, z);
+}
+
+/* Row of 4D noise, through slice if it is not NULL; see noise4_lanes. */
+static FORCE_INLINE void noise4_rows(const struct osn_context *ctx, const struct osn_slice *slice,
+	const OSN_REAL *x, int n, OSN_REAL y, OSN_REAL z, OSN_REAL w, OSN_REAL *out)
+{
+	int i = 0;
+#if ROW_LANES > 1
+	OSN_REAL xtail[ROW_LANES], tail[ROW_LANES];
+	int j;
+
+	for (; i + ROW_LANES <= n; i += ROW_LANES)
+		vstore(out + i, noise4_lanes(ctx, slice, x + i, y, z, w));
+	/* A tail of a quarter block or more as one more block, padded with its last point. */
+	if (n - i >= ROW_LANES / 4 && i < n) {
+		for (j = 0; j < ROW_LANES; j++)
+			xtail[j] = x[j < n - i ? i + j : n - 1];
+		vstore(tail, noise4_lanes(ctx, slice, xtail, y, z, w));
+		for (j = 0; i < n; i++, j++)
+			out[i] = tail[j];
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = noise4_point(ctx, NULL, x[i], y, z, w);
+}
+
+static void OSN_NAME(isa_noise4, _row)(const struct osn_context *ctx, const OSN_REAL *x, int n, OSN_REAL y, OSN_REAL z, OSN_REAL w, OSN_REAL *out)
+{
+	noise4_rows(ctx, NULL, x, n, y, z, w, out);
+}
+
+/* Row of a slice; the scalar kernel, with no lanes to gather in, evaluates a plain row. */
+static void OSN_NAME(isa_noise4, _slice_row)(const struct osn_slice *slice, const OSN_REAL *x, int n, OSN_REAL y, OSN_REAL z, OSN_REAL *out)
+{
+	noise4_rows(slice->ctx, slice, x, n, y, z, (OSN_REAL) slice->w, out);
+}
+
+#undef STRETCH_3D
+#undef SQUISH_3D
+#undef STRETCH_4D
+#undef SQUISH_4D
+#undef NORM_3D
+#undef NORM_4D
+#undef contribute3
+#undef contribute4
+#undef noise3_eval
+#undef noise4_eval
+#undef noise4_branch
+#undef noise4_table
+#undef closer4
+#undef region4_key
+#undef vertex4
+#undef squish4
+#undef noise3_point
+#undef noise4_point
+#undef lattice_lanes
+#undef lattice3_lanes
+#undef lattice4_lanes
+#undef lookup_lanes
+#undef hash_lanes
+#undef byte_lanes
+#undef gradient_lanes
+#undef stage4_lanes
+#undef gradient4_lanes
+#undef closer_lanes
+#undef pair_lanes
+#undef contribute3_lanes
+#undef contribute4_lanes
+#undef region3_lanes
+#undef region4_lanes
+#undef corner3_lanes
+#undef corner4_lanes
+#undef ext3_lanes
+#undef ext4_lanes
+#undef noise3_lanes
+#undef noise4_lanes
+#undef noise4_rows
+
+#undef OSN_REAL
+#undef OSN_NAME
+#undef ROW_LANES
+#undef vreal
+#undef vint
+#undef vmask
+#undef vload
+#undef vstore
+#undef vset1
+#undef vadd
+#undef vsub
+#undef vmul
+#undef vdiv
+#undef vmin
+#undef vmax
+#undef vfloor
+#undef vrtoi
+#undef vitor
+#undef vcmp
+#undef vblend
+#undef vmand
+#undef vmandn
+#undef vmor
+#undef vmany
+#undef viset1
+#undef viadd
+#undef visub
+#undef viand
+#undef vimul
+#undef visll
+#undef visra
+#undef vigather
@@ -0,0 +1,286 @@
+#ifndef SPAN_INDEX_H
+#define SPAN_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+//
+// Interval tree over the value ranges [min, max] of a set of items (the
+// cell bricks of a field), answering which items hold a value v in
+// O(log n + k) for k items found.
+//
+// The tree is a balanced binary tree implied by the sorted m_splits: the
+// node of splits [lo, hi) has split value m_splits[(lo + hi) / 2], and an
+// item lives at the first node on its way down whose split it holds,
+// listed there by ascending min and by descending max.  A query at a node
+// below its split takes the node's items up to the first min above v, and
+// goes left; above it, the items down to the first max below v, and goes
+// right.  Items that hold no split live in the gap between two splits and
+// are tested one by one; the splits are quantiles of the range endpoints,
+// about one per item, so a gap holds a handful at most.
+//
+// The ranges move a little from step to step, so the index is updated
+// rather than rebuilt: Set records an item's new range, and Commit moves
+// the items whose node changed and re-sorts the lists they touched with
+// an insertion sort, linear in nearly sorted lists.  The splits are
+// chosen again only when too many items fall into gaps, or most items
+// moved.
+//
+struct SpanIndex {
+  std::vector<double> m_min;
+  std::vector<double> m_max;
+  std::vector<uint32_t> m_home;   // bucket of each item
+  std::vector<double> m_splits;
+  // buckets: the node of split s at s, the gap below split g at
+  // m_splits.size() + g (the last one above every split)
+  std::vector<std::vector<uint32_t>> m_by_min;
+  std::vector<std::vector<uint32_t>> m_by_max;
+  // open interval of values each bucket's items lie in, between the
+  // splits of the nearest nodes above it on either side
+  std::vector<double> m_floor;
+  std::vector<double> m_ceil;
+  std::vector<uint32_t> m_dirty;
+  std::vector<char> m_is_dirty;
+  size_t m_moved;       // items whose bucket changed since Commit
+  size_t m_gap_items;
+  long m_commits;
+  long m_rebuilds;
+  long m_total_moved;
+
+  SpanIndex()
+      : m_moved(0), m_gap_items(0), m_commits(0), m_rebuilds(0),
+        m_total_moved(0) {}
+
+  size_t Size() const { return m_min.size(); }
+
+  // count items, all with empty ranges until Set; drops the tree
+  void Resize(size_t items) {
+    m_min.assign(items, 0.);
+    m_max.assign(items, -1.);
+    m_home.assign(items, 0);
+    m_splits.clear();
+    m_by_min.clear();
+    m_by_max.clear();
+    m_floor.clear();
+    m_ceil.clear();
+  }
+
+  void Set(size_t item, double lo, double hi) {
+    if (lo == m_min[item] && hi == m_max[item])
+      return;
+    m_min[item] = lo;
+    m_max[item] = hi;
+    if (m_splits.empty())
+      return;
+    const uint32_t home = m_home[item];
+    Dirty(home);
+    if (Holds(home, lo, hi))
+      return;
+    const uint32_t bucket = Bucket(lo, hi);
+    // dropped from the old lists when they are compacted in Commit
+    if (home >= m_splits.size())
+      --m_gap_items;
+    if (bucket >= m_splits.size())
+      ++m_gap_items;
+    m_home[item] = bucket;
+    m_by_min[bucket].push_back(uint32_t(item));
+    m_by_max[bucket].push_back(uint32_t(item));
+    Dirty(bucket);
+    ++m_moved;
+  }
+
+  // makes the ranges Set since the last Commit visible to Stab
+  void Commit() {
+    ++m_commits;
+    m_total_moved += long(m_moved);
+    if (m_splits.empty() || m_gap_items > Size() / 8 + 8 ||
+        m_moved > Size() / 2) {
+      Rebuild();
+      return;
+    }
+    for (size_t d = 0; d < m_dirty.size(); ++d) {
+      const uint32_t bucket = m_dirty[d];
+      m_is_dirty[bucket] = 0;
+      Compact(bucket, m_by_min[bucket]);
+      Compact(bucket, m_by_max[bucket]);
+      if (bucket >= m_splits.size())
+        continue;
+      SortBy(m_by_min[bucket], [this](uint32_t a, uint32_t b) {
+        return m_min[a] < m_min[b];
+      });
+      SortBy(m_by_max[bucket], [this](uint32_t a, uint32_t b) {
+        return m_max[a] > m_max[b];
+      });
+    }
+    m_dirty.clear();
+    m_moved = 0;
+  }
+
+  // appends the items whose range holds v, in no particular order
+  void Stab(double v, std::vector<size_t> &items) const {
+    size_t lo = 0, hi = m_splits.size();
+    while (lo < hi) {
+      const size_t mid = (lo + hi) / 2;
+      const double split = m_splits[mid];
+      if (v < split) {
+        const std::vector<uint32_t> &list = m_by_min[mid];
+        for (size_t i = 0; i < list.size() && m_min[list[i]] <= v; ++i)
+          items.push_back(list[i]);
+        hi = mid;
+      } else if (v > split) {
+        const std::vector<uint32_t> &list = m_by_max[mid];
+        for (size_t i = 0; i < list.size() && m_max[list[i]] >= v; ++i)
+          items.push_back(list[i]);
+        lo = mid + 1;
+      } else {
+        // the items below and above hold no value as high, or as low
+        items.insert(items.end(), m_by_min[mid].begin(),
+                     m_by_min[mid].end());
+        return;
+      }
+    }
+    const std::vector<uint32_t> &gap = m_by_min[m_splits.size() + lo];
+    for (size_t i = 0; i < gap.size(); ++i) {
+      if (m_min[gap[i]] <= v && m_max[gap[i]] >= v)
+        items.push_back(gap[i]);
+    }
+  }
+
+private:
+  // bucket of the range [lo, hi] in the current splits
+  uint32_t Bucket(double lo, double hi) const {
+    size_t first = 0, last = m_splits.size();
+    while (first < last) {
+      const size_t mid = (first + last) / 2;
+      if (hi < m_splits[mid]) {
+        last = mid;
+      } else if (lo > m_splits[mid]) {
+        first = mid + 1;
+      } else {
+        return uint32_t(mid);
+      }
+    }
+    return uint32_t(m_splits.size() + first);
+  }
+
+  // whether [lo, hi] still belongs in bucket, without walking the tree
+  bool Holds(uint32_t bucket, double lo, double hi) const {
+    if (lo <= m_floor[bucket] || hi >= m_ceil[bucket])
+      return false;
+    if (bucket >= m_splits.size())
+      return true;
+    return lo <= m_splits[bucket] && hi >= m_splits[bucket];
+  }
+
+  // m_floor and m_ceil of the node of splits [lo, hi) and below it
+  void Bound(size_t lo, size_t hi, double floor, double ceil) {
+    if (lo == hi) {
+      m_floor[m_splits.size() + lo] = floor;
+      m_ceil[m_splits.size() + lo] = ceil;
+      return;
+    }
+    const size_t mid = (lo + hi) / 2;
+    m_floor[mid] = floor;
+    m_ceil[mid] = ceil;
+    Bound(lo, mid, floor, m_splits[mid]);
+    Bound(mid + 1, hi, m_splits[mid], ceil);
+  }
+
+  void Dirty(uint32_t bucket) {
+    if (m_is_dirty[bucket])
+      return;
+    m_is_dirty[bucket] = 1;
+    m_dirty.push_back(bucket);
+  }
+
+  // drops the items that moved out of bucket, and any listed twice
+  void Compact(uint32_t bucket, std::vector<uint32_t> &list) {
+    size_t kept = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+      if (m_home[list[i]] != bucket)
+        continue;
+      // Set lists an item that moves out and back in again
+      m_home[list[i]] = ~uint32_t(0);
+      list[kept++] = list[i];
+    }
+    list.resize(kept);
+    for (size_t i = 0; i < kept; ++i)
+      m_home[list[i]] = bucket;
+  }
+
+  //
+  // Insertion sort, linear for the nearly sorted lists of a step; a list
+  // that takes more than a few shifts per item is sorted outright.
+  //
+  template <typename Less>
+  static void SortBy(std::vector<uint32_t> &list, const Less &less) {
+    size_t shifts = 0;
+    const size_t budget = 4 * list.size() + 16;
+    for (size_t i = 1; i < list.size(); ++i) {
+      const uint32_t item = list[i];
+      size_t j = i;
+      for (; j > 0 && less(item, list[j - 1]); --j)
+        list[j] = list[j - 1];
+      list[j] = item;
+      shifts += i - j;
+      if (shifts > budget) {
+        std::sort(list.begin(), list.end(), less);
+        return;
+      }
+    }
+  }
+
+  // new splits from the endpoints, and every item placed again
+  void Rebuild() {
+    ++m_rebuilds;
+    const size_t n = Size();
+    std::vector<double> ends;
+    ends.reserve(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+      if (m_min[i] > m_max[i])
+        continue; // empty
+      ends.push_back(m_min[i]);
+      ends.push_back(m_max[i]);
+    }
+    std::sort(ends.begin(), ends.end());
+    m_splits.clear();
+    for (size_t e = 1; e < ends.size(); e += 2) {
+      if (m_splits.empty() || ends[e] > m_splits.back())
+        m_splits.push_back(ends[e]);
+    }
+    const size_t buckets = 2 * m_splits.size() + 1;
+    m_by_min.assign(buckets, std::vector<uint32_t>());
+    m_by_max.assign(buckets, std::vector<uint32_t>());
+    m_is_dirty.assign(buckets, 0);
+    m_dirty.clear();
+    m_floor.resize(buckets);
+    m_ceil.resize(buckets);
+    Bound(0, m_splits.size(), -std::numeric_limits<double>::infinity(),
+          std::numeric_limits<double>::infinity());
+    m_gap_items = 0;
+    for (size_t i = 0; i < n; ++i) {
+      m_home[i] = Bucket(m_min[i], m_max[i]);
+      m_by_min[m_home[i]].push_back(uint32_t(i));
+      if (m_home[i] >= m_splits.size())
+        ++m_gap_items;
+    }
+    for (size_t b = 0; b < m_splits.size(); ++b) {
+      std::vector<uint32_t> &by_min = m_by_min[b], &by_max = m_by_max[b];
+      std::sort(by_min.begin(), by_min.end(), [this](uint32_t x, uint32_t y) {
+        return m_min[x] < m_min[y];
+      });
+      by_max = by_min;
+      std::sort(by_max.begin(), by_max.end(), [this](uint32_t x, uint32_t y) {
+        return m_max[x] > m_max[y];
+      });
+    }
+    for (size_t b = m_splits.size(); b < buckets; ++b)
+      m_by_max[b] = m_by_min[b];
+    m_moved = 0;
+  }
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Index of the calling thread in the pool it works for: a worker's
+// thread_id, and 0 on any other thread, such as the one calling Run.
+//
+inline int &PoolThreadIndex() {
+  static thread_local int index = 0;
+  return index;
+}
+
+//
+// Persistent pool of worker threads.  Run() hands the same job to every
+// thread, the calling thread taking part as thread 0, and returns once all
+// of them are done.  Workers sleep between jobs, so a time step costs one
+// wake-up instead of a thread creation per loop.
+//
+struct ThreadPool {
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  const std::function<void(int)> *m_job;
+  unsigned long m_generation;
+  int m_pending;
+  bool m_stop;
+
+  explicit ThreadPool(int num_threads)
+      : m_job(NULL), m_generation(0), m_pending(0), m_stop(false) {
+    for (int i = 1; i < num_threads; ++i) {
+      m_threads.push_back(std::thread(&ThreadPool::Work, this, i));
+    }
+  }
+
+  int Size() const { return int(m_threads.size()) + 1; }
+
+  void Run(const std::function<void(int)> &job) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_job = &job;
+      m_pending = int(m_threads.size());
+      ++m_generation;
+    }
+    m_start.notify_all();
+    job(0);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_job = NULL;
+  }
+
+  void Work(int thread_id) {
+    PoolThreadIndex() = thread_id;
+    unsigned long seen = 0;
+    while (true) {
+      const std::function<void(int)> *job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_start.wait(lock,
+                     [&] { return m_stop || m_generation != seen; });
+        if (m_stop)
+          return;
+        seen = m_generation;
+        job = m_job;
+      }
+      (*job)(thread_id);
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        --m_pending;
+      }
+      m_done.notify_one();
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_start.notify_all();
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+      m_threads[i].join();
+    }
+  }
+
+private:
+  ThreadPool(const ThreadPool &);
+  ThreadPool &operator=(const ThreadPool &);
+};
+
+//
+// Per-thread accounting of a parallel region.  Busy time is spent inside
+// work items, idle time is the rest of the region's wall time: waiting for
+// work, stealing, and waiting at the end for the slowest thread.  Padded to a
+// cache line so threads do not share one.
+//
+struct alignas(64) ThreadStats {
+  double m_busy;
+  double m_idle;
+  long m_tasks;
+  long m_steals;
+
+  ThreadStats() : m_busy(0.), m_idle(0.), m_tasks(0), m_steals(0) {}
+};
+
+inline double PoolSeconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include "thread_pool.h"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+//
+// Double ended queue of task ids owned by one thread.  The owner takes from
+// the front, thieves take from the back, so the owner keeps walking forward
+// through its block of the index space while thieves take the far end.
+//
+struct TaskDeque {
+  std::mutex m_mutex;
+  std::deque<int> m_tasks;
+
+  void Push(int task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(task);
+  }
+
+  bool Pop(int &task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tasks.empty())
+      return false;
+    task = m_tasks.front();
+    m_tasks.pop_front();
+    return true;
+  }
+
+  bool Steal(int &task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tasks.empty())
+      return false;
+    task = m_tasks.back();
+    m_tasks.pop_back();
+    return true;
+  }
+};
+
+//
+// Work-stealing scheduler over a fixed set of tasks [0, num_tasks).  Each
+// thread starts with a contiguous block of the tasks in its own deque and,
+// once that runs dry, steals from the other threads in turn.  No task
+// spawns more work, so a thread that finds every deque empty is done.
+//
+struct WorkStealingScheduler {
+  std::vector<TaskDeque> m_deques;
+
+  explicit WorkStealingScheduler(int num_threads) : m_deques(num_threads) {}
+
+  template <typename TaskFn>
+  void Run(ThreadPool &pool, int num_tasks, const TaskFn &task,
+           std::vector<ThreadStats> &stats) {
+    const int num_threads = int(m_deques.size());
+    for (int t = 0; t < num_threads; ++t) {
+      const int begin = int((long)num_tasks * t / num_threads);
+      const int end = int((long)num_tasks * (t + 1) / num_threads);
+      for (int i = begin; i < end; ++i)
+        m_deques[t].Push(i);
+    }
+
+    std::function<void(int)> job = [&](int thread_id) {
+      ThreadStats &my_stats = stats[thread_id];
+      int current;
+      while (true) {
+        bool found = m_deques[thread_id].Pop(current);
+        for (int k = 1; !found && k < num_threads; ++k) {
+          found = m_deques[(thread_id + k) % num_threads].Steal(current);
+          if (found)
+            ++my_stats.m_steals;
+        }
+        if (!found)
+          break;
+        const double start = PoolSeconds();
+        task(current);
+        my_stats.m_busy += PoolSeconds() - start;
+        ++my_stats.m_tasks;
+      }
+    };
+    pool.Run(job);
+  }
+};
+
+#endif